@@ -5,8 +5,250 @@
 #ifndef CALC_BASE_STDBUF_H_
 #define CALC_BASE_STDBUF_H_
 
+#include "calc/base/stdmem.h"
+
+#include <stdarg.h>
+
+CALC_C_HEADER_BEGIN
+
 /* =---- Standard Buffers Header -------------------------------= */
 
+// Growable Buffers
+
+#ifndef CALC_BUF_INLINE
+/// @brief Size of the inline storage of a buffer, contents up to
+///        this size need no allocation.
+#   define CALC_BUF_INLINE 48
+#endif // CALC_BUF_INLINE
+
+#ifndef CALC_BUF_MIN
+/// @brief Minimum capacity of a buffer out of the inline storage.
+#   define CALC_BUF_MIN 128
+#endif // CALC_BUF_MIN
+
+/// @brief Growable buffer of bytes (or elements): the contents
+///        are kept in the inline storage while they are small,
+///        then in a block taken from the heap or from an arena,
+///        growing geometrically.
+/// @note The inline storage is referenced by the data pointer,
+///       so a buffer cannot be copied (moved) by value.
+typedef struct _buf
+{
+    /// @brief Contents of the buffer.
+    byte_t *data;
+    /// @brief Number of bytes used.
+    size_t len;
+    /// @brief Number of bytes available.
+    size_t cap;
+    /// @brief Arena from which blocks are taken, or NULL for the
+    ///        heap.
+    arena_t *arena;
+    /// @brief Inline storage, aligned for any element.
+    union
+    {
+        byte_t bytes[CALC_BUF_INLINE];
+        void *ptr;
+        uint64_t u64;
+        double f64;
+    } small;
+} buf_t;
+
+// +---- Internal Macros ---------------------------------------+
+
+#pragma region Internal Macros
+
+#ifndef _buf_inline
+/// @brief Checks if a buffer is using its inline storage.
+#   define _buf_inline(buf) ((buf)->data == (buf)->small.bytes)
+#endif // _buf_inline
+
+#pragma endregion
+
+// +---- Internal Macros ------------------------------ END ----+
+
+/// @brief Initializes an empty buffer backed by the heap.
+/// @param buf Buffer to initialize.
+/// @return The initialized buffer.
+buf_t *_CDECL buf_init(buf_t *const buf);
+/// @brief Initializes an empty buffer backed by an arena: its
+///        blocks are released with the arena and buf_release is
+///        not needed.
+/// @param buf Buffer to initialize.
+/// @param arena Arena from which take the blocks.
+/// @return The initialized buffer.
+buf_t *_CDECL buf_init_arena(buf_t *const buf, arena_t *const arena);
+/// @brief Releases the memory of a buffer, leaving it empty and
+///        usable.
+/// @param buf Buffer to release.
+void _CDECL buf_release(buf_t *const buf);
+
+/// @brief Makes room in a buffer for at least the specified
+///        capacity.
+/// @param buf Buffer to grow.
+/// @param cap Total capacity requested, in bytes.
+void _CDECL buf_reserve(buf_t *const buf, size_t cap);
+/// @brief Reduces the capacity of a buffer to its length, moving
+///        the contents back to the inline storage if they fit.
+///        Blocks taken from an arena are kept.
+/// @param buf Buffer to shrink.
+void _CDECL buf_shrink(buf_t *const buf);
+/// @brief Grows a buffer and extends it (see buf_extend).
+void *_CDECL _buf_grow(buf_t *const buf, size_t size);
+
+/// @brief Extends a buffer by the specified number of bytes.
+/// @param buf Buffer to extend.
+/// @param size Number of bytes to add.
+/// @return A pointer to the added (uninitialized) bytes, valid
+///         until the buffer grows again.
+_INLINE void *_CDECL buf_extend(buf_t *const buf, size_t size)
+    _Return((size <= buf->cap - buf->len)
+        ? (void *)(buf->data + (buf->len += size) - size)
+        : _buf_grow(buf, size))
+/// @brief Appends bytes to a buffer.
+/// @param buf Buffer to extend.
+/// @param data Bytes to append.
+/// @param size Number of bytes to append.
+/// @return A pointer to the appended bytes.
+_INLINE void *_CDECL buf_append(buf_t *const buf, const void *const data, size_t size)
+    _Return(memcpy(buf_extend(buf, size), data, size))
+/// @brief Appends formatted data to a buffer, as vprintf.
+/// @param buf Buffer to extend.
+/// @param format Format string.
+/// @param arglist Arguments list.
+/// @return Number of chars appended.
+int _CDECL buf_vprintf(buf_t *const buf, const char *const format, va_list arglist);
+/// @brief Appends formatted data to a buffer, as printf.
+/// @param buf Buffer to extend.
+/// @param format Format string.
+/// @return Number of chars appended.
+int _CDECL buf_printf(buf_t *const buf, const char *const format, ...);
+
+/// @brief Gets the contents of a buffer as a NUL terminated
+///        string, the terminator is not counted in the length.
+/// @param buf Buffer to terminate.
+/// @return The contents of the buffer.
+char *_CDECL buf_cstr(buf_t *const buf);
+
+#ifndef buf_putc
+/// @brief Appends a char to a buffer.
+#   define buf_putc(buf, ch) ((void)(*(char *)buf_extend((buf), 1) = (char)(ch)))
+#endif // buf_putc
+
+#ifndef buf_puts
+/// @brief Appends a NUL terminated string to a buffer, without
+///        its terminator.
+#   define buf_puts(buf, str) ((void)buf_append((buf), (str), strlen(str)))
+#endif // buf_puts
+
+#ifndef buf_clear
+/// @brief Empties a buffer, keeping its capacity.
+#   define buf_clear(buf) ((void)((buf)->len = 0))
+#endif // buf_clear
+
+// Element Access
+
+#ifndef buf_push
+/// @brief Appends an element to a buffer, returning a pointer to
+///        it.
+#   define buf_push(buf, type) ((type *)buf_extend((buf), sizeof(type)))
+#endif // buf_push
+
+#ifndef buf_pop
+/// @brief Removes the last element of a buffer, returning a
+///        pointer to it.
+#   define buf_pop(buf, type) ((type *)((buf)->data + ((buf)->len -= sizeof(type))))
+#endif // buf_pop
+
+#ifndef buf_at
+/// @brief Gets an element of a buffer.
+#   define buf_at(buf, type, index) (((type *)(buf)->data)[index])
+#endif // buf_at
+
+#ifndef buf_count
+/// @brief Gets the number of elements in a buffer.
+#   define buf_count(buf, type) ((buf)->len / sizeof(type))
+#endif // buf_count
+
+// Ring Buffers
+
+/// @brief Bounded single-producer/single-consumer queue of fixed
+///        size elements, lock-free: one thread pushes and another
+///        one pops without synchronizing on the data.
+typedef struct _ring
+{
+    /// @brief Elements, a power of two.
+    byte_t *data;
+    /// @brief Size of an element.
+    size_t size;
+    /// @brief Number of elements minus one.
+    size_t mask;
+    /// @brief Keeps the producer indices off the line above.
+    byte_t pad0[cachelinesiz];
+    /// @brief Index of the next element to push (producer).
+    volatile size_t head;
+    /// @brief Last tail seen by the producer.
+    size_t tail_cache;
+    /// @brief Non-zero once the producer pushed the last element.
+    volatile size_t closed;
+    /// @brief Keeps the producer and consumer indices on
+    ///        different cache lines.
+    byte_t pad1[cachelinesiz];
+    /// @brief Index of the next element to pop (consumer).
+    volatile size_t tail;
+    /// @brief Last head seen by the consumer.
+    size_t head_cache;
+    /// @brief Keeps the consumer indices off the line below.
+    byte_t pad2[cachelinesiz];
+} ring_t;
+
+/// @brief Initializes an empty ring buffer.
+/// @param ring Ring to initialize.
+/// @param size Size of an element.
+/// @param capacity Minimum number of elements, rounded up to a
+///                 power of two.
+/// @return The initialized ring.
+ring_t *_CDECL ring_init(ring_t *const ring, size_t size, size_t capacity);
+/// @brief Releases a ring buffer, no thread must be using it.
+/// @param ring Ring to release.
+void _CDECL ring_release(ring_t *const ring);
+
+/// @brief Pushes as many elements as fit, without waiting. Must
+///        be called by the producer.
+/// @param ring Ring to push into.
+/// @param elems Elements to push.
+/// @param count Number of elements.
+/// @return Number of elements pushed.
+size_t _CDECL ring_push(ring_t *const ring, const void *const elems, size_t count);
+/// @brief Pops as many elements as available, without waiting.
+///        Must be called by the consumer.
+/// @param ring Ring to pop from.
+/// @param elems Output of the popped elements.
+/// @param count Maximum number of elements.
+/// @return Number of elements popped.
+size_t _CDECL ring_pop(ring_t *const ring, void *const elems, size_t count);
+
+/// @brief Pushes all the elements, waiting for room when the ring
+///        is full. Must be called by the producer.
+/// @param ring Ring to push into.
+/// @param elems Elements to push.
+/// @param count Number of elements.
+void _CDECL ring_push_all(ring_t *const ring, const void *const elems, size_t count);
+/// @brief Pops at least one element, waiting while the ring is
+///        empty. Must be called by the consumer.
+/// @param ring Ring to pop from.
+/// @param elems Output of the popped elements.
+/// @param count Maximum number of elements.
+/// @return Number of elements popped, zero only when the ring is
+///         closed and empty.
+size_t _CDECL ring_pop_wait(ring_t *const ring, void *const elems, size_t count);
+/// @brief Marks the end of the stream: once the consumer pops
+///        the remaining elements ring_pop_wait returns zero. Must
+///        be called by the producer.
+/// @param ring Ring to close.
+void _CDECL ring_close(ring_t *const ring);
+
 /* =------------------------------------------------------------= */
 
+CALC_C_HEADER_END
+
 #endif // CALC_BASE_STDBUF_H_
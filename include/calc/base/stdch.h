@@ -13,8 +13,146 @@
 #   include <wchar.h>
 #endif // _UNICODE
 
+CALC_C_HEADER_BEGIN
+
 /* =---- Standard Characters Header ----------------------------= */
 
+// Character Classes
+
+/// @brief Classes of the source chars, independent of the locale.
+///        A char can be in several classes.
+typedef enum _ch_class
+{
+    /// @brief Starts an identifier: [$_A-Za-z].
+    CH_IDSTART = 0x0001,
+    /// @brief Continues an identifier: [$_A-Za-z0-9].
+    CH_IDCONT = 0x0002,
+    /// @brief Binary digit: [01].
+    CH_BDIGIT = 0x0004,
+    /// @brief Octal digit: [0-7].
+    CH_ODIGIT = 0x0008,
+    /// @brief Decimal digit: [0-9].
+    CH_DIGIT = 0x0010,
+    /// @brief Hexadecimal digit: [0-9A-Fa-f].
+    CH_XDIGIT = 0x0020,
+    /// @brief Blank: space, tabs, form feed and line ends.
+    CH_SPACE = 0x0040,
+    /// @brief Line feed.
+    CH_NEWLINE = 0x0080,
+    /// @brief Operator char: [+-*/%=<>!&|^~?:.@#].
+    CH_OPER = 0x0100,
+    /// @brief Punctuation: brackets, semicolon and comma.
+    CH_PUNCT = 0x0200,
+    /// @brief Quote of a char or a string.
+    CH_QUOTE = 0x0400,
+    /// @brief Byte of a UTF-8 sequence (not ASCII), the scanner
+    ///        takes the slow path.
+    CH_UTF8 = 0x0800
+} ch_class_t;
+
+/// @brief Classes of each byte. (ch_class_t masks)
+extern const uint16_t _chtab[256];
+/// @brief Value of each byte as a digit in any radix up to 36, 36
+///        if it is not a digit.
+extern const byte_t _chval[256];
+
+#ifndef chclass
+/// @brief Gets the classes of a char. (ch_class_t mask)
+#   define chclass(ch) (_chtab[(byte_t)(ch)])
+#endif // chclass
+
+#ifndef chis
+/// @brief Checks if a char is in any of some classes.
+#   define chis(ch, classes) ((chclass(ch) & (classes)) != 0)
+#endif // chis
+
+#ifndef ch_isidstart
+/// @brief Checks if an ASCII char starts an identifier.
+#   define ch_isidstart(ch) chis((ch), CH_IDSTART)
+#endif // ch_isidstart
+
+#ifndef ch_isidcont
+/// @brief Checks if an ASCII char continues an identifier.
+#   define ch_isidcont(ch) chis((ch), CH_IDCONT)
+#endif // ch_isidcont
+
+#ifndef ch_isspace
+/// @brief Checks if a char is a blank.
+#   define ch_isspace(ch) chis((ch), CH_SPACE)
+#endif // ch_isspace
+
+#ifndef ch_isoper
+/// @brief Checks if a char is an operator char.
+#   define ch_isoper(ch) chis((ch), CH_OPER)
+#endif // ch_isoper
+
+#ifndef ch_isutf8
+/// @brief Checks if a char is a byte of a UTF-8 sequence.
+#   define ch_isutf8(ch) chis((ch), CH_UTF8)
+#endif // ch_isutf8
+
+#ifndef ch_digit
+/// @brief Gets the value of a digit, 36 if it is not a digit.
+#   define ch_digit(ch) (_chval[(byte_t)(ch)])
+#endif // ch_digit
+
+#ifndef ch_isdigit
+/// @brief Checks if a char is a digit in a radix up to 36.
+#   define ch_isdigit(ch, radix) (ch_digit(ch) < (radix))
+#endif // ch_isdigit
+
+// UTF-8
+
+#ifndef UTF8_MAXLEN
+/// @brief Maximum length of a UTF-8 sequence.
+#   define UTF8_MAXLEN 4
+#endif // UTF8_MAXLEN
+
+/// @brief Gets the length of the ASCII prefix of a string.
+/// @param str String to scan.
+/// @param len Length of the string.
+/// @return The offset of the first byte over 0x7F, or len.
+size_t _CDECL ascii_span(const char *const str, size_t len);
+/// @brief Validates a UTF-8 string, rejecting the overlong forms,
+///        the surrogates and the code points over U+10FFFF.
+/// @param str String to validate.
+/// @param len Length of the string.
+/// @return len if the string is valid, or the offset of the first
+///         invalid or truncated sequence.
+size_t _CDECL utf8_check(const char *const str, size_t len);
+/// @brief Decodes a UTF-8 sequence.
+/// @param str Sequence to decode.
+/// @param len Number of bytes available.
+/// @param cp Output of the code point.
+/// @return The length of the sequence, zero if it is not valid.
+size_t _CDECL utf8_decode(const char *const str, size_t len, uint32_t *const cp);
+
+/// @brief Gets the instruction set selected for the UTF-8
+///        validation ("avx2", "sse2" or "scalar").
+const char *_CDECL utf8_isa();
+
+// Identifiers
+
+/// @brief Checks if a code point can start an identifier: ASCII
+///        follows CH_IDSTART, the rest the ranges of C11 (Annex D).
+/// @param cp Code point to check.
+/// @return TRUE if it can start an identifier.
+bool_t _CDECL uni_isidstart(uint32_t cp);
+/// @brief Checks if a code point can continue an identifier.
+/// @param cp Code point to check.
+/// @return TRUE if it can continue an identifier.
+bool_t _CDECL uni_isidcont(uint32_t cp);
+
+/// @brief Gets the length of an identifier, the ASCII chars are
+///        classified by the table and only the others are decoded.
+/// @param str Text starting at the identifier.
+/// @param len Number of bytes available.
+/// @return The length of the identifier, zero if the first char
+///         cannot start one.
+size_t _CDECL ch_identlen(const char *const str, size_t len);
+
 /* =------------------------------------------------------------= */
 
+CALC_C_HEADER_END
+
 #endif // CALC_BASE_STDCH_H_
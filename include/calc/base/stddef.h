@@ -149,6 +149,17 @@
 #   define _INLINE
 #endif // _INLINE
 
+#ifdef _MSC_VER
+/// @brief Gives a variable a distinct instance for each thread.
+#   define _THREAD_LOCAL __declspec(thread)
+#elif defined __GNUC__
+/// @brief Gives a variable a distinct instance for each thread.
+#   define _THREAD_LOCAL __thread
+#else
+/// @brief Gives a variable a distinct instance for each thread.
+#   define _THREAD_LOCAL _Thread_local
+#endif // _THREAD_LOCAL
+
 // +---- System Dependent Definitions --------------------------+
 
 #pragma region System Dependent Definitions
@@ -227,6 +238,11 @@ _API CALC_C_EXTERN unsigned int _CDECL _getpagesiz();
 #   define wordsiz sizeof(void *)
 #endif // wordsiz
 
+#ifndef cachelinesiz
+/// @brief Gets the cache line size of the target processor.
+#   define cachelinesiz ((size_t)64)
+#endif // cachelinesiz
+
 #ifndef _OS_NAME
 /// @brief Operating system name.
 #   define _OS_NAME "Windows"
@@ -239,7 +255,7 @@ _API CALC_C_EXTERN unsigned int _CDECL _getpagesiz();
 
 #ifndef pagesiz
 /// @brief Gets the system memory page size.
-#   define pagesiz sysconf(PAGESIZE)
+#   define pagesiz ((size_t)sysconf(_SC_PAGESIZE))
 #endif // pagesiz
 
 #ifndef wordsiz
@@ -247,12 +263,88 @@ _API CALC_C_EXTERN unsigned int _CDECL _getpagesiz();
 #   define wordsiz sizeof(void *)
 #endif // wordsiz
 
+#ifndef cachelinesiz
+/// @brief Gets the cache line size of the target processor.
+#   define cachelinesiz ((size_t)64)
+#endif // cachelinesiz
+
 #endif // _WIN32
 
 #pragma endregion
 
 // +---- System Dependent Definitions ----------------- END ----+
 
+// +---- Processor Dependent Definitions -----------------------+
+
+#pragma region Processor Dependent Definitions
+
+#if defined __x86_64__ || defined _M_X64 || defined __SSE2__ || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+/// @brief SSE2 is part of the target instruction set.
+#   define _CALC_SSE2 1
+#endif // __x86_64__ or __SSE2__
+
+#if _CALC_SSE2 && (defined __GNUC__ || defined _MSC_VER)
+/// @brief AVX2 code paths can be compiled, they are selected at
+///        runtime (see cpufeat).
+#   define _CALC_AVX2 1
+#endif // _CALC_SSE2
+
+#ifdef __GNUC__
+/// @brief Compiles a function for an instruction set extension.
+#   define _TARGET(isa) __attribute__((target(isa)))
+#else
+/// @brief Compiles a function for an instruction set extension.
+#   define _TARGET(isa)
+#endif // __GNUC__
+
+/// @brief Processor features detected at runtime.
+typedef enum _cpu_feature
+{
+    /// @brief SSE2 instructions.
+    CPU_SSE2 = 0x01,
+    /// @brief SSE4.2 instructions.
+    CPU_SSE42 = 0x02,
+    /// @brief AVX2 instructions (supported by the system too).
+    CPU_AVX2 = 0x04
+} cpu_feature_t;
+
+/// @brief Detects the features of the processor.
+/// @return A mask of cpu_feature_t flags.
+_API CALC_C_EXTERN unsigned int _CDECL _getcpufeat();
+
+#ifndef cpufeat
+/// @brief Gets the features of the processor. (cpu_feature_t mask)
+#   define cpufeat _getcpufeat()
+#endif // cpufeat
+
+#ifndef cpuhas
+/// @brief Checks if the processor has a feature.
+#   define cpuhas(feature) ((cpufeat & (feature)) == (feature))
+#endif // cpuhas
+
+#ifdef _MSC_VER
+#include <intrin.h>
+
+#pragma intrinsic(_BitScanForward)
+
+/// @brief Counts the trailing zero bits of a non-zero integer.
+static __inline unsigned int _ctz32(unsigned long value)
+{
+    unsigned long index;
+
+    _BitScanForward(&index, value);
+
+    return (unsigned int)index;
+}
+#else
+/// @brief Counts the trailing zero bits of a non-zero integer.
+#   define _ctz32(value) ((unsigned int)__builtin_ctz(value))
+#endif // _MSC_VER
+
+#pragma endregion
+
+// +---- Processor Dependent Definitions -------------- END ----+
+
 /* =------------------------------------------------------------= */
 
 #endif // CALC_BASE_STDDEF_H_
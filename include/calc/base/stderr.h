@@ -15,6 +15,22 @@ CALC_C_HEADER_BEGIN
 
 #pragma region Internal Macros
 
+#if _CALC_BUFFERED_OUTPUT
+
+#ifndef _stderr_errorln
+#   define _stderr_errorln(message) _stdout_wputs(wstderr, (message), FALSE)
+#endif // _stderr_errorln
+
+#ifndef _stderr_verrorf
+#   define _stderr_verrorf(format, arglist) _stdout_wvprintf(wstderr, FALSE, (format), (arglist))
+#endif // _stderr_verrorf
+
+#ifndef _stderr_errorf
+#   define _stderr_errorf(format, ...) _stdout_wprintf(wstderr, FALSE, (format), __VA_ARGS__)
+#endif // _stderr_errorf
+
+#endif // _CALC_BUFFERED_OUTPUT
+
 #ifndef _stderr_error
 #   define _stderr_error(message) fprint(stderr, (message))
 #endif // _stderr_error
@@ -5,8 +5,92 @@
 #ifndef CALC_BASE_STDIN_H_
 #define CALC_BASE_STDIN_H_
 
+#include "calc/base/stdmem.h"
+
+CALC_C_HEADER_BEGIN
+
 /* =---- Standard Input Header ---------------------------------= */
 
+// Chunked Readers
+
+#ifndef CALC_READER_CHUNK
+/// @brief Default size of the reads of a reader.
+#   define CALC_READER_CHUNK 0x10000
+#endif // CALC_READER_CHUNK
+
+#ifndef CALC_READER_PAD
+/// @brief Number of zero bytes kept after the data of a reader.
+#   define CALC_READER_PAD 64
+#endif // CALC_READER_PAD
+
+/// @brief Reader of an unbounded stream, a chunk at a time: the
+///        consumer takes the data it completed and the rest is
+///        kept for the next chunk, so the buffer holds at most a
+///        chunk plus the longest unit (token, statement) split by
+///        a chunk boundary.
+typedef struct _reader
+{
+    /// @brief Descriptor of the stream.
+    int fd;
+    /// @brief Writer flushed before each read, so the output of
+    ///        the data already read comes out before waiting for
+    ///        more input (can be NULL).
+    writer_t *tie;
+    /// @brief Buffer, followed by CALC_READER_PAD zero bytes.
+    char *buf;
+    /// @brief Index of the first byte not consumed.
+    size_t pos;
+    /// @brief Number of bytes in the buffer.
+    size_t len;
+    /// @brief Size of the buffer, without the padding.
+    size_t cap;
+    /// @brief Size of a read.
+    size_t chunk;
+    /// @brief Offset in the stream of the first byte of the buffer.
+    uint64_t offset;
+    /// @brief Set at the end of the stream.
+    bool_t eof;
+    /// @brief Set when a read fails.
+    bool_t error;
+} reader_t;
+
+#ifndef reader_data
+/// @brief Gets the first byte not consumed.
+#   define reader_data(reader) ((reader)->buf + (reader)->pos)
+#endif // reader_data
+
+#ifndef reader_avail
+/// @brief Gets the number of bytes not consumed.
+#   define reader_avail(reader) ((reader)->len - (reader)->pos)
+#endif // reader_avail
+
+#ifndef reader_consume
+/// @brief Consumes bytes, they are dropped by the next read.
+#   define reader_consume(reader, count) ((void)((reader)->pos += (count)))
+#endif // reader_consume
+
+/// @brief Initializes a reader.
+/// @param reader Reader to initialize.
+/// @param fd Descriptor of the stream.
+/// @param chunk Size of a read, zero for CALC_READER_CHUNK.
+/// @param tie Writer to flush before each read, or NULL.
+/// @return The initialized reader.
+reader_t *_CDECL reader_init(reader_t *const reader, int fd, size_t chunk, writer_t *const tie);
+/// @brief Releases the buffer of a reader, the descriptor is not
+///        closed.
+/// @param reader Reader to release.
+void _CDECL reader_release(reader_t *const reader);
+/// @brief Drops the consumed bytes, moving the others to the start
+///        of the buffer, and reads up to a chunk after them. The
+///        buffer grows only when the bytes kept leave less than a
+///        chunk.
+/// @param reader Reader to fill.
+/// @return Number of bytes read, zero at the end of the stream or
+///         on error.
+size_t _CDECL reader_fill(reader_t *const reader);
+
 /* =------------------------------------------------------------= */
 
+CALC_C_HEADER_END
+
 #endif // CALC_BASE_STDIN_H_
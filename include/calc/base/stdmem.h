@@ -6,14 +6,40 @@
 #define CALC_BASE_STDMEM_H_
 
 #include "calc/base/stderr.h"
+#include "calc/base/stdty.h"
 
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 
 CALC_C_HEADER_BEGIN
 
 /* =---- Standard Memory Management Header ---------------------= */
 
+/// @brief Subsystem to which allocations are charged by the
+///        allocation statistics (see memstats_get).
+typedef enum _memtag
+{
+    /// @brief Base library (and untagged allocations).
+    MEMTAG_BASE,
+    /// @brief Lexical analyser.
+    MEMTAG_LEX,
+    /// @brief Abstract syntax tree.
+    MEMTAG_AST,
+    /// @brief Syntactic analyser.
+    MEMTAG_PARSE,
+    /// @brief Evaluator.
+    MEMTAG_EVAL,
+    /// @brief Number of subsystems.
+    MEMTAG_COUNT
+} memtag_t;
+
+#ifndef _CALC_MEM_TAG
+/// @brief Subsystem of the translation unit, set by the build
+///        of each library.
+#   define _CALC_MEM_TAG MEMTAG_BASE
+#endif // _CALC_MEM_TAG
+
 /// @brief Allocates a block of bytes on the heap.
 /// @param size Number of bytes to allocate.
 /// @return A pointer to the allocated block of memory.
@@ -73,6 +99,37 @@ void *_CDECL checked_callocz(size_t count, size_t size);
 #   define dimz(type, count) (type *)checked_callocz((count), sizeof(type))
 #endif // dimz
 
+/// @brief Changes the size of a block allocated on the heap.
+/// @param block Block to resize, if NULL a new one is allocated.
+/// @param size New size in bytes.
+/// @return A pointer to the resized block of memory.
+void *_CDECL checked_realloc(void *const block, size_t size);
+/// @brief Frees a block allocated by one of the checked
+///        allocators (except the aligned ones).
+/// @param block Block to free, can be NULL.
+void _CDECL checked_free(void *const block);
+
+#ifndef _calloc_fits
+/// @brief Checks that a series of blocks takes at most half the
+///        address space: a larger one cannot be allocated, and the
+///        headers and the padding of the allocators cannot wrap
+///        its size.
+#   define _calloc_fits(count, size) (!(size) || (count) <= (SIZE_MAX >> 1) / (size))
+#endif // _calloc_fits
+
+#ifndef _malloc_fits
+/// @brief Checks that a block takes at most half the address space,
+///        so that its size is not wrapped by the alignment of the
+///        stack allocators. (see _calloc_fits)
+#   define _malloc_fits(size) ((size) <= (SIZE_MAX >> 1))
+#endif // _malloc_fits
+
+/// @brief Aborts an allocation of a block or a series of blocks that
+///        does not fit (see _calloc_fits and _malloc_fits), as a
+///        failed allocation. (slow path)
+/// @return Does not return.
+void *_CDECL _calloc_overflow();
+
 // Aligned Allocators
 
 #ifndef alignto
@@ -80,21 +137,24 @@ void *_CDECL checked_callocz(size_t count, size_t size);
 #   define alignto(size, alignment) (((size) + (alignment) - 1) & ~((alignment) - 1))
 #endif // alignto
 
-/// @brief Allocates an aligned block of bytes on the heap.
-/// @param align Alignment to follow.
+/// @brief Allocates an aligned block of bytes on the heap, the
+///        block must be freed with checked_aligned_free.
+/// @param align Alignment of the block address, must be a power
+///              of two.
 /// @param size Number of bytes to allocate.
 /// @return A pointer to the allocated block of memory.
-_INLINE void *_CDECL checked_aligned_malloc(size_t align, size_t size)
-    _Return(checked_malloc(alignto(size, align)))
-/// @brief Allocates a series of contiguous aligned blocks
-///		   of memory on the heap and sets them to zero.
-/// @param align Alignment to follow.
+void *_CDECL checked_aligned_malloc(size_t align, size_t size);
+/// @brief Allocates a series of contiguous blocks of memory on
+///		   the heap and sets them to zero, each block is padded
+///        so that all of them are aligned. The series must be
+///        freed with checked_aligned_free.
+/// @param align Alignment of each block address, must be a
+///              power of two.
 /// @param count Number of blocks to allocate.
 /// @param size Number of bytes in each block.
 /// @return A pointer to the beginning of the first
 ///			allocated block.
-_INLINE void *_CDECL checked_aligned_calloc(size_t align, size_t count, size_t size)
-    _Return(checked_calloc(count, alignto(size, align)))
+void *_CDECL checked_aligned_calloc(size_t align, size_t count, size_t size);
 
 #ifndef aligned_alloc
 /// @brief Allocates an aligned instance of the specified type on
@@ -115,20 +175,23 @@ _INLINE void *_CDECL checked_aligned_calloc(size_t align, size_t count, size_t s
 #endif // aligned_dim
 
 /// @brief Allocates an aligned block of bytes on the heap and
-///        sets them to zero.
+///        sets them to zero, the block must be freed with
+///        checked_aligned_free.
+/// @param align Alignment of the block address, must be a power
+///              of two.
 /// @param size Number of bytes to allocate.
 /// @return A pointer to the allocated block of memory.
-_INLINE void *_CDECL checked_aligned_mallocz(size_t align, size_t size)
-    _Return(checked_mallocz(alignto(size, align)))
+void *_CDECL checked_aligned_mallocz(size_t align, size_t size);
 /// @brief Allocates a series of contiguous aligned blocks
-///		   of memory on the heap and sets them to zero.
-/// @param align Alignment to follow.
+///		   of memory on the heap and sets them to zero. The
+///        series must be freed with checked_aligned_free.
+/// @param align Alignment of each block address, must be a
+///              power of two.
 /// @param count Number of blocks to allocate.
 /// @param size Number of bytes in each block.
 /// @return A pointer to the beginning of the first
 ///			allocated block.
-_INLINE void *_CDECL checked_aligned_callocz(size_t align, size_t count, size_t size)
-    _Return(checked_callocz(count, alignto(size, align)))
+void *_CDECL checked_aligned_callocz(size_t align, size_t count, size_t size);
 
 #ifndef aligned_allocz
 /// @brief Allocates an aligned instance of the specified type on
@@ -148,62 +211,729 @@ _INLINE void *_CDECL checked_aligned_callocz(size_t align, size_t count, size_t
 #   define aligned_dimz(type, count, alignment) (type *)checked_aligned_callocz((alignment), (count), sizeof(type))
 #endif // aligned_dimz
 
-// Stack Allocators
+/// @brief Frees a block allocated by one of the aligned
+///        allocators.
+/// @param block Block to free, can be NULL.
+void _CDECL checked_aligned_free(void *const block);
 
-#ifndef stackalloc
-#   ifdef malloca
-/// @brief If its possible, allocates an instance of the specified
-///        type on the stack.
+// Cache Line and Page Aligned Allocators
+
+#ifndef checked_line_malloc
+/// @brief Allocates a cache line aligned block of bytes on the
+///        heap (see checked_aligned_malloc).
+#   define checked_line_malloc(size) checked_aligned_malloc(cachelinesiz, (size))
+#endif // checked_line_malloc
+
+#ifndef checked_line_mallocz
+/// @brief Allocates a cache line aligned block of bytes on the
+///        heap and sets them to zero (see checked_aligned_mallocz).
+#   define checked_line_mallocz(size) checked_aligned_mallocz(cachelinesiz, (size))
+#endif // checked_line_mallocz
+
+#ifndef line_alloc
+/// @brief Allocates an instance of the specified type on its own
+///        cache lines, so that it shares none of them with other
+///        data (useful for per-thread data).
 /// @param type The type to instantiate.
 /// @return A pointer to the instanced block of memory.
-#       define stackalloc(type) malloca(sizeof(type))
-#   elif defined alloca
-/// @brief If its possible, allocates an instance of the specified
-///        type on the stack. (can cause overflow)
+#   define line_alloc(type) (type *)checked_line_malloc(alignto(sizeof(type), cachelinesiz))
+#endif // line_alloc
+
+#ifndef line_allocz
+/// @brief Allocates an instance of the specified type on its own
+///        cache lines and sets its value to zero.
 /// @param type The type to instantiate.
 /// @return A pointer to the instanced block of memory.
-#       define stackalloc(type) alloca(sizeof(type))
-#   else
-/// @brief If its possible, allocates an instance of the specified
-///        type on the stack.
-///        
-///        NOTE: Function alloca not found, currently this macro
-///        allocates on the heap (using allocz).
-/// 
+#   define line_allocz(type) (type *)checked_line_mallocz(alignto(sizeof(type), cachelinesiz))
+#endif // line_allocz
+
+#ifndef line_dim
+/// @brief Allocates an array of instances of the specified type,
+///        the array starts on a cache line boundary.
+/// @param type The type to instantiate.
+/// @param count Number of instances to allocate.
+/// @return A pointer to the first instance in the array.
+#   define line_dim(type, count) (type *)checked_line_malloc(sizeof(type) * (count))
+#endif // line_dim
+
+#ifndef line_dimz
+/// @brief Allocates an array of instances of the specified type,
+///        the array starts on a cache line boundary and its values
+///        are set to zero.
+/// @param type The type to instantiate.
+/// @param count Number of instances to allocate.
+/// @return A pointer to the first instance in the array.
+#   define line_dimz(type, count) (type *)checked_line_mallocz(sizeof(type) * (count))
+#endif // line_dimz
+
+#ifndef checked_page_malloc
+/// @brief Allocates a page aligned block of bytes on the heap
+///        (see checked_aligned_malloc).
+#   define checked_page_malloc(size) checked_aligned_malloc(pagesiz, (size))
+#endif // checked_page_malloc
+
+#ifndef checked_page_mallocz
+/// @brief Allocates a page aligned block of bytes on the heap and
+///        sets them to zero (see checked_aligned_mallocz).
+#   define checked_page_mallocz(size) checked_aligned_mallocz(pagesiz, (size))
+#endif // checked_page_mallocz
+
+#ifndef page_dim
+/// @brief Allocates an array of instances of the specified type,
+///        the array starts on a page boundary.
+/// @param type The type to instantiate.
+/// @param count Number of instances to allocate.
+/// @return A pointer to the first instance in the array.
+#   define page_dim(type, count) (type *)checked_page_malloc(sizeof(type) * (count))
+#endif // page_dim
+
+#ifndef page_dimz
+/// @brief Allocates an array of instances of the specified type,
+///        the array starts on a page boundary and its values are
+///        set to zero.
+/// @param type The type to instantiate.
+/// @param count Number of instances to allocate.
+/// @return A pointer to the first instance in the array.
+#   define page_dimz(type, count) (type *)checked_page_mallocz(sizeof(type) * (count))
+#endif // page_dimz
+
+// Scratch Allocators
+
+#ifndef CALC_SCRATCH_RESERVE
+/// @brief Size of the scratch stack reserve of each thread,
+///        bigger requests spill to the heap.
+#   define CALC_SCRATCH_RESERVE 0x100000
+#endif // CALC_SCRATCH_RESERVE
+
+#ifndef CALC_SCRATCH_ALIGN
+/// @brief Alignment of each block returned by the scratch stack.
+#   define CALC_SCRATCH_ALIGN 16
+#endif // CALC_SCRATCH_ALIGN
+
+/// @brief Block spilled to the heap by a scratch stack.
+typedef struct _scratch_spill
+{
+    /// @brief Previously spilled block.
+    struct _scratch_spill *prev;
+} scratch_spill_t;
+
+/// @brief Scratch stack, a LIFO allocator for temporary buffers
+///        (one for each thread, see scratch_push).
+typedef struct _scratch
+{
+    /// @brief Beginning of the reserve.
+    byte_t *base;
+    /// @brief First free byte of the reserve.
+    byte_t *ptr;
+    /// @brief End of the reserve.
+    byte_t *end;
+    /// @brief Newest spilled block.
+    struct _scratch_spill *spill;
+} scratch_t;
+
+/// @brief Scope of the scratch stack, returned by scratch_push.
+typedef struct _scratch_mark
+{
+    /// @brief First free byte of the reserve when pushed.
+    byte_t *ptr;
+    /// @brief Newest spilled block when pushed.
+    struct _scratch_spill *spill;
+} scratch_mark_t;
+
+/// @brief Scratch stack of the calling thread. (internal)
+extern _THREAD_LOCAL scratch_t _scratch;
+
+/// @brief Allocates a block that doesn't fit the reserve of
+///        the calling thread. (slow path)
+/// @param size Number of bytes to allocate (already aligned).
+/// @return A pointer to the allocated block of memory.
+void *_CDECL _scratch_spill(size_t size);
+
+/// @brief Opens a scope of the scratch stack of the calling
+///        thread.
+/// @return The mark to pass to scratch_pop.
+scratch_mark_t _CDECL scratch_push();
+/// @brief Releases every block allocated from the scratch stack
+///        of the calling thread after the matching scratch_push.
+/// @param mark Mark returned by scratch_push.
+void _CDECL scratch_pop(const scratch_mark_t mark);
+/// @brief Frees the reserve of the scratch stack of the calling
+///        thread, to call before the thread exits.
+void _CDECL scratch_release();
+
+/// @brief Allocates a block of bytes from the scratch stack of
+///        the calling thread.
+/// @param size Number of bytes to allocate.
+/// @return A pointer to the allocated block of memory.
+_INLINE void *_CDECL scratch_malloc(size_t size)
+    _Return(_malloc_fits(size)
+        ? ((size = alignto(size, CALC_SCRATCH_ALIGN)) <= (size_t)(_scratch.end - _scratch.ptr)
+            ? (void *)((_scratch.ptr += size) - size)
+            : _scratch_spill(size))
+        : _calloc_overflow())
+/// @brief Allocates a series of contiguous blocks of memory
+///        from the scratch stack of the calling thread.
+/// @param count Number of blocks to allocate.
+/// @param size Number of bytes in each block.
+/// @return A pointer to the beginning of the first
+///			allocated block.
+_INLINE void *_CDECL scratch_calloc(size_t count, size_t size)
+    _Return(_calloc_fits(count, size) ? scratch_malloc(count * size) : _calloc_overflow())
+/// @brief Allocates a block of bytes from the scratch stack of
+///        the calling thread and sets them to zero.
+/// @param size Number of bytes to allocate.
+/// @return A pointer to the allocated block of memory.
+_INLINE void *_CDECL scratch_mallocz(size_t size)
+    _Return(memset(scratch_malloc(size), 0, size))
+/// @brief Allocates a series of contiguous blocks of memory
+///        from the scratch stack of the calling thread and sets
+///        them to zero.
+/// @param count Number of blocks to allocate.
+/// @param size Number of bytes in each block.
+/// @return A pointer to the beginning of the first
+///			allocated block.
+_INLINE void *_CDECL scratch_callocz(size_t count, size_t size)
+    _Return(memset(scratch_calloc(count, size), 0, count * size))
+
+// Stack Allocators
+
+#ifndef stackalloc
+/// @brief Allocates an instance of the specified type on the
+///        scratch stack of the calling thread, it lives until
+///        the enclosing scratch_push scope is popped.
 /// @param type The type to instantiate.
 /// @return A pointer to the instanced block of memory.
-#       define stackalloc(type) allocz(type)
-#   endif // malloca/alloca
+#   define stackalloc(type) (type *)scratch_malloc(sizeof(type))
 #endif // stackalloc
 
+#ifndef stackallocz
+/// @brief Allocates an instance of the specified type on the
+///        scratch stack of the calling thread and sets its value
+///        to zero.
+/// @param type The type to instantiate.
+/// @return A pointer to the instanced block of memory.
+#   define stackallocz(type) (type *)scratch_mallocz(sizeof(type))
+#endif // stackallocz
+
 #ifndef stackdim
-#   ifdef malloca
-/// @brief If its possible, allocates an array of instances of the
-///        specified type.
+/// @brief Allocates an array of instances of the specified type
+///        on the scratch stack of the calling thread, it lives
+///        until the enclosing scratch_push scope is popped.
+/// @param type The type to instantiate.
+/// @param count Number of instances to allocate.
+/// @return A pointer to the first instance in the array.
+#   define stackdim(type, count) (type *)scratch_calloc((count), sizeof(type))
+#endif // stackdim
+
+#ifndef stackdimz
+/// @brief Allocates an array of instances of the specified type
+///        on the scratch stack of the calling thread and sets
+///        their values to zero.
 /// @param type The type to instantiate.
 /// @param count Number of instances to allocate.
+/// @return A pointer to the first instance in the array.
+#   define stackdimz(type, count) (type *)scratch_callocz((count), sizeof(type))
+#endif // stackdimz
+
+// Arena Allocators
+
+#ifndef CALC_ARENA_ALIGN
+/// @brief Alignment of each block returned by an arena.
+#   define CALC_ARENA_ALIGN 16
+#endif // CALC_ARENA_ALIGN
+
+#ifndef CALC_ARENA_CHUNK_MIN
+/// @brief Default size of the first chunk of an arena.
+#   define CALC_ARENA_CHUNK_MIN 0x1000
+#endif // CALC_ARENA_CHUNK_MIN
+
+#ifndef CALC_ARENA_CHUNK_MAX
+/// @brief Size limit of the chunk growth of an arena, bigger
+///        blocks get a dedicated chunk.
+#   define CALC_ARENA_CHUNK_MAX 0x100000
+#endif // CALC_ARENA_CHUNK_MAX
+
+/// @brief Arena chunk, the header of a block of memory from
+///        which an arena bumps its allocations.
+typedef struct _arena_chunk
+{
+    /// @brief Previously allocated chunk.
+    struct _arena_chunk *prev;
+    /// @brief Number of bytes available after the header.
+    size_t size;
+} arena_chunk_t;
+
+/// @brief Region allocator: blocks are bumped out of chunks
+///        and released all together when the arena is released
+///        (or rewound to a mark).
+typedef struct _arena
+{
+    /// @brief Current chunk, head of the chunk list.
+    arena_chunk_t *chunk;
+    /// @brief First free byte of the current chunk.
+    byte_t *ptr;
+    /// @brief End of the current chunk.
+    byte_t *end;
+    /// @brief Size of the next chunk to allocate.
+    size_t next;
+#if _CALC_MEM_STATS
+    /// @brief Subsystem charged for the chunks.
+    memtag_t tag;
+#endif // _CALC_MEM_STATS
+} arena_t;
+
+/// @brief Position in an arena to which it can be rewound.
+typedef struct _arena_mark
+{
+    /// @brief Current chunk when the mark was taken.
+    arena_chunk_t *chunk;
+    /// @brief First free byte when the mark was taken.
+    byte_t *ptr;
+} arena_mark_t;
+
+// +---- Internal Macros ---------------------------------------+
+
+#pragma region Internal Macros
+
+#ifndef _arena_chunk_hdrsiz
+#   define _arena_chunk_hdrsiz alignto(sizeof(arena_chunk_t), CALC_ARENA_ALIGN)
+#endif // _arena_chunk_hdrsiz
+
+#ifndef _arena_chunk_data
+#   define _arena_chunk_data(chunk) ((byte_t *)(chunk) + _arena_chunk_hdrsiz)
+#endif // _arena_chunk_data
+
+#ifndef _arena_bump
+#   define _arena_bump(arena, size)                                \
+    (((size) <= (size_t)((arena)->end - (arena)->ptr))             \
+        ? (void *)(((arena)->ptr += (size)) - (size))              \
+        : _arena_grow((arena), (size)))
+#endif // _arena_bump
+
+#pragma endregion
+
+// +---- Internal Macros ------------------------------ END ----+
+
+/// @brief Initializes an empty arena, no memory is allocated
+///        until the first block is requested.
+/// @param arena Arena to initialize.
+/// @param chunksiz Size of the first chunk, if zero is used
+///                 CALC_ARENA_CHUNK_MIN.
+/// @return The initialized arena.
+arena_t *_CDECL arena_init(arena_t *const arena, size_t chunksiz);
+/// @brief Allocates a new chunk on the heap and bumps from it
+///        a block of the specified size. (slow path)
+/// @param arena Arena that needs a new chunk.
+/// @param size Number of bytes to allocate (already aligned).
+/// @return A pointer to the allocated block of memory.
+void *_CDECL _arena_grow(arena_t *const arena, size_t size);
+
+/// @brief Allocates a block of bytes from an arena.
+/// @param arena Arena from which allocate.
+/// @param size Number of bytes to allocate.
+/// @return A pointer to the allocated block of memory.
+_INLINE void *_CDECL arena_malloc(arena_t *const arena, size_t size)
+    _Return(_malloc_fits(size)
+        ? (size = alignto(size, CALC_ARENA_ALIGN), _arena_bump(arena, size))
+        : _calloc_overflow())
+/// @brief Allocates a series of contiguous blocks of memory
+///        from an arena.
+/// @param arena Arena from which allocate.
+/// @param count Number of blocks to allocate.
+/// @param size Number of bytes in each block.
+/// @return A pointer to the beginning of the first
+///			allocated block.
+_INLINE void *_CDECL arena_calloc(arena_t *const arena, size_t count, size_t size)
+    _Return(_calloc_fits(count, size)
+        ? (size = alignto(count * size, CALC_ARENA_ALIGN), _arena_bump(arena, size))
+        : _calloc_overflow())
+/// @brief Allocates a block of bytes from an arena and sets
+///        them to zero.
+/// @param arena Arena from which allocate.
+/// @param size Number of bytes to allocate.
+/// @return A pointer to the allocated block of memory.
+_INLINE void *_CDECL arena_mallocz(arena_t *const arena, size_t size)
+    _Return(memset(arena_malloc(arena, size), 0, size))
+/// @brief Allocates a series of contiguous blocks of memory
+///        from an arena and sets them to zero.
+/// @param arena Arena from which allocate.
+/// @param count Number of blocks to allocate.
+/// @param size Number of bytes in each block.
+/// @return A pointer to the beginning of the first
+///			allocated block.
+_INLINE void *_CDECL arena_callocz(arena_t *const arena, size_t count, size_t size)
+    _Return(memset(arena_calloc(arena, count, size), 0, count * size))
+
+#ifndef arena_alloc
+/// @brief Allocates an instance of the specified type from
+///        an arena.
+/// @param arena Arena from which allocate.
+/// @param type The type to instantiate.
 /// @return A pointer to the instanced block of memory.
-#       define stackdim(type, count) malloca(sizeof(type) * (count))
-#   elif defined alloca
-/// @brief If its possible, allocates an array of instances of the
-///        specified type. (can cause overflow)
+#   define arena_alloc(arena, type) (type *)arena_malloc((arena), sizeof(type))
+#endif // arena_alloc
+
+#ifndef arena_dim
+/// @brief Allocates an array of instances of the specified
+///        type from an arena.
+/// @param arena Arena from which allocate.
 /// @param type The type to instantiate.
 /// @param count Number of instances to allocate.
+/// @return A pointer to the first instance in the array.
+#   define arena_dim(arena, type, count) (type *)arena_calloc((arena), (count), sizeof(type))
+#endif // arena_dim
+
+#ifndef arena_allocz
+/// @brief Allocates an instance of the specified type from
+///        an arena and sets its value to zero.
+/// @param arena Arena from which allocate.
+/// @param type The type to instantiate.
 /// @return A pointer to the instanced block of memory.
-#       define stackdim(type, count) alloca(sizeof(type) * (count))
-#   else
-/// @brief If its possible, allocates an array of instances of the
-///        specified type.
-///        
-///        NOTE: Function alloca not found, currently this macro
-///        allocates on the heap (using dimz).
-/// 
+#   define arena_allocz(arena, type) (type *)arena_mallocz((arena), sizeof(type))
+#endif // arena_allocz
+
+#ifndef arena_dimz
+/// @brief Allocates an array of instances of the specified
+///        type from an arena and sets their values to zero.
+/// @param arena Arena from which allocate.
 /// @param type The type to instantiate.
 /// @param count Number of instances to allocate.
+/// @return A pointer to the first instance in the array.
+#   define arena_dimz(arena, type, count) (type *)arena_callocz((arena), (count), sizeof(type))
+#endif // arena_dimz
+
+/// @brief Gets the current position of an arena.
+/// @param arena Arena to mark.
+/// @return The mark to pass to arena_rewind.
+arena_mark_t _CDECL arena_mark(const arena_t *const arena);
+/// @brief Releases every block allocated from an arena after
+///        the specified mark was taken.
+/// @param arena Arena to rewind.
+/// @param mark Mark taken from the same arena.
+void _CDECL arena_rewind(arena_t *const arena, const arena_mark_t mark);
+/// @brief Releases every block allocated from an arena, the
+///        arena can be reused without initializing it again.
+/// @param arena Arena to release.
+void _CDECL arena_release(arena_t *const arena);
+
+// Pool Allocators
+
+#ifndef CALC_POOL_ALIGN
+/// @brief Alignment of each object returned by a pool, it is
+///        also the size step between two size classes.
+#   define CALC_POOL_ALIGN 8
+#endif // CALC_POOL_ALIGN
+
+#ifndef CALC_POOL_CLASS_MAX
+/// @brief Size of the biggest size class, bigger objects are
+///        allocated on the heap.
+#   define CALC_POOL_CLASS_MAX 256
+#endif // CALC_POOL_CLASS_MAX
+
+#ifndef CALC_POOL_CLASSES
+/// @brief Number of size classes.
+#   define CALC_POOL_CLASSES (CALC_POOL_CLASS_MAX / CALC_POOL_ALIGN)
+#endif // CALC_POOL_CLASSES
+
+/// @brief Pool slab, the header of a page from which a pool
+///        carves its objects.
+typedef struct _pool_slab
+{
+    /// @brief Previously allocated slab.
+    struct _pool_slab *prev;
+} pool_slab_t;
+
+/// @brief Free object, linked into the free list of its pool.
+typedef struct _pool_node
+{
+    /// @brief Next free object.
+    struct _pool_node *next;
+} pool_node_t;
+
+/// @brief Fixed-size object allocator: objects are carved out
+///        of page-sized slabs and returned to an intrusive free
+///        list when freed.
+typedef struct _pool
+{
+    /// @brief Head of the free list.
+    pool_node_t *free;
+    /// @brief Newest slab, head of the slab list.
+    pool_slab_t *slab;
+    /// @brief First byte never carved of the newest slab.
+    byte_t *ptr;
+    /// @brief End of the newest slab.
+    byte_t *end;
+    /// @brief Size of each object.
+    size_t size;
+    /// @brief Size of each slab.
+    size_t slabsiz;
+    /// @brief Number of allocated slabs.
+    size_t slabs;
+    /// @brief Number of objects the slabs can hold.
+    size_t capacity;
+    /// @brief Number of objects in use.
+    size_t used;
+    /// @brief Maximum number of objects in use at the same time.
+    size_t peak;
+#if _CALC_MEM_STATS
+    /// @brief Subsystem charged for the slabs.
+    memtag_t tag;
+#endif // _CALC_MEM_STATS
+} pool_t;
+
+/// @brief Size class allocator, a set of pools one for each
+///        multiple of CALC_POOL_ALIGN up to CALC_POOL_CLASS_MAX.
+typedef struct _pools
+{
+    /// @brief Pool of each size class.
+    pool_t classes[CALC_POOL_CLASSES];
+} pools_t;
+
+// +---- Internal Macros ---------------------------------------+
+
+#pragma region Internal Macros
+
+#ifndef _pool_slab_hdrsiz
+#   define _pool_slab_hdrsiz alignto(sizeof(pool_slab_t), CALC_POOL_ALIGN)
+#endif // _pool_slab_hdrsiz
+
+#ifndef _pools_class
+#   define _pools_class(size) (((size) ? (size) - 1 : 0) / CALC_POOL_ALIGN)
+#endif // _pools_class
+
+#pragma endregion
+
+// +---- Internal Macros ------------------------------ END ----+
+
+/// @brief Initializes an empty pool of objects.
+/// @param pool Pool to initialize.
+/// @param size Size of each object.
+/// @return The initialized pool.
+pool_t *_CDECL pool_init(pool_t *const pool, size_t size);
+/// @brief Allocates an object from a pool.
+/// @param pool Pool from which allocate.
+/// @return A pointer to the allocated object.
+void *_CDECL pool_malloc(pool_t *const pool);
+/// @brief Allocates an object from a pool and sets it to zero.
+/// @param pool Pool from which allocate.
+/// @return A pointer to the allocated object.
+void *_CDECL pool_mallocz(pool_t *const pool);
+/// @brief Returns an object to its pool.
+/// @param pool Pool from which the object was allocated.
+/// @param block Object to free.
+void _CDECL pool_free(pool_t *const pool, void *const block);
+/// @brief Releases every slab of a pool, the pool can be reused
+///        without initializing it again.
+/// @param pool Pool to release.
+void _CDECL pool_release(pool_t *const pool);
+
+/// @brief Initializes a size class allocator.
+/// @param pools Size class allocator to initialize.
+/// @return The initialized size class allocator.
+pools_t *_CDECL pools_init(pools_t *const pools);
+/// @brief Allocates an object from the pool of its size class.
+/// @param pools Size class allocator.
+/// @param size Size of the object.
+/// @return A pointer to the allocated object.
+_INLINE void *_CDECL pools_malloc(pools_t *const pools, size_t size)
+    _Return((size <= CALC_POOL_CLASS_MAX) ? pool_malloc(&pools->classes[_pools_class(size)]) : checked_malloc(size))
+/// @brief Allocates an object from the pool of its size class
+///        and sets it to zero.
+/// @param pools Size class allocator.
+/// @param size Size of the object.
+/// @return A pointer to the allocated object.
+_INLINE void *_CDECL pools_mallocz(pools_t *const pools, size_t size)
+    _Return((size <= CALC_POOL_CLASS_MAX) ? pool_mallocz(&pools->classes[_pools_class(size)]) : checked_mallocz(size))
+/// @brief Returns an object to the pool of its size class.
+/// @param pools Size class allocator.
+/// @param block Object to free.
+/// @param size Size of the object, as passed to pools_malloc.
+void _CDECL pools_free(pools_t *const pools, void *const block, size_t size);
+/// @brief Releases every slab of each size class.
+/// @param pools Size class allocator to release.
+void _CDECL pools_release(pools_t *const pools);
+
+#ifndef pools_alloc
+/// @brief Allocates an instance of the specified type from
+///        the pool of its size class.
+/// @param pools Size class allocator.
+/// @param type The type to instantiate.
 /// @return A pointer to the instanced block of memory.
-#       define stackdim(type, count) dimz(type, count)
-#   endif // malloca/alloca
-#endif // stackdim
+#   define pools_alloc(pools, type) (type *)pools_malloc((pools), sizeof(type))
+#endif // pools_alloc
+
+#ifndef pools_allocz
+/// @brief Allocates an instance of the specified type from
+///        the pool of its size class and sets its value to zero.
+/// @param pools Size class allocator.
+/// @param type The type to instantiate.
+/// @return A pointer to the instanced block of memory.
+#   define pools_allocz(pools, type) (type *)pools_mallocz((pools), sizeof(type))
+#endif // pools_allocz
+
+#ifndef pools_dealloc
+/// @brief Returns an instance of the specified type to the
+///        pool of its size class.
+/// @param pools Size class allocator.
+/// @param block Instance to free.
+/// @param type The type of the instance.
+#   define pools_dealloc(pools, block, type) pools_free((pools), (block), sizeof(type))
+#endif // pools_dealloc
+
+// Thread Heaps
+
+/// @brief Allocation context of a thread: an arena and a size
+///        class allocator used without locks by the owner, plus
+///        a queue of the objects freed by the other threads.
+typedef struct _heap
+{
+    /// @brief Arena of the owner thread.
+    arena_t arena;
+    /// @brief Size class allocator of the owner thread.
+    pools_t pools;
+    /// @brief Keeps the remote free lists off the cache lines
+    ///        written by the owner thread.
+    byte_t pad[cachelinesiz];
+    /// @brief Objects freed by other threads, a lock-free list
+    ///        for each size class.
+    pool_node_t *volatile remote[CALC_POOL_CLASSES];
+} heap_t;
+
+/// @brief Gets the heap of the calling thread, it is created on
+///        first use.
+/// @return The heap of the calling thread.
+heap_t *_CDECL heap_current();
+/// @brief Allocates an object from a heap, must be called by the
+///        owner thread.
+/// @param heap Heap of the calling thread.
+/// @param size Size of the object.
+/// @return A pointer to the allocated object.
+void *_CDECL heap_malloc(heap_t *const heap, size_t size);
+/// @brief Allocates an object from a heap and sets it to zero,
+///        must be called by the owner thread.
+/// @param heap Heap of the calling thread.
+/// @param size Size of the object.
+/// @return A pointer to the allocated object.
+void *_CDECL heap_mallocz(heap_t *const heap, size_t size);
+/// @brief Returns an object to the heap from which it was
+///        allocated, from any thread: objects of other threads
+///        are queued and collected later by the owner.
+/// @param heap Heap from which the object was allocated.
+/// @param block Object to free.
+/// @param size Size of the object, as passed to heap_malloc.
+void _CDECL heap_free(heap_t *const heap, void *const block, size_t size);
+/// @brief Hands the arena of a heap over to the caller, the heap
+///        continues with an empty arena. The returned arena can
+///        be used and released by any thread.
+/// @param heap Heap of the calling thread.
+/// @return The arena with all the blocks allocated so far.
+arena_t _CDECL heap_take_arena(heap_t *const heap);
+/// @brief Releases the heap of the calling thread, to call before
+///        the thread exits when none of its objects is in use.
+void _CDECL heap_release();
+
+#ifndef heap_alloc
+/// @brief Allocates an instance of the specified type from a
+///        heap (see heap_malloc).
+/// @param heap Heap of the calling thread.
+/// @param type The type to instantiate.
+/// @return A pointer to the instanced block of memory.
+#   define heap_alloc(heap, type) (type *)heap_malloc((heap), sizeof(type))
+#endif // heap_alloc
+
+#ifndef heap_allocz
+/// @brief Allocates an instance of the specified type from a
+///        heap and sets its value to zero (see heap_mallocz).
+/// @param heap Heap of the calling thread.
+/// @param type The type to instantiate.
+/// @return A pointer to the instanced block of memory.
+#   define heap_allocz(heap, type) (type *)heap_mallocz((heap), sizeof(type))
+#endif // heap_allocz
+
+#ifndef heap_dealloc
+/// @brief Returns an instance of the specified type to the heap
+///        from which it was allocated (see heap_free).
+/// @param heap Heap from which the instance was allocated.
+/// @param block Instance to free.
+/// @param type The type of the instance.
+#   define heap_dealloc(heap, block, type) heap_free((heap), (block), sizeof(type))
+#endif // heap_dealloc
+
+// Allocation Statistics
+
+#ifndef CALC_MEM_HIST_BINS
+/// @brief Number of bins of the allocation size histogram, bin
+///        n counts the sizes up to 16 << n bytes (the last one
+///        counts all the bigger sizes).
+#   define CALC_MEM_HIST_BINS 16
+#endif // CALC_MEM_HIST_BINS
+
+/// @brief Allocation statistics of a subsystem, collected only
+///        when the library is built with _CALC_MEM_STATS.
+typedef struct _memstats
+{
+    /// @brief Number of allocations.
+    size_t allocs;
+    /// @brief Number of frees.
+    size_t frees;
+    /// @brief Total number of allocated bytes.
+    size_t bytes;
+    /// @brief Number of bytes currently allocated.
+    size_t live;
+    /// @brief Maximum number of bytes allocated at the same time.
+    size_t peak;
+    /// @brief Allocation size histogram.
+    size_t hist[CALC_MEM_HIST_BINS];
+} memstats_t;
+
+/// @brief Gets the allocation statistics of a subsystem.
+/// @param tag Subsystem, MEMTAG_COUNT gets the totals.
+/// @return The statistics, or NULL if they are not collected.
+const memstats_t *_CDECL memstats_get(memtag_t tag);
+/// @brief Prints the allocation statistics report.
+/// @param stream Stream on which print the report.
+/// @return Number of characters written.
+int _CDECL memstats_print(FILE *const stream);
+
+#if _CALC_MEM_STATS
+
+void *_CDECL checked_malloc_tag(size_t size, memtag_t tag);
+void *_CDECL checked_calloc_tag(size_t count, size_t size, memtag_t tag);
+void *_CDECL checked_mallocz_tag(size_t size, memtag_t tag);
+void *_CDECL checked_callocz_tag(size_t count, size_t size, memtag_t tag);
+void *_CDECL checked_realloc_tag(void *const block, size_t size, memtag_t tag);
+void *_CDECL checked_aligned_malloc_tag(size_t align, size_t size, memtag_t tag);
+void *_CDECL checked_aligned_calloc_tag(size_t align, size_t count, size_t size, memtag_t tag);
+void *_CDECL checked_aligned_mallocz_tag(size_t align, size_t size, memtag_t tag);
+void *_CDECL checked_aligned_callocz_tag(size_t align, size_t count, size_t size, memtag_t tag);
+arena_t *_CDECL arena_init_tag(arena_t *const arena, size_t chunksiz, memtag_t tag);
+pool_t *_CDECL pool_init_tag(pool_t *const pool, size_t size, memtag_t tag);
+pools_t *_CDECL pools_init_tag(pools_t *const pools, memtag_t tag);
+
+// +---- Tagging Macros ----------------------------------------+
+
+#pragma region Tagging Macros
+
+/* charge the allocations to the subsystem of the caller */
+
+#define checked_malloc(size) checked_malloc_tag((size), _CALC_MEM_TAG)
+#define checked_calloc(count, size) checked_calloc_tag((count), (size), _CALC_MEM_TAG)
+#define checked_mallocz(size) checked_mallocz_tag((size), _CALC_MEM_TAG)
+#define checked_callocz(count, size) checked_callocz_tag((count), (size), _CALC_MEM_TAG)
+#define checked_realloc(block, size) checked_realloc_tag((block), (size), _CALC_MEM_TAG)
+#define checked_aligned_malloc(align, size) checked_aligned_malloc_tag((align), (size), _CALC_MEM_TAG)
+#define checked_aligned_calloc(align, count, size) checked_aligned_calloc_tag((align), (count), (size), _CALC_MEM_TAG)
+#define checked_aligned_mallocz(align, size) checked_aligned_mallocz_tag((align), (size), _CALC_MEM_TAG)
+#define checked_aligned_callocz(align, count, size) checked_aligned_callocz_tag((align), (count), (size), _CALC_MEM_TAG)
+#define arena_init(arena, chunksiz) arena_init_tag((arena), (chunksiz), _CALC_MEM_TAG)
+#define pool_init(pool, size) pool_init_tag((pool), (size), _CALC_MEM_TAG)
+#define pools_init(pools) pools_init_tag((pools), _CALC_MEM_TAG)
+
+#pragma endregion
+
+// +---- Tagging Macros ------------------------------- END ----+
+
+#endif // _CALC_MEM_STATS
 
 /* =------------------------------------------------------------= */
 
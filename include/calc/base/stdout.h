@@ -5,10 +5,11 @@
 #ifndef CALC_BASE_STDOUT_H_
 #define CALC_BASE_STDOUT_H_
 
-#include "calc/base/stddef.h"
+#include "calc/base/stdty.h"
 
 #include <stdarg.h>
 #include <stdio.h>
+#include <string.h>
 
 CALC_C_HEADER_BEGIN
 
@@ -20,6 +21,62 @@ CALC_C_HEADER_BEGIN
 
 // Printing Macros
 
+#if _CALC_BUFFERED_OUTPUT
+
+/* the standard streams are routed through their writers, each
+   message is written under the lock of the standard writers */
+
+#ifndef _stdout_routed
+#   define _stdout_routed(stream) ((stream) == stdout || (stream) == stderr)
+#endif // _stdout_routed
+
+#ifndef _stdout_writer
+#   define _stdout_writer(stream) ((stream) == stdout ? wstdout : wstderr)
+#endif // _stdout_writer
+
+#ifndef _stdout_fputln
+#   define _stdout_fputln(stream) \
+    (_stdout_routed(stream) ? _stdout_wputs(_stdout_writer(stream), "", TRUE) : (fputc('\n', (stream)) - ('\n' - 1)))
+#endif // _stdout_fputln
+
+#ifndef _stdout_putln
+#   define _stdout_putln() _stdout_wputs(wstdout, "", TRUE)
+#endif // _stdout_putln
+
+#ifndef _stdout_fprint
+#   define _stdout_fprint(stream, message) \
+    (_stdout_routed(stream) ? _stdout_wputs(_stdout_writer(stream), (message), FALSE) : fprintf((stream), "%s", (message)))
+#endif // _stdout_fprint
+
+#ifndef _stdout_fprintln
+#   define _stdout_fprintln(stream, message) \
+    (_stdout_routed(stream) ? _stdout_wputs(_stdout_writer(stream), (message), FALSE) : fputs((message), (stream)))
+#endif // _stdout_fprintln
+
+#ifndef _stdout_print
+#   define _stdout_print(message) _stdout_wputs(wstdout, (message), FALSE)
+#endif // _stdout_print
+
+#ifndef _stdout_println
+#   define _stdout_println(message) _stdout_wputs(wstdout, (message), TRUE)
+#endif // _stdout_println
+
+#ifndef _stdout_vfprintfn
+#   define _stdout_vfprintfn(stream, format, arglist)                         \
+    (_stdout_routed(stream) ? _stdout_wvprintf(_stdout_writer(stream), TRUE, (format), (arglist)) \
+                            : vfprintf((stream), (format), (arglist)) + _stdout_fputln(stream))
+#endif // _stdout_vfprintfn
+
+#ifndef _stdout_vprintfn
+#   define _stdout_vprintfn(format, arglist) _stdout_wvprintf(wstdout, TRUE, (format), (arglist))
+#endif // _stdout_vprintfn
+
+#ifndef _stdout_printfn
+#   define _stdout_printfn(format, ...) _stdout_wprintf(wstdout, TRUE, (format), __VA_ARGS__)
+#endif // _stdout_printfn
+
+#endif // _CALC_BUFFERED_OUTPUT
+
 #ifndef _stdout_fputln
 #   define _stdout_fputln(stream) (fputc('\n', (stream)) - ('\n' - 1))
 #endif // _stdout_fputln
@@ -60,6 +117,16 @@ CALC_C_HEADER_BEGIN
 #   define _stdout_printfn(format, ...) (printf((format), __VA_ARGS__) + _stdout_putln())
 #endif // _stdout_printfn
 
+// Variable Arguments
+
+#ifndef va_copy
+#   ifdef __va_copy
+#       define va_copy(dst, src) __va_copy((dst), (src))
+#   else
+#       define va_copy(dst, src) ((void)memcpy(&(dst), &(src), sizeof(va_list)))
+#   endif // __va_copy
+#endif // va_copy
+
 // Inlining Macros
 
 #ifndef _Return
@@ -95,6 +162,179 @@ CALC_C_HEADER_BEGIN
 
 // +---- Internal Macros ------------------------------ END ----+
 
+// Buffered Writers
+
+#ifndef CALC_WRITER_BUFSIZ
+/// @brief Size of the buffer of the standard output writer.
+#   define CALC_WRITER_BUFSIZ 0x10000
+#endif // CALC_WRITER_BUFSIZ
+
+/// @brief When a writer flushes its buffer.
+typedef enum _writer_mode
+{
+    /// @brief When the buffer is full.
+    WRITER_FULL,
+    /// @brief At the end of each line.
+    WRITER_LINE,
+    /// @brief At the end of each write.
+    WRITER_NONE,
+    /// @brief Line buffered on terminals, else fully buffered.
+    WRITER_AUTO
+} writer_mode_t;
+
+/// @brief Buffered writer on a file descriptor, it writes with
+///        direct system calls and skips the stdio locking and
+///        format parsing. It is not synchronized, a writer must
+///        be used by a single thread at a time (the print functions
+///        lock the standard writers, the writer functions do not).
+/// @note Data written with stdio on the same stream is flushed
+///       before the buffer of the writer, mixing the two can
+///       reorder the output.
+typedef struct _writer
+{
+    /// @brief Descriptor of the file.
+    int fd;
+    /// @brief Stdio stream on the same descriptor, flushed before
+    ///        each write to keep the order of the output (can be
+    ///        NULL).
+    FILE *stream;
+    /// @brief Buffer, owned by the creator of the writer.
+    char *buf;
+    /// @brief Number of buffered chars.
+    size_t len;
+    /// @brief Size of the buffer.
+    size_t cap;
+    /// @brief Flushing mode, WRITER_AUTO until the first write.
+    writer_mode_t mode;
+    /// @brief Set when a write fails.
+    bool_t error;
+} writer_t;
+
+/// @brief Piece of data for writer_writev.
+typedef struct _writer_piece
+{
+    /// @brief Data to write.
+    const void *data;
+    /// @brief Number of bytes to write.
+    size_t size;
+} writer_piece_t;
+
+/// @brief Writer of the standard output (see wstdout).
+extern writer_t _wstdout;
+/// @brief Writer of the standard error (see wstderr).
+extern writer_t _wstderr;
+
+#ifndef wstdout
+/// @brief Writer of the standard output, flushed at exit.
+#   define wstdout (&_wstdout)
+#endif // wstdout
+
+#ifndef wstderr
+/// @brief Writer of the standard error, never buffered past a
+///        single write.
+#   define wstderr (&_wstderr)
+#endif // wstderr
+
+/// @brief Writes a message on a standard writer under the lock of
+///        the standard writers, the print functions can be called
+///        by any thread. (see print)
+/// @param writer Standard writer to use.
+/// @param message Message to write.
+/// @param line Whether to end the line.
+/// @return Number of chars written.
+int _CDECL _stdout_wputs(writer_t *const writer, const char *const message, bool_t line);
+/// @brief Writes a formatted message on a standard writer under the
+///        lock of the standard writers. (see _stdout_wputs)
+/// @param writer Standard writer to use.
+/// @param line Whether to end the line.
+/// @param format Format string.
+/// @param arglist Format arguments.
+/// @return Number of chars written.
+int _CDECL _stdout_wvprintf(writer_t *const writer, bool_t line, const char *const format, va_list arglist);
+/// @brief Writes a formatted message on a standard writer under the
+///        lock of the standard writers. (see _stdout_wputs)
+/// @param writer Standard writer to use.
+/// @param line Whether to end the line.
+/// @param format Format string.
+/// @param others Format arguments.
+/// @return Number of chars written.
+int _CDECL _stdout_wprintf(writer_t *const writer, bool_t line, const char *const format, ...);
+
+/// @brief Initializes a writer.
+/// @param writer Writer to initialize.
+/// @param fd Descriptor of the file to write.
+/// @param buf Buffer of the writer, it must live until the writer
+///            is flushed for the last time.
+/// @param size Size of the buffer.
+/// @param mode Flushing mode.
+/// @return The initialized writer.
+writer_t *_CDECL writer_init(writer_t *const writer, int fd, char *const buf, size_t size, writer_mode_t mode);
+/// @brief Writes the buffered data.
+/// @param writer Writer to flush.
+/// @return Zero on success, -1 if the write failed.
+int _CDECL writer_flush(writer_t *const writer);
+
+/// @brief Writes a block of data.
+/// @param writer Writer to use.
+/// @param data Data to write.
+/// @param size Number of bytes to write.
+/// @return Number of bytes written.
+int _CDECL writer_write(writer_t *const writer, const void *const data, size_t size);
+/// @brief Writes scattered pieces of data, gathering them with a
+///        single system call when they don't fit in the buffer.
+/// @param writer Writer to use.
+/// @param pieces Pieces to write.
+/// @param count Number of pieces.
+/// @return Number of bytes written.
+int _CDECL writer_writev(writer_t *const writer, const writer_piece_t *const pieces, size_t count);
+/// @brief Writes a char (see writer_putc).
+int _CDECL _writer_putc(writer_t *const writer, int ch);
+
+/// @brief Writes a char.
+/// @param writer Writer to use.
+/// @param ch Char to write.
+/// @return Number of chars written.
+_INLINE int _CDECL writer_putc(writer_t *const writer, int ch)
+    _Return((writer->mode == WRITER_FULL && writer->len < writer->cap)
+        ? (writer->buf[writer->len++] = (char)ch, 1)
+        : _writer_putc(writer, ch))
+/// @brief Writes a NUL terminated string.
+/// @param writer Writer to use.
+/// @param str String to write.
+/// @return Number of chars written.
+_INLINE int _CDECL writer_puts(writer_t *const writer, const char *const str)
+    _Return(writer_write(writer, str, strlen(str)))
+
+/// @brief Writes an unsigned integer in decimal.
+/// @param writer Writer to use.
+/// @param value Value to write.
+/// @return Number of chars written.
+int _CDECL writer_putu(writer_t *const writer, uint64_t value);
+/// @brief Writes a signed integer in decimal.
+/// @param writer Writer to use.
+/// @param value Value to write.
+/// @return Number of chars written.
+int _CDECL writer_puti(writer_t *const writer, int64_t value);
+/// @brief Writes an unsigned integer in hexadecimal (lowercase,
+///        without prefix).
+/// @param writer Writer to use.
+/// @param value Value to write.
+/// @return Number of chars written.
+int _CDECL writer_putx(writer_t *const writer, uint64_t value);
+
+/// @brief Writes formatted data, as vprintf.
+/// @param writer Writer to use.
+/// @param format Format string.
+/// @param arglist Format arguments.
+/// @return Number of chars written.
+int _CDECL writer_vprintf(writer_t *const writer, const char *const format, va_list arglist);
+/// @brief Writes formatted data, as printf.
+/// @param writer Writer to use.
+/// @param format Format string.
+/// @param others Format arguments.
+/// @return Number of chars written.
+int _CDECL writer_printf(writer_t *const writer, const char *const format, ...);
+
 /// @brief Puts an empty line in the specified stream.
 /// @param stream Stream pointer on which put the empty
 ///               line.
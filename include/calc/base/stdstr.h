@@ -5,8 +5,280 @@
 #ifndef CALC_BASE_STDSTR_H_
 #define CALC_BASE_STDSTR_H_
 
+#include "calc/base/stdmem.h"
+
+CALC_C_HEADER_BEGIN
+
 /* =---- Standard String Header --------------------------------= */
 
+#ifndef NUL
+/// @brief String terminator.
+#   define NUL '\0'
+#endif // NUL
+
+/// @brief Computes the hash of a string. (not cryptographic)
+/// @param str String to hash.
+/// @param len Length of the string.
+/// @return The hash of the string.
+uint64_t _CDECL strhash(const char *const str, size_t len);
+
+// Case Conversion and Comparison
+
+/// @brief Copies a string into a buffer, always terminating it.
+/// @param dst Destination buffer of at least count + 1 chars, or
+///            NULL to allocate it.
+/// @param src Source string, or NULL to leave the buffer empty.
+/// @param count Number of chars to copy.
+/// @return The destination buffer.
+char *_CDECL strnget(char *const dst, const char *const src, size_t count);
+/// @brief Copies a string converting it to ASCII lowercase.
+/// @param dst Destination buffer of at least count + 1 chars, or
+///            NULL to allocate it. It can be the source itself.
+/// @param src Source string, or NULL to leave the buffer empty.
+/// @param count Number of chars to convert.
+/// @return The destination buffer.
+char *_CDECL strnlow(char *const dst, const char *const src, size_t count);
+/// @brief Copies a string converting it to ASCII uppercase.
+/// @param dst Destination buffer of at least count + 1 chars, or
+///            NULL to allocate it. It can be the source itself.
+/// @param src Source string, or NULL to leave the buffer empty.
+/// @param count Number of chars to convert.
+/// @return The destination buffer.
+char *_CDECL strnupp(char *const dst, const char *const src, size_t count);
+
+/// @brief Copies a NUL terminated string. (see strnget)
+char *_CDECL strget(char *const dst, const char *const src);
+/// @brief Copies a NUL terminated string in lowercase. (see strnlow)
+char *_CDECL strlow(char *const dst, const char *const src);
+/// @brief Copies a NUL terminated string in uppercase. (see strnupp)
+char *_CDECL strupp(char *const dst, const char *const src);
+
+/// @brief Compares two strings of known length.
+/// @param str1 First string.
+/// @param str2 Second string.
+/// @param len Length of both strings.
+/// @return TRUE if the strings are equal.
+bool_t _CDECL strneq(const char *const str1, const char *const str2, size_t len);
+/// @brief Compares two strings of known length ignoring the ASCII
+///        case.
+/// @param str1 First string.
+/// @param str2 Second string.
+/// @param len Length of both strings.
+/// @return TRUE if the strings are equal.
+bool_t _CDECL strniq(const char *const str1, const char *const str2, size_t len);
+/// @brief Finds the first occurrence of a char. (like memchr)
+/// @param str String to search.
+/// @param ch Char to find.
+/// @param len Length of the string.
+/// @return The first occurrence, or NULL if not found.
+const char *_CDECL strnchr(const char *const str, int ch, size_t len);
+
+/// @brief Compares two NUL terminated strings, they can be NULL.
+bool_t _CDECL streq(const char *const str1, const char *const str2);
+/// @brief Compares two NUL terminated strings ignoring the ASCII
+///        case, they can be NULL.
+bool_t _CDECL striq(const char *const str1, const char *const str2);
+
+/// @brief Gets the instruction set selected for the string
+///        operations ("avx2", "sse2" or "scalar").
+const char *_CDECL strisa();
+/// @brief Selects the instruction set of the string operations, to
+///        compare them (the best one is selected by default).
+/// @param isa Name of the instruction set (see strisa).
+/// @return TRUE if the instruction set is supported, FALSE if the
+///         selection is unchanged.
+bool_t _CDECL strsetisa(const char *const isa);
+
+// String Views
+
+/// @brief Non-owning view of a string: it points into a buffer
+///        owned by someone else (e.g. the source) and it is not
+///        NUL terminated.
+typedef struct _strv
+{
+    /// @brief First char of the string.
+    const char *ptr;
+    /// @brief Length of the string.
+    size_t len;
+} strv_t;
+
+/// @brief Creates a view of a string.
+/// @param ptr First char of the string.
+/// @param len Length of the string.
+/// @return The view.
+strv_t _CDECL strv(const char *const ptr, size_t len);
+/// @brief Creates a view of a NUL terminated string.
+/// @param cstr String to view, NULL gives an empty view.
+/// @return The view.
+strv_t _CDECL strv_cstr(const char *const cstr);
+/// @brief Creates a view of a part of a view, clamped to it.
+/// @param view Viewed string.
+/// @param start Index of the first char.
+/// @param len Maximum length of the part.
+/// @return The view of the part.
+strv_t _CDECL strv_sub(strv_t view, size_t start, size_t len);
+/// @brief Copies a view into a new NUL terminated string.
+/// @param view View to copy.
+/// @return The copy, to free with checked_free.
+char *_CDECL strv_dup(strv_t view);
+
+/// @brief Compares two views.
+/// @param view1 First view.
+/// @param view2 Second view.
+/// @return TRUE if the strings are equal.
+_INLINE bool_t _CDECL strv_eq(strv_t view1, strv_t view2)
+    _Return(view1.len == view2.len && strneq(view1.ptr, view2.ptr, view1.len))
+/// @brief Compares two views ignoring the ASCII case.
+/// @param view1 First view.
+/// @param view2 Second view.
+/// @return TRUE if the strings are equal.
+_INLINE bool_t _CDECL strv_iq(strv_t view1, strv_t view2)
+    _Return(view1.len == view2.len && strniq(view1.ptr, view2.ptr, view1.len))
+/// @brief Compares a view with a NUL terminated string.
+/// @param view View to compare.
+/// @param cstr String to compare.
+/// @return TRUE if the strings are equal.
+_INLINE bool_t _CDECL strv_eqc(strv_t view, const char *const cstr)
+    _Return(strlen(cstr) == view.len && strneq(view.ptr, cstr, view.len))
+/// @brief Checks if a view starts with a prefix.
+/// @param view View to check.
+/// @param prefix Prefix to find.
+/// @return TRUE if the view starts with the prefix.
+_INLINE bool_t _CDECL strv_prefix(strv_t view, strv_t prefix)
+    _Return(view.len >= prefix.len && strneq(view.ptr, prefix.ptr, prefix.len))
+/// @brief Checks if a view ends with a suffix.
+/// @param view View to check.
+/// @param suffix Suffix to find.
+/// @return TRUE if the view ends with the suffix.
+_INLINE bool_t _CDECL strv_suffix(strv_t view, strv_t suffix)
+    _Return(view.len >= suffix.len && strneq(view.ptr + view.len - suffix.len, suffix.ptr, suffix.len))
+/// @brief Computes the hash of a view. (see strhash)
+/// @param view View to hash.
+/// @return The hash of the string.
+_INLINE uint64_t _CDECL strv_hash(strv_t view)
+    _Return(strhash(view.ptr, view.len))
+
+/// @brief Compares two views lexicographically.
+/// @param view1 First view.
+/// @param view2 Second view.
+/// @return Less than, equal to or greater than zero if the first
+///         view is less than, equal to or greater than the second.
+int _CDECL strv_cmp(strv_t view1, strv_t view2);
+/// @brief Finds the first occurrence of a char in a view.
+/// @param view View to search.
+/// @param ch Char to find.
+/// @return The index of the char, or the length if not found.
+size_t _CDECL strv_chr(strv_t view, int ch);
+
+/// @brief Parses an integer, with optional sign and radix prefix
+///        as the literals of the language: one or more zeros and
+///        b, c, d or x, either case (00x1F, 0c17). The whole view
+///        must be the number.
+/// @param view View to parse.
+/// @param value Output of the parsed value.
+/// @return FALSE if the view is not a valid integer or it does
+///         not fit in 64 bits.
+bool_t _CDECL strv_toi(strv_t view, int64_t *const value);
+/// @brief Parses a floating point number with strtod. The whole
+///        view must be the number. The decimal point is the one of
+///        the current locale: the C locale must be set (it is until
+///        setlocale is called).
+/// @param view View to parse.
+/// @param value Output of the parsed value.
+/// @return FALSE if the view is not a valid number.
+bool_t _CDECL strv_tof(strv_t view, double *const value);
+
+// String Interning
+
+/// @brief Interned string, unique for each content in its table:
+///        two interned strings of the same table are equal if
+///        and only if they are the same pointer. It can be used
+///        as a NUL terminated string.
+typedef const char *istr_t;
+
+/// @brief Header stored before the text of an interned string.
+typedef struct _istr_hdr
+{
+    /// @brief Hash of the string.
+    uint32_t hash;
+    /// @brief Length of the string.
+    uint32_t len;
+} istr_hdr_t;
+
+/// @brief Slot of a string table.
+typedef struct _strtab_slot
+{
+    /// @brief Hash of the string.
+    uint32_t hash;
+    /// @brief Length of the string.
+    uint32_t len;
+    /// @brief Interned string, NULL if the slot is empty.
+    istr_t str;
+} strtab_slot_t;
+
+/// @brief String table (interner): an open addressing hash table
+///        whose strings are copied into an arena.
+typedef struct _strtab
+{
+    /// @brief Slots, a power of two.
+    strtab_slot_t *slots;
+    /// @brief Number of slots minus one.
+    size_t mask;
+    /// @brief Number of interned strings.
+    size_t count;
+    /// @brief Storage of the interned strings.
+    arena_t arena;
+} strtab_t;
+
+#ifndef istrlen
+/// @brief Gets the length of an interned string.
+#   define istrlen(istr) ((size_t)((const istr_hdr_t *)(istr) - 1)->len)
+#endif // istrlen
+
+#ifndef istrhash
+/// @brief Gets the (truncated) hash of an interned string.
+#   define istrhash(istr) (((const istr_hdr_t *)(istr) - 1)->hash)
+#endif // istrhash
+
+#ifndef istreq
+/// @brief Compares two interned strings of the same table.
+#   define istreq(istr1, istr2) ((istr1) == (istr2))
+#endif // istreq
+
+/// @brief Initializes an empty string table.
+/// @param tab Table to initialize.
+/// @param capacity Number of strings expected, the table grows
+///                 when they are more.
+/// @return The initialized table.
+strtab_t *_CDECL strtab_init(strtab_t *const tab, size_t capacity);
+/// @brief Interns a string, copying it the first time.
+/// @param tab String table.
+/// @param str String to intern, doesn't need a terminator.
+/// @param len Length of the string.
+/// @return The unique interned string with the same content.
+istr_t _CDECL strtab_intern(strtab_t *const tab, const char *const str, size_t len);
+/// @brief Finds an already interned string.
+/// @param tab String table.
+/// @param str String to find.
+/// @param len Length of the string.
+/// @return The interned string, or NULL if it was never interned.
+istr_t _CDECL strtab_find(const strtab_t *const tab, const char *const str, size_t len);
+/// @brief Releases a string table and all its strings.
+/// @param tab Table to release.
+void _CDECL strtab_release(strtab_t *const tab);
+
+#ifndef strtab_cintern
+/// @brief Interns a NUL terminated string.
+#   define strtab_cintern(tab, cstr) strtab_intern((tab), (cstr), strlen(cstr))
+#endif // strtab_cintern
+
+#ifndef strtab_vintern
+/// @brief Interns a string view.
+#   define strtab_vintern(tab, view) strtab_intern((tab), (view).ptr, (view).len)
+#endif // strtab_vintern
+
 /* =------------------------------------------------------------= */
 
+CALC_C_HEADER_END
+
 #endif // CALC_BASE_STDSTR_H_
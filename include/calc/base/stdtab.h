@@ -5,8 +5,242 @@
 #ifndef CALC_BASE_STDTAB_H_
 #define CALC_BASE_STDTAB_H_
 
+#include "calc/base/stdbuf.h"
+#include "calc/base/stdstr.h"
+
+CALC_C_HEADER_BEGIN
+
 /* =---- Standard Hash Tables Header ---------------------------= */
 
+#ifndef CALC_TAB_GROUP
+/// @brief Number of control bytes probed at once.
+#   define CALC_TAB_GROUP 16
+#endif // CALC_TAB_GROUP
+
+#ifndef CALC_TAB_LOAD
+/// @brief Maximum load of a table (numerator over 8).
+#   define CALC_TAB_LOAD 6
+#endif // CALC_TAB_LOAD
+
+/// @brief Hashes a key.
+typedef uint64_t (*tab_hash_t)(const void *key);
+/// @brief Compares two keys, returns TRUE if they are equal.
+typedef bool_t (*tab_eq_t)(const void *key1, const void *key2);
+
+/// @brief Open addressing hash table with generic keys and
+///        values, stored by copy in its slots. Each slot has a
+///        control byte, empty or holding 7 bits of the hash of
+///        its key, so the slots are probed a group at a time
+///        (SSE2) and the keys are compared only on a match. It
+///        uses linear probing with backward shift deletion, so
+///        there are no tombstones.
+typedef struct _tab
+{
+    /// @brief Control bytes, one for each slot plus a copy of the
+    ///        first group after the last slot.
+    byte_t *ctrl;
+    /// @brief Slots, each holding a key followed by its value.
+    byte_t *slots;
+    /// @brief Hash of the key of each slot, used to move the keys
+    ///        without hashing them again.
+    uint32_t *hashes;
+    /// @brief Number of slots minus one.
+    size_t mask;
+    /// @brief Number of keys.
+    size_t count;
+    /// @brief Size of a key.
+    size_t keysiz;
+    /// @brief Size of a value.
+    size_t valsiz;
+    /// @brief Offset of the value in a slot.
+    size_t valoff;
+    /// @brief Size of a slot.
+    size_t slotsiz;
+    /// @brief Hash function of the keys.
+    tab_hash_t hash;
+    /// @brief Equality function of the keys.
+    tab_eq_t eq;
+} tab_t;
+
+/// @brief Statistics of a table.
+typedef struct _tab_stats
+{
+    /// @brief Number of keys.
+    size_t count;
+    /// @brief Number of slots.
+    size_t capacity;
+    /// @brief Ratio between keys and slots.
+    double load;
+    /// @brief Average number of slots probed by a successful
+    ///        lookup.
+    double probe_avg;
+    /// @brief Longest probe of a successful lookup.
+    size_t probe_max;
+} tab_stats_t;
+
+#ifndef tab_key
+/// @brief Gets the key of a slot.
+#   define tab_key(tab, slot) ((void *)(slot))
+#endif // tab_key
+
+#ifndef tab_val
+/// @brief Gets the value of a slot.
+#   define tab_val(tab, slot) ((void *)((byte_t *)(slot) + (tab)->valoff))
+#endif // tab_val
+
+/// @brief Initializes an empty table.
+/// @param tab Table to initialize.
+/// @param keysiz Size of a key.
+/// @param valsiz Size of a value, zero for a set.
+/// @param hash Hash function of the keys, NULL to hash their
+///             bytes.
+/// @param eq Equality function of the keys, NULL to compare their
+///           bytes.
+/// @param capacity Number of keys expected, the table grows when
+///                 they are more.
+/// @return The initialized table.
+tab_t *_CDECL tab_init(tab_t *const tab, size_t keysiz, size_t valsiz, tab_hash_t hash, tab_eq_t eq, size_t capacity);
+/// @brief Releases a table.
+/// @param tab Table to release.
+void _CDECL tab_release(tab_t *const tab);
+/// @brief Removes all the keys of a table, keeping its slots.
+/// @param tab Table to clear.
+void _CDECL tab_clear(tab_t *const tab);
+
+/// @brief Finds a key.
+/// @param tab Table to search.
+/// @param key Key to find.
+/// @return The slot of the key, or NULL if not found.
+void *_CDECL tab_find(const tab_t *const tab, const void *const key);
+/// @brief Finds a key, inserting it if missing.
+/// @param tab Table to update.
+/// @param key Key to find or insert.
+/// @param isnew Optional output, TRUE if the key was inserted.
+/// @return The slot of the key, the value of a new key is zero.
+///         It is valid until the table is changed.
+void *_CDECL tab_put(tab_t *const tab, const void *const key, bool_t *const isnew);
+/// @brief Removes a key.
+/// @param tab Table to update.
+/// @param key Key to remove.
+/// @return TRUE if the key was found.
+bool_t _CDECL tab_remove(tab_t *const tab, const void *const key);
+
+/// @brief Iterates the slots of a table.
+/// @param tab Table to iterate.
+/// @param index Iterator, zero to get the first slot.
+/// @return The next slot, or NULL at the end.
+void *_CDECL tab_next(const tab_t *const tab, size_t *const index);
+/// @brief Computes the statistics of a table.
+/// @param tab Table to inspect.
+/// @param stats Output of the statistics.
+void _CDECL tab_stats(const tab_t *const tab, tab_stats_t *const stats);
+
+/// @brief Gets the value of a slot, NULL if the slot is NULL.
+_INLINE void *_CDECL _tab_value(const tab_t *const tab, void *const slot)
+    _Return(slot ? (void *)((byte_t *)slot + tab->valoff) : NULL)
+
+#ifndef tab_get
+/// @brief Finds the value of a key, NULL if not found.
+#   define tab_get(tab, type, key) ((type *)_tab_value((tab), tab_find((tab), (key))))
+#endif // tab_get
+
+#ifndef tab_set
+/// @brief Finds or inserts a key, returning its value.
+#   define tab_set(tab, type, key) ((type *)tab_val((tab), tab_put((tab), (key), NULL)))
+#endif // tab_set
+
+// Common Keys
+
+/// @brief Hashes a string view key (strv_t).
+uint64_t _CDECL tab_hash_strv(const void *key);
+/// @brief Compares two string view keys (strv_t).
+bool_t _CDECL tab_eq_strv(const void *key1, const void *key2);
+/// @brief Hashes a pointer key, e.g. an interned string (istr_t).
+uint64_t _CDECL tab_hash_ptr(const void *key);
+
+// Scoped Tables
+
+/// @brief Binding of a name in a scoped table.
+typedef struct _symtab_entry
+{
+    /// @brief Bound symbol.
+    void *sym;
+    /// @brief Depth of the scope of the binding.
+    size_t depth;
+} symtab_entry_t;
+
+/// @brief Entry of the undo log of a scoped table.
+typedef struct _symtab_undo
+{
+    /// @brief Name bound in the scope.
+    istr_t name;
+    /// @brief Binding shadowed by it, the symbol is NULL if the
+    ///        name was not bound.
+    symtab_entry_t prev;
+} symtab_undo_t;
+
+/// @brief Symbol table of nested scopes: a single hash table maps
+///        each name to its innermost binding, so a lookup is one
+///        probe. Each binding logs the one it shadows, leaving a
+///        scope replays the log back to the mark of the scope.
+typedef struct _symtab
+{
+    /// @brief Innermost binding of each name (istr_t keys).
+    tab_t names;
+    /// @brief Undo log (symtab_undo_t).
+    buf_t undo;
+    /// @brief Length of the undo log when each scope was entered
+    ///        (size_t).
+    buf_t marks;
+} symtab_t;
+
+#ifndef symtab_depth
+/// @brief Gets the depth of the current scope, zero is the global
+///        scope.
+#   define symtab_depth(symtab) buf_count(&(symtab)->marks, size_t)
+#endif // symtab_depth
+
+/// @brief Initializes a scoped table in the global scope.
+/// @param symtab Table to initialize.
+/// @return The initialized table.
+symtab_t *_CDECL symtab_init(symtab_t *const symtab);
+/// @brief Releases a scoped table.
+/// @param symtab Table to release.
+void _CDECL symtab_release(symtab_t *const symtab);
+
+/// @brief Enters a new scope, in constant time.
+/// @param symtab Scoped table.
+void _CDECL symtab_enter(symtab_t *const symtab);
+/// @brief Leaves the current scope, restoring the bindings it
+///        shadowed. It costs one probe for each binding of the
+///        scope, already paid when binding (amortized constant).
+/// @param symtab Scoped table.
+void _CDECL symtab_exit(symtab_t *const symtab);
+
+/// @brief Binds a name in the current scope.
+/// @param symtab Scoped table.
+/// @param name Interned name.
+/// @param sym Symbol to bind (not NULL).
+/// @return FALSE if the name is already bound in the current
+///         scope, the binding is left unchanged.
+bool_t _CDECL symtab_bind(symtab_t *const symtab, istr_t name, void *const sym);
+/// @brief Resolves a name with a single probe.
+/// @param symtab Scoped table.
+/// @param name Interned name.
+/// @return The innermost binding, or NULL if the name is unbound.
+const symtab_entry_t *_CDECL symtab_lookup(const symtab_t *const symtab, istr_t name);
+
+#ifndef symtab_find
+/// @brief Resolves a name to its symbol, NULL if unbound.
+#   define symtab_find(symtab, name) _symtab_sym(symtab_lookup((symtab), (name)))
+#endif // symtab_find
+
+/// @brief Gets the symbol of a binding, NULL if there is none.
+_INLINE void *_CDECL _symtab_sym(const symtab_entry_t *const entry)
+    _Return(entry ? entry->sym : NULL)
+
 /* =------------------------------------------------------------= */
 
+CALC_C_HEADER_END
+
 #endif // CALC_BASE_STDTAB_H_
@@ -0,0 +1,160 @@
+#pragma once
+
+/* stdthrd.h - Copyright (c) 2024 Frithurik Grint */
+
+#ifndef CALC_BASE_STDTHRD_H_
+#define CALC_BASE_STDTHRD_H_
+
+#include "calc/base/stdty.h"
+
+#ifdef _WIN32
+#   include <windows.h>
+#else
+#   include <pthread.h>
+#endif // _WIN32
+
+CALC_C_HEADER_BEGIN
+
+/* =---- Standard Threads Header -------------------------------= */
+
+// Atomic Operations
+
+#ifdef _MSC_VER
+
+#ifndef atomic_load_ptr
+/// @brief Atomically loads a pointer. (acquire)
+#   define atomic_load_ptr(ptr) InterlockedCompareExchangePointer((PVOID volatile *)(ptr), NULL, NULL)
+#endif // atomic_load_ptr
+
+#ifndef atomic_store_ptr
+/// @brief Atomically stores a pointer. (release)
+#   define atomic_store_ptr(ptr, value) ((void)InterlockedExchangePointer((PVOID volatile *)(ptr), (PVOID)(value)))
+#endif // atomic_store_ptr
+
+#ifndef atomic_xchg_ptr
+/// @brief Atomically replaces a pointer, returns the old one.
+#   define atomic_xchg_ptr(ptr, value) InterlockedExchangePointer((PVOID volatile *)(ptr), (PVOID)(value))
+#endif // atomic_xchg_ptr
+
+#ifndef atomic_cas_ptr
+/// @brief Atomically replaces a pointer if it still equals the
+///        expected one, returns TRUE on success.
+#   define atomic_cas_ptr(ptr, expected, value) \
+    (InterlockedCompareExchangePointer((PVOID volatile *)(ptr), (PVOID)(value), (PVOID)(expected)) == (PVOID)(expected))
+#endif // atomic_cas_ptr
+
+#ifndef atomic_load_size
+/// @brief Atomically loads a size. (acquire)
+#   define atomic_load_size(ptr) ((size_t)InterlockedCompareExchangePointer((PVOID volatile *)(ptr), NULL, NULL))
+#endif // atomic_load_size
+
+#ifndef atomic_store_size
+/// @brief Atomically stores a size. (release)
+#   define atomic_store_size(ptr, value) ((void)InterlockedExchangePointer((PVOID volatile *)(ptr), (PVOID)(size_t)(value)))
+#endif // atomic_store_size
+
+#ifndef atomic_add_size
+/// @brief Atomically adds to a size, returns the new value.
+#   define atomic_add_size(ptr, value) ((size_t)InterlockedExchangeAddSizeT((ptr), (value)) + (value))
+#endif // atomic_add_size
+
+#ifndef atomic_cas_size
+/// @brief Atomically replaces a size if it still equals the
+///        expected one, returns TRUE on success.
+#   define atomic_cas_size(ptr, expected, value) \
+    (InterlockedCompareExchangePointer((PVOID volatile *)(ptr), (PVOID)(size_t)(value), (PVOID)(size_t)(expected)) == (PVOID)(size_t)(expected))
+#endif // atomic_cas_size
+
+#else
+
+#ifndef atomic_load_ptr
+/// @brief Atomically loads a pointer. (acquire)
+#   define atomic_load_ptr(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#endif // atomic_load_ptr
+
+#ifndef atomic_store_ptr
+/// @brief Atomically stores a pointer. (release)
+#   define atomic_store_ptr(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#endif // atomic_store_ptr
+
+#ifndef atomic_xchg_ptr
+/// @brief Atomically replaces a pointer, returns the old one.
+#   define atomic_xchg_ptr(ptr, value) __atomic_exchange_n((ptr), (value), __ATOMIC_ACQ_REL)
+#endif // atomic_xchg_ptr
+
+#ifndef atomic_cas_ptr
+/// @brief Atomically replaces a pointer if it still equals the
+///        expected one, returns TRUE on success.
+#   define atomic_cas_ptr(ptr, expected, value) \
+    __sync_bool_compare_and_swap((ptr), (expected), (value))
+#endif // atomic_cas_ptr
+
+#ifndef atomic_load_size
+/// @brief Atomically loads a size. (acquire)
+#   define atomic_load_size(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#endif // atomic_load_size
+
+#ifndef atomic_store_size
+/// @brief Atomically stores a size. (release)
+#   define atomic_store_size(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#endif // atomic_store_size
+
+#ifndef atomic_add_size
+/// @brief Atomically adds to a size, returns the new value.
+#   define atomic_add_size(ptr, value) __atomic_add_fetch((ptr), (value), __ATOMIC_RELAXED)
+#endif // atomic_add_size
+
+#ifndef atomic_cas_size
+/// @brief Atomically replaces a size if it still equals the
+///        expected one, returns TRUE on success.
+#   define atomic_cas_size(ptr, expected, value) \
+    __sync_bool_compare_and_swap((ptr), (expected), (value))
+#endif // atomic_cas_size
+
+#endif // _MSC_VER
+
+// Threads
+
+/// @brief Thread entry point.
+typedef void *(*thread_func_t)(void *arg);
+
+/// @brief Thread handle.
+typedef struct _thread
+{
+#ifdef _WIN32
+    /// @brief System handle.
+    HANDLE handle;
+#else
+    /// @brief System handle.
+    pthread_t handle;
+#endif // _WIN32
+    /// @brief Entry point.
+    thread_func_t func;
+    /// @brief Argument of the entry point.
+    void *arg;
+    /// @brief Value returned by the entry point.
+    void *result;
+} thread_t;
+
+/// @brief Starts a new thread.
+/// @param thread Handle of the thread, must stay valid until
+///               the thread is joined.
+/// @param func Entry point.
+/// @param arg Argument of the entry point.
+/// @return TRUE if the thread was started.
+bool_t _CDECL thread_start(thread_t *const thread, thread_func_t func, void *arg);
+/// @brief Waits the end of a thread.
+/// @param thread Handle of the thread.
+/// @return The value returned by the entry point.
+void *_CDECL thread_join(thread_t *const thread);
+/// @brief Gives up the processor to another thread.
+void _CDECL thread_yield();
+/// @brief Gets the number of online processors.
+/// @return The number of processors (at least one).
+unsigned int _CDECL thread_cpus();
+
+/* =------------------------------------------------------------= */
+
+CALC_C_HEADER_END
+
+#endif // CALC_BASE_STDTHRD_H_
@@ -5,4 +5,76 @@
 #ifndef CALC_LEX_LEXER_H_
 #define CALC_LEX_LEXER_H_
 
+#include "calc/lex/scanner.h"
+#include "calc/lex/source.h"
+
+CALC_C_HEADER_BEGIN
+
+/* =---- Lexer Header ------------------------------------------= */
+
+/// @brief Splits a whole text into its tokens.
+/// @param text Text to split.
+/// @param len Length of the text, at most CALC_SRCLOC_MAX.
+/// @param tokens Stream to which append the tokens, the last one is
+///               TOK_EOF.
+/// @return The number of tokens appended, 0 if the text is too long.
+size_t _CDECL lex_text(const char *const text, size_t len, tokstream_t *const tokens);
+/// @brief Splits a whole text into its tokens on several threads:
+///        the text is cut in chunks at new lines, each thread lexes
+///        one and the tokens are joined where the scans meet (a chunk
+///        cut in a comment or in a literal is scanned again from the
+///        end of the previous one). The tokens are the same of
+///        lex_text.
+/// @param text Text to split.
+/// @param len Length of the text, at most CALC_SRCLOC_MAX.
+/// @param tokens Stream to which append the tokens, the last one is
+///               TOK_EOF.
+/// @param threads Number of threads, 0 for one for each processor.
+///                The chunks are at least 1 MiB long, a smaller text
+///                is lexed by the calling thread.
+/// @return The number of tokens appended, 0 if the text is too long.
+size_t _CDECL lex_text_parallel(const char *const text, size_t len, tokstream_t *const tokens, unsigned int threads);
+
+// Incremental Lexing
+
+/// @brief Tokens of a stream changed by an edit of its text.
+typedef struct _lexedit
+{
+    /// @brief Index of the first token changed.
+    size_t index;
+    /// @brief Number of tokens removed from the index.
+    size_t removed;
+    /// @brief Number of tokens inserted at the index.
+    size_t inserted;
+} lexedit_t;
+
+/// @brief Updates the tokens of a text after an edit, as lex_text
+///        would split the new text. Only the tokens around the edit
+///        are scanned again: from the end of the last token before
+///        it that is followed by a blank (the automaton does not
+///        read past it) until a token ends where an old token after
+///        the edit ended. The offsets of the tokens after them are
+///        shifted lazily (see tokstream_offset).
+/// @param tokens Tokens of the text before the edit.
+/// @param text Text after the edit.
+/// @param len Length of the text after the edit, at most
+///            CALC_SRCLOC_MAX.
+/// @param offset Offset of the edit.
+/// @param removed Number of chars removed at the offset.
+/// @param inserted Number of chars inserted at the offset.
+/// @param edit Output of the tokens changed.
+/// @return The tokens changed, NULL if the text is too long.
+lexedit_t *_CDECL lex_edit(tokstream_t *const tokens, const char *const text, size_t len,
+                           size_t offset, size_t removed, size_t inserted, lexedit_t *const edit);
+
+#ifndef lex_source
+/// @brief Splits the text of a source into its tokens (see
+///        lex_text).
+#   define lex_source(src, tokens) lex_text((src)->text, (src)->len, (tokens))
+#endif // lex_source
+
+/* =------------------------------------------------------------= */
+
+CALC_C_HEADER_END
+
 #endif // CALC_LEX_LEXER_H_
@@ -0,0 +1,81 @@
+#pragma once
+
+/* literal.h - Copyright (c) 2024 Frithurik Grint */
+
+#ifndef CALC_LEX_LITERAL_H_
+#define CALC_LEX_LITERAL_H_
+
+#include "calc/lex/tokens.h"
+
+CALC_C_HEADER_BEGIN
+
+/* =---- Literals Header ---------------------------------------= */
+
+/// @brief Result of the decoding of a literal.
+typedef enum _lit_status
+{
+    /// @brief The literal was decoded.
+    LIT_OK,
+    /// @brief The text is not a literal of the kind.
+    LIT_MALFORMED,
+    /// @brief An integer does not fit in 64 bits (the value is
+    ///        UINT64_MAX), or a real is too large for a double (the
+    ///        value is infinite).
+    LIT_OVERFLOW
+} lit_status_t;
+
+/// @brief Value of a numeric literal.
+typedef struct _litval
+{
+    /// @brief Kind of the token of the literal, TOK_LIT_REAL for a
+    ///        real.
+    tok_kind_t kind;
+    /// @brief Value, by kind.
+    union
+    {
+        uint64_t u;
+        double r;
+    } as;
+} litval_t;
+
+/// @brief Decodes an integer literal, with no sign: the decimal
+///        digits, or one or more zeros, a radix letter (b, c, d or
+///        x, either case) and the digits. The digits are converted
+///        8 at a time.
+/// @param str Text of the literal.
+/// @param len Length of the text.
+/// @param value Output of the value.
+/// @return LIT_OK, or the reason of the failure.
+lit_status_t _CDECL lit_int(const char *const str, size_t len, uint64_t *const value);
+/// @brief Decodes a real literal, digits '.' digits and an optional
+///        exponent, to the nearest double (ties to even). Up to 19
+///        significant digits are converted with a 128 bits product
+///        by a power of five (see scripts/GenPowerTable.py), the
+///        longer ones fall back to strv_tof when the rounding is
+///        not decided by the first 19 (it needs the C locale).
+/// @param str Text of the literal.
+/// @param len Length of the text.
+/// @param value Output of the value.
+/// @return LIT_OK, or the reason of the failure.
+lit_status_t _CDECL lit_real(const char *const str, size_t len, double *const value);
+/// @brief Decodes the numeric literal of a token of a stream. The
+///        stream keeps only the spans: a literal is decoded when it
+///        is used, from the text.
+/// @param tokens Stream of the token.
+/// @param text Text of the source of the stream.
+/// @param index Index of the token.
+/// @param value Output of the value.
+/// @return LIT_OK, or the reason of the failure (LIT_MALFORMED if the
+///         token is not a number).
+lit_status_t _CDECL lit_decode(const tokstream_t *const tokens, const char *const text, size_t index,
+                               litval_t *const value);
+/// @brief Gets the description of a literal status.
+/// @param status Status to describe.
+/// @return The description.
+const char *_CDECL lit_strerror(lit_status_t status);
+
+/* =------------------------------------------------------------= */
+
+CALC_C_HEADER_END
+
+#endif // CALC_LEX_LITERAL_H_
@@ -5,4 +5,65 @@
 #ifndef CALC_LEX_SCANNER_H_
 #define CALC_LEX_SCANNER_H_
 
+#include "calc/lex/tokens.h"
+
+CALC_C_HEADER_BEGIN
+
+/* =---- Scanner Header ----------------------------------------= */
+
+/// @brief Scanner of a source text: a deterministic automaton
+///        generated from the token list (see tokens.inc) splits
+///        the text in tokens, skipping the blanks and the comments.
+typedef struct _scanner
+{
+    /// @brief Text to scan.
+    const char *text;
+    /// @brief Position of the next token.
+    const char *ptr;
+    /// @brief End of the text.
+    const char *end;
+} scanner_t;
+
+#ifndef scanner_offset
+/// @brief Gets the offset of the next token.
+#   define scanner_offset(scanner) ((size_t)((scanner)->ptr - (scanner)->text))
+#endif // scanner_offset
+
+/// @brief Initializes a scanner.
+/// @param scanner Scanner to initialize.
+/// @param text Text to scan.
+/// @param len Length of the text.
+/// @return The initialized scanner.
+scanner_t *_CDECL scanner_init(scanner_t *const scanner, const char *const text, size_t len);
+/// @brief Scans the next token. The malformed ones are returned as
+///        error tokens (see tok_iserror) and the scan goes on.
+/// @param scanner Scanner to advance.
+/// @param token Output of the token.
+/// @return The kind of the token, TOK_EOF at the end of the text
+///         (and after it).
+tok_kind_t _CDECL scanner_next(scanner_t *const scanner, token_t *const token);
+/// @brief Scans the next tokens into an array, as a loop of
+///        scanner_next without a call for each token.
+/// @param scanner Scanner to advance.
+/// @param tokens Output of the tokens.
+/// @param max Capacity of the output.
+/// @return The number of tokens scanned, 0 at the end of the text.
+///         The TOK_EOF is not written.
+size_t _CDECL scanner_scan(scanner_t *const scanner, token_t *const tokens, size_t max);
+
+/// @brief Gets the instruction set selected for the skip loops of
+///        the scanner ("avx2", "sse2" or "scalar"), they go over the
+///        blanks, the comments and the identifiers.
+const char *_CDECL scanner_isa();
+/// @brief Selects the instruction set of the skip loops, to compare
+///        them (the best one is selected by default).
+/// @param isa Name of the instruction set (see scanner_isa).
+/// @return TRUE if the instruction set is supported, FALSE if the
+///         selection is unchanged.
+bool_t _CDECL scanner_setisa(const char *const isa);
+
+/* =------------------------------------------------------------= */
+
+CALC_C_HEADER_END
+
 #endif // CALC_LEX_SCANNER_H_
@@ -5,4 +5,232 @@
 #ifndef CALC_LEX_SOURCE_H_
 #define CALC_LEX_SOURCE_H_
 
+#include "calc/base/stdin.h"
+#include "calc/base/stdtab.h"
+
+CALC_C_HEADER_BEGIN
+
+/* =---- Sources Header ----------------------------------------= */
+
+#ifndef CALC_SRC_PAD
+/// @brief Number of zero bytes guaranteed after the end of a
+///        source, so the scanner can read a whole vector past
+///        any position without checking the bounds.
+#   define CALC_SRC_PAD 64
+#endif // CALC_SRC_PAD
+
+#ifndef CALC_SRC_MAPMIN
+/// @brief Minimum size of a file to map it, smaller files are
+///        cheaper to read.
+#   define CALC_SRC_MAPMIN 0x10000
+#endif // CALC_SRC_MAPMIN
+
+#ifndef CALC_SRC_CHUNK
+/// @brief Size of the reads of a source that cannot be mapped.
+#   define CALC_SRC_CHUNK 0x10000
+#endif // CALC_SRC_CHUNK
+
+/// @brief Text of a source file: regular files are mapped
+///        read-only (POSIX), pipes and the standard input are read
+///        into the heap. Tokens reference the text directly, it is
+///        valid until the source is closed.
+/// @note A mapped file must not be truncated while it is open.
+typedef struct _source
+{
+    /// @brief Name of the source, for the diagnostics.
+    char *name;
+    /// @brief Text of the source, followed by CALC_SRC_PAD zero
+    ///        bytes.
+    const char *text;
+    /// @brief Length of the text.
+    size_t len;
+    /// @brief Mapping of the file, or NULL if the text is in the
+    ///        heap.
+    void *map;
+    /// @brief Size of the mapping, including the padding.
+    size_t mapsiz;
+} source_t;
+
+#ifndef source_ismapped
+/// @brief Checks if the text of a source is a file mapping.
+#   define source_ismapped(src) ((src)->map != NULL)
+#endif // source_ismapped
+
+#ifndef source_view
+/// @brief Gets a view of a part of the text of a source.
+#   define source_view(src, offset, len) strv((src)->text + (offset), (len))
+#endif // source_view
+
+/// @brief Opens a source file, mapping it if it is a regular file
+///        large enough.
+/// @param src Source to initialize.
+/// @param path Path of the file, NULL or "-" for the standard
+///             input.
+/// @return FALSE if the file cannot be opened or read, errno is
+///         set.
+bool_t _CDECL source_open(source_t *const src, const char *const path);
+/// @brief Reads a source from an open descriptor until its end,
+///        for pipes and terminals.
+/// @param src Source to initialize.
+/// @param fd Descriptor to read, it is not closed.
+/// @param name Name of the source.
+/// @return FALSE if a read fails, errno is set.
+bool_t _CDECL source_read(source_t *const src, int fd, const char *const name);
+/// @brief Makes a source of a copy of a string.
+/// @param src Source to initialize.
+/// @param name Name of the source.
+/// @param text Text of the source.
+/// @param len Length of the text.
+/// @return The initialized source.
+source_t *_CDECL source_string(source_t *const src, const char *const name, const char *const text, size_t len);
+/// @brief Closes a source, unmapping or freeing its text.
+/// @param src Source to close.
+void _CDECL source_close(source_t *const src);
+
+// Source Manager
+
+/// @brief Location in the sources of a manager: an offset in the
+///        concatenation of all its files, zero for no location.
+typedef uint32_t srcloc_t;
+
+#ifndef CALC_SRCLOC_MAX
+/// @brief Maximum total size of the sources of a manager.
+#   define CALC_SRCLOC_MAX UINT32_MAX
+#endif // CALC_SRCLOC_MAX
+
+/// @brief File of a source manager.
+typedef struct _srcfile
+{
+    /// @brief Text of the file.
+    source_t src;
+    /// @brief Location of the first char, the following ones are
+    ///        consecutive up to one past the last.
+    srcloc_t base;
+    /// @brief Offset of the start of each line, NULL until the
+    ///        first location of the file is decoded.
+    uint32_t *lines;
+    /// @brief Number of lines.
+    size_t nlines;
+} srcfile_t;
+
+/// @brief Decoded location.
+typedef struct _srcpos
+{
+    /// @brief File of the location.
+    const srcfile_t *file;
+    /// @brief Line, from one.
+    uint32_t line;
+    /// @brief Column in chars (UTF-8), from one.
+    uint32_t col;
+} srcpos_t;
+
+/// @brief Owner of the source files of a compilation, the main
+///        ones and the modules they use: it gives each char a 32
+///        bits location, decoded in file, line and column only for
+///        the diagnostics.
+typedef struct _srcmgr
+{
+    /// @brief Files, in the order of their locations (srcfile_t *).
+    buf_t files;
+    /// @brief Files by name (strv_t, srcfile_t *).
+    tab_t names;
+    /// @brief Location of the next file.
+    srcloc_t next;
+} srcmgr_t;
+
+#ifndef srcfile_loc
+/// @brief Gets the location of an offset in a file.
+#   define srcfile_loc(file, offset) ((srcloc_t)((file)->base + (offset)))
+#endif // srcfile_loc
+
+#ifndef srcmgr_count
+/// @brief Gets the number of files of a manager.
+#   define srcmgr_count(mgr) buf_count(&(mgr)->files, srcfile_t *)
+#endif // srcmgr_count
+
+/// @brief Initializes an empty source manager.
+/// @param mgr Manager to initialize.
+/// @return The initialized manager.
+srcmgr_t *_CDECL srcmgr_init(srcmgr_t *const mgr);
+/// @brief Releases a source manager, closing its files.
+/// @param mgr Manager to release.
+void _CDECL srcmgr_release(srcmgr_t *const mgr);
+
+/// @brief Loads a file, once: a module used by several files is
+///        loaded by the first one.
+/// @param mgr Source manager.
+/// @param path Path of the file (see source_open).
+/// @return The file, or NULL if it cannot be read or the locations
+///         are exhausted (EFBIG), errno is set.
+srcfile_t *_CDECL srcmgr_load(srcmgr_t *const mgr, const char *const path);
+/// @brief Adds an open source, the manager takes its ownership.
+/// @param mgr Source manager.
+/// @param src Source to add.
+/// @return The file, or NULL if the locations are exhausted.
+srcfile_t *_CDECL srcmgr_add(srcmgr_t *const mgr, const source_t *const src);
+/// @brief Finds the file of a location.
+/// @param mgr Source manager.
+/// @param loc Location to find.
+/// @return The file, or NULL if the location is not valid.
+srcfile_t *_CDECL srcmgr_file(const srcmgr_t *const mgr, srcloc_t loc);
+/// @brief Decodes a location, building the line table of its file
+///        the first time.
+/// @param mgr Source manager.
+/// @param loc Location to decode.
+/// @param pos Output of the file, line and column.
+/// @return FALSE if the location is not valid.
+bool_t _CDECL srcmgr_decode(const srcmgr_t *const mgr, srcloc_t loc, srcpos_t *const pos);
+
+// Streaming Sources
+
+/// @brief Source read from an unbounded stream, split into its top
+///        level statements as they complete: a statement ends with
+///        a semicolon or a closing brace out of any bracket,
+///        string, char or comment. Only the pending statement and
+///        the last chunk are in memory.
+typedef struct _srcstream
+{
+    /// @brief Reader of the stream.
+    reader_t reader;
+    /// @brief Number of bytes of the pending statement already
+    ///        split.
+    size_t scan;
+    /// @brief Nesting of the brackets at the split position.
+    size_t depth;
+    /// @brief Lexical state at the split position.
+    int state;
+    /// @brief Set if the pending statement has some code, not only
+    ///        blanks and comments.
+    bool_t code;
+} srcstream_t;
+
+#ifndef srcstream_offset
+/// @brief Gets the offset in the stream of the pending statement.
+#   define srcstream_offset(stream) ((stream)->reader.offset + (stream)->reader.pos)
+#endif // srcstream_offset
+
+/// @brief Initializes a streaming source.
+/// @param stream Source to initialize.
+/// @param fd Descriptor of the stream, it is not closed.
+/// @param chunk Size of a read, zero for the default.
+/// @param tie Writer to flush before waiting for input, or NULL.
+/// @return The initialized source.
+srcstream_t *_CDECL srcstream_init(srcstream_t *const stream, int fd, size_t chunk, writer_t *const tie);
+/// @brief Releases a streaming source.
+/// @param stream Source to release.
+void _CDECL srcstream_release(srcstream_t *const stream);
+/// @brief Gets the next complete statement, reading as needed. A
+///        statement left open by the end of the stream is returned
+///        as it is.
+/// @param stream Source to read.
+/// @param stmt Output of the statement, valid until the next
+///             call.
+/// @return FALSE at the end of the stream or on a read error (see
+///         reader.error).
+bool_t _CDECL srcstream_next(srcstream_t *const stream, strv_t *const stmt);
+
+/* =------------------------------------------------------------= */
+
+CALC_C_HEADER_END
+
 #endif // CALC_LEX_SOURCE_H_
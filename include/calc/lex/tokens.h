@@ -5,4 +5,151 @@
 #ifndef CALC_LEX_TOKENS_H_
 #define CALC_LEX_TOKENS_H_
 
+#include "calc/base/stdstr.h"
+
+CALC_C_HEADER_BEGIN
+
+/* =---- Tokens Header -----------------------------------------= */
+
+/// @brief Kind of a token.
+typedef enum _tok_kind
+{
+    /// @brief Identifier, not reserved.
+    TOK_IDENT,
+
+#define KEYWORD(name, text) TOK_KW_##name,
+#include "calc/lex/tokens.inc"
+
+#define TOKEN(name, text) TOK_##name,
+#include "calc/lex/tokens.inc"
+
+#define PUNCT(name, text) TOK_##name,
+#include "calc/lex/tokens.inc"
+
+    /// @brief Number of token kinds.
+    TOK_COUNT
+} tok_kind_t;
+
+#ifndef tok_iskeyword
+/// @brief Checks if a token is a keyword, the keywords follow the
+///        identifiers.
+#   define tok_iskeyword(kind) ((kind) > TOK_IDENT && (kind) < TOK_EOF)
+#endif // tok_iskeyword
+
+#ifndef tok_iserror
+/// @brief Checks if a token is an error.
+#   define tok_iserror(kind) ((kind) >= TOK_ERR_CHAR && (kind) <= TOK_ERR_STRING)
+#endif // tok_iserror
+
+/// @brief Token of a source.
+typedef struct _token
+{
+    /// @brief Kind of the token.
+    tok_kind_t kind;
+    /// @brief Offset of the first char in the source.
+    size_t offset;
+    /// @brief Length of the text.
+    size_t len;
+} token_t;
+
+// Token Streams
+
+/// @brief Stream of the tokens of a source, as parallel arrays of 9
+///        bytes per token (a token_t takes 24): the parser walks it
+///        by index and a lookahead of a few kinds stays in a cache
+///        line. The offsets fit 32 bits as the source locations (see
+///        CALC_SRCLOC_MAX). After an edit (see lex_edit) the offsets
+///        of the tokens past it are shifted lazily: the stored ones
+///        are read with tokstream_offset.
+typedef struct _tokstream
+{
+    /// @brief Kind of each token (a tok_kind_t).
+    byte_t *kinds;
+    /// @brief Offset of each token in the source, before the pending
+    ///        shift.
+    uint32_t *offsets;
+    /// @brief Length of each token.
+    uint32_t *lens;
+    /// @brief Number of tokens.
+    size_t count;
+    /// @brief Number of tokens the arrays can hold.
+    size_t cap;
+    /// @brief Index of the first token whose offset is shifted.
+    size_t shifted;
+    /// @brief Pending shift of the offsets from shifted on, added
+    ///        modulo 2^32 (0 if none).
+    uint32_t shift;
+} tokstream_t;
+
+#ifndef tokstream_kind
+/// @brief Gets the kind of a token of a stream.
+#   define tokstream_kind(stream, index) ((tok_kind_t)(stream)->kinds[index])
+#endif // tokstream_kind
+
+#ifndef tokstream_offset
+/// @brief Gets the offset of a token of a stream in its source.
+#   define tokstream_offset(stream, index) \
+        ((size_t)(uint32_t)((stream)->offsets[index] + ((index) >= (stream)->shifted ? (stream)->shift : 0)))
+#endif // tokstream_offset
+
+#ifndef tokstream_end
+/// @brief Gets the offset of the end of a token of a stream.
+#   define tokstream_end(stream, index) (tokstream_offset(stream, index) + (stream)->lens[index])
+#endif // tokstream_end
+
+#ifndef tokstream_view
+/// @brief Gets the text of a token of a stream, from the text of its
+///        source.
+#   define tokstream_view(stream, text, index) \
+        strv((text) + tokstream_offset(stream, index), (stream)->lens[index])
+#endif // tokstream_view
+
+/// @brief Initializes an empty token stream.
+/// @param stream Stream to initialize.
+/// @return The initialized stream.
+tokstream_t *_CDECL tokstream_init(tokstream_t *const stream);
+/// @brief Releases the arrays of a token stream, leaving it empty.
+/// @param stream Stream to release.
+void _CDECL tokstream_release(tokstream_t *const stream);
+/// @brief Makes room in a token stream for at least the specified
+///        number of tokens.
+/// @param stream Stream to grow.
+/// @param cap Total number of tokens requested.
+void _CDECL tokstream_reserve(tokstream_t *const stream, size_t cap);
+/// @brief Applies the pending shift to the offsets of a stream.
+/// @param stream Stream to update.
+void _CDECL tokstream_settle(tokstream_t *const stream);
+/// @brief Appends a token to a stream.
+/// @param stream Stream to extend.
+/// @param token Token to append, its offset and length must fit 32
+///              bits.
+void _CDECL tokstream_push(tokstream_t *const stream, const token_t *const token);
+/// @brief Gets a token of a stream.
+/// @param stream Stream of the token.
+/// @param index Index of the token.
+/// @param token Output of the token.
+/// @return The token.
+token_t *_CDECL tokstream_get(const tokstream_t *const stream, size_t index, token_t *const token);
+
+/// @brief Classifies an identifier as a keyword, with one hash
+///        and one compare (see scripts/GenKeywordHash.py).
+/// @param str Text of the identifier.
+/// @param len Length of the identifier.
+/// @return The kind of the keyword, or TOK_IDENT.
+tok_kind_t _CDECL tok_keyword(const char *const str, size_t len);
+/// @brief Gets the text of a keyword.
+/// @param kind Kind of the keyword.
+/// @return The text, or an empty view if it is not a keyword.
+strv_t _CDECL tok_kwtext(tok_kind_t kind);
+/// @brief Gets the text of a token kind for the diagnostics: the
+///        spelling of the keywords and the punctuators, a
+///        description of the others.
+/// @param kind Kind of the token.
+/// @return The text, NUL terminated.
+const char *_CDECL tok_text(tok_kind_t kind);
+
+/* =------------------------------------------------------------= */
+
+CALC_C_HEADER_END
+
 #endif // CALC_LEX_TOKENS_H_
@@ -5,4 +5,63 @@
 #ifndef CALC_PARSE_EVAL_H_
 #define CALC_PARSE_EVAL_H_
 
+#include "calc/base/stdstr.h"
+
+CALC_C_HEADER_BEGIN
+
+/* =---- Evaluator Header --------------------------------------= */
+
+/// @brief Kind of a value.
+typedef enum _eval_kind
+{
+    /// @brief 64 bits signed integer.
+    EVAL_INT,
+    /// @brief Double precision real.
+    EVAL_REAL
+} eval_kind_t;
+
+/// @brief Value of an expression.
+typedef struct _eval_value
+{
+    /// @brief Kind of the value.
+    eval_kind_t kind;
+    /// @brief Value, by kind.
+    union
+    {
+        int64_t i;
+        double r;
+    } as;
+} eval_value_t;
+
+/// @brief Result of an evaluation.
+typedef enum _eval_status
+{
+    /// @brief The expression was evaluated.
+    EVAL_OK,
+    /// @brief The expression is malformed.
+    EVAL_SYNTAX,
+    /// @brief The statement is not a constant expression.
+    EVAL_UNSUPPORTED,
+    /// @brief An integer division by zero.
+    EVAL_DIVZERO,
+    /// @brief An integer does not fit in 64 bits.
+    EVAL_OVERFLOW
+} eval_status_t;
+
+/// @brief Evaluates a constant arithmetic expression statement
+///        (integer and real literals, + - * / %, parentheses),
+///        optionally ended by a semicolon.
+/// @param text Text of the statement.
+/// @param value Output of the value.
+/// @return EVAL_OK, or the reason of the failure.
+eval_status_t _CDECL eval_expr(strv_t text, eval_value_t *const value);
+/// @brief Gets the description of an evaluation status.
+/// @param status Status to describe.
+/// @return The description.
+const char *_CDECL eval_strerror(eval_status_t status);
+
+/* =------------------------------------------------------------= */
+
+CALC_C_HEADER_END
+
 #endif // CALC_PARSE_EVAL_H_
@@ -0,0 +1,354 @@
+#include "calc/base/stdbuf.h"
+#include "calc/base/stdthrd.h"
+
+#include <stdio.h>
+
+#if _CALC_SSE2
+#   include <emmintrin.h>
+#endif // _CALC_SSE2
+
+/* =---- Buffers -----------------------------------------------= */
+
+// +---- Internal (Buffers) ------------------------------------+
+
+#pragma region Internal (Buffers)
+
+static inline void _buf_reset(buf_t *const buf)
+{
+    buf->data = buf->small.bytes;
+    buf->len = 0;
+    buf->cap = CALC_BUF_INLINE;
+}
+
+/* moves the contents in a block of the specified capacity */
+static void _buf_resize(buf_t *const buf, size_t cap)
+{
+    byte_t *data;
+
+    if (buf->arena)
+    {
+        arena_t *const arena = buf->arena;
+
+        cap = alignto(cap, CALC_ARENA_ALIGN);
+
+        /* the last block of the arena can grow in place */
+        if (!_buf_inline(buf) && buf->data + buf->cap == arena->ptr &&
+            cap - buf->cap <= (size_t)(arena->end - arena->ptr))
+        {
+            arena->ptr += cap - buf->cap;
+            buf->cap = cap;
+
+            return;
+        }
+
+        data = (byte_t *)arena_malloc(arena, cap);
+        memcpy(data, buf->data, buf->len);
+    }
+    else if (_buf_inline(buf))
+    {
+        data = (byte_t *)checked_malloc(cap);
+        memcpy(data, buf->data, buf->len);
+    }
+    else
+        data = (byte_t *)checked_realloc(buf->data, cap);
+
+    buf->data = data;
+    buf->cap = cap;
+}
+
+/* grows geometrically to hold at least the specified length */
+static inline void _buf_fit(buf_t *const buf, size_t len)
+{
+    size_t cap = buf->cap * 2;
+
+    if (cap < len)
+        cap = len;
+
+    if (cap < CALC_BUF_MIN)
+        cap = CALC_BUF_MIN;
+
+    _buf_resize(buf, cap);
+}
+
+#pragma endregion
+
+// +---- Internal (Buffers) --------------------------- END ----+
+
+buf_t *_CDECL buf_init(buf_t *const buf)
+{
+    _buf_reset(buf);
+    buf->arena = NULL;
+
+    return buf;
+}
+
+buf_t *_CDECL buf_init_arena(buf_t *const buf, arena_t *const arena)
+{
+    _buf_reset(buf);
+    buf->arena = arena;
+
+    return buf;
+}
+
+void _CDECL buf_release(buf_t *const buf)
+{
+    if (!buf->arena && !_buf_inline(buf))
+        checked_free(buf->data);
+
+    _buf_reset(buf);
+}
+
+void _CDECL buf_reserve(buf_t *const buf, size_t cap)
+{
+    if (cap > buf->cap)
+        _buf_resize(buf, cap);
+}
+
+void _CDECL buf_shrink(buf_t *const buf)
+{
+    byte_t *data = buf->data;
+
+    if (buf->arena || _buf_inline(buf) || buf->len == buf->cap)
+        return;
+
+    if (buf->len <= CALC_BUF_INLINE)
+    {
+        memcpy(buf->small.bytes, data, buf->len);
+        checked_free(data);
+
+        buf->data = buf->small.bytes;
+        buf->cap = CALC_BUF_INLINE;
+    }
+    else
+    {
+        buf->data = (byte_t *)checked_realloc(data, buf->len);
+        buf->cap = buf->len;
+    }
+}
+
+void *_CDECL _buf_grow(buf_t *const buf, size_t size)
+{
+    _buf_fit(buf, buf->len + size);
+
+    return buf->data + (buf->len += size) - size;
+}
+
+#if !_CALC_BUILD_INLINES
+
+void *_CDECL buf_extend(buf_t *const buf, size_t size)
+{
+    return (size <= buf->cap - buf->len)
+        ? (void *)(buf->data + (buf->len += size) - size)
+        : _buf_grow(buf, size);
+}
+
+void *_CDECL buf_append(buf_t *const buf, const void *const data, size_t size)
+{
+    return memcpy(buf_extend(buf, size), data, size);
+}
+
+#endif // _CALC_BUILD_INLINES
+
+int _CDECL buf_vprintf(buf_t *const buf, const char *const format, va_list arglist)
+{
+    size_t avail = buf->cap - buf->len;
+    va_list retry;
+    int r;
+
+    /* formats in place, the second attempt has the exact room */
+    va_copy(retry, arglist);
+    r = vsnprintf((char *)buf->data + buf->len, avail, format, arglist);
+
+    if (r >= 0 && (size_t)r >= avail)
+    {
+        _buf_fit(buf, buf->len + (size_t)r + 1);
+        r = vsnprintf((char *)buf->data + buf->len, (size_t)r + 1, format, retry);
+    }
+
+    va_end(retry);
+
+    if (r > 0)
+        buf->len += (size_t)r;
+
+    return r;
+}
+
+int _CDECL buf_printf(buf_t *const buf, const char *const format, ...)
+{
+    va_list arglist;
+    int r;
+
+    va_start(arglist, format);
+    r = buf_vprintf(buf, format, arglist);
+    va_end(arglist);
+
+    return r;
+}
+
+char *_CDECL buf_cstr(buf_t *const buf)
+{
+    *(char *)buf_extend(buf, 1) = '\0';
+    buf->len--;
+
+    return (char *)buf->data;
+}
+
+// Ring Buffers
+
+// +---- Internal (Ring Buffers) -------------------------------+
+
+#pragma region Internal (Ring Buffers)
+
+/// @brief Number of busy waits before yielding the processor.
+#define _RING_SPINS 64
+
+static void _ring_copy_in(ring_t *const ring, size_t index, const byte_t *src, size_t count)
+{
+    size_t off = index & ring->mask, first = ring->mask + 1 - off;
+
+    if (first > count)
+        first = count;
+
+    memcpy(ring->data + off * ring->size, src, first * ring->size);
+    memcpy(ring->data, src + first * ring->size, (count - first) * ring->size);
+}
+
+static void _ring_copy_out(const ring_t *const ring, size_t index, byte_t *dst, size_t count)
+{
+    size_t off = index & ring->mask, first = ring->mask + 1 - off;
+
+    if (first > count)
+        first = count;
+
+    memcpy(dst, ring->data + off * ring->size, first * ring->size);
+    memcpy(dst + first * ring->size, ring->data, (count - first) * ring->size);
+}
+
+static inline void _ring_backoff(unsigned int *const spins)
+{
+    if (++*spins < _RING_SPINS)
+    {
+#if _CALC_SSE2
+        _mm_pause();
+#endif // _CALC_SSE2
+    }
+    else
+        thread_yield();
+}
+
+#pragma endregion
+
+// +---- Internal (Ring Buffers) ---------------------- END ----+
+
+ring_t *_CDECL ring_init(ring_t *const ring, size_t size, size_t capacity)
+{
+    size_t cap = 2;
+
+    while (cap < capacity)
+        cap *= 2;
+
+    ring->data = (byte_t *)checked_line_malloc(cap * size);
+    ring->size = size;
+    ring->mask = cap - 1;
+    ring->head = ring->tail_cache = 0;
+    ring->tail = ring->head_cache = 0;
+    ring->closed = 0;
+
+    return ring;
+}
+
+void _CDECL ring_release(ring_t *const ring)
+{
+    checked_aligned_free(ring->data);
+
+    ring->data = NULL;
+}
+
+size_t _CDECL ring_push(ring_t *const ring, const void *const elems, size_t count)
+{
+    size_t head = ring->head, room = ring->mask + 1 - (head - ring->tail_cache);
+
+    /* the shared index is read only when the cached one is not enough */
+    if (room < count)
+    {
+        ring->tail_cache = atomic_load_size(&ring->tail);
+        room = ring->mask + 1 - (head - ring->tail_cache);
+    }
+
+    if (count > room)
+        count = room;
+
+    if (count)
+    {
+        _ring_copy_in(ring, head, (const byte_t *)elems, count);
+        atomic_store_size(&ring->head, head + count);
+    }
+
+    return count;
+}
+
+size_t _CDECL ring_pop(ring_t *const ring, void *const elems, size_t count)
+{
+    size_t tail = ring->tail, avail = ring->head_cache - tail;
+
+    if (avail < count)
+    {
+        ring->head_cache = atomic_load_size(&ring->head);
+        avail = ring->head_cache - tail;
+    }
+
+    if (count > avail)
+        count = avail;
+
+    if (count)
+    {
+        _ring_copy_out(ring, tail, (byte_t *)elems, count);
+        atomic_store_size(&ring->tail, tail + count);
+    }
+
+    return count;
+}
+
+void _CDECL ring_push_all(ring_t *const ring, const void *const elems, size_t count)
+{
+    const byte_t *p = (const byte_t *)elems;
+    unsigned int spins = 0;
+    size_t n;
+
+    while (count)
+    {
+        if ((n = ring_push(ring, p, count)) != 0)
+        {
+            p += n * ring->size;
+            count -= n;
+            spins = 0;
+        }
+        else
+            _ring_backoff(&spins);
+    }
+}
+
+size_t _CDECL ring_pop_wait(ring_t *const ring, void *const elems, size_t count)
+{
+    unsigned int spins = 0;
+    size_t n;
+
+    for (;;)
+    {
+        if ((n = ring_pop(ring, elems, count)) != 0)
+            return n;
+
+        /* the last elements can be pushed right before closing */
+        if (atomic_load_size(&ring->closed))
+            return ring_pop(ring, elems, count);
+
+        _ring_backoff(&spins);
+    }
+}
+
+void _CDECL ring_close(ring_t *const ring)
+{
+    atomic_store_size(&ring->closed, 1);
+}
+
+/* =------------------------------------------------------------= */
@@ -0,0 +1,545 @@
+#include "calc/base/stdch.h"
+#include "calc/base/stdthrd.h"
+
+#include <string.h>
+
+/* =---- Standard Characters -----------------------------------= */
+
+#define _NO 0
+#define _SP CH_SPACE
+#define _NL (CH_SPACE | CH_NEWLINE)
+#define _ID (CH_IDSTART | CH_IDCONT)
+#define _HX (CH_IDSTART | CH_IDCONT | CH_XDIGIT)
+#define _D2 (CH_IDCONT | CH_BDIGIT | CH_ODIGIT | CH_DIGIT | CH_XDIGIT)
+#define _D8 (CH_IDCONT | CH_ODIGIT | CH_DIGIT | CH_XDIGIT)
+#define _DD (CH_IDCONT | CH_DIGIT | CH_XDIGIT)
+#define _OP CH_OPER
+#define _PU CH_PUNCT
+#define _QT CH_QUOTE
+#define _U8 CH_UTF8
+
+const uint16_t _chtab[256] = {
+    /* 0_ */ _NO, _NO, _NO, _NO, _NO, _NO, _NO, _NO, _NO, _SP, _NL, _SP, _SP, _SP, _NO, _NO,
+    /* 1_ */ _NO, _NO, _NO, _NO, _NO, _NO, _NO, _NO, _NO, _NO, _NO, _NO, _NO, _NO, _NO, _NO,
+    /* 2_ */ _SP, _OP, _QT, _OP, _ID, _OP, _OP, _QT, _PU, _PU, _OP, _OP, _PU, _OP, _OP, _OP,
+    /* 3_ */ _D2, _D2, _D8, _D8, _D8, _D8, _D8, _D8, _DD, _DD, _OP, _PU, _OP, _OP, _OP, _OP,
+    /* 4_ */ _OP, _HX, _HX, _HX, _HX, _HX, _HX, _ID, _ID, _ID, _ID, _ID, _ID, _ID, _ID, _ID,
+    /* 5_ */ _ID, _ID, _ID, _ID, _ID, _ID, _ID, _ID, _ID, _ID, _ID, _PU, _NO, _PU, _OP, _ID,
+    /* 6_ */ _NO, _HX, _HX, _HX, _HX, _HX, _HX, _ID, _ID, _ID, _ID, _ID, _ID, _ID, _ID, _ID,
+    /* 7_ */ _ID, _ID, _ID, _ID, _ID, _ID, _ID, _ID, _ID, _ID, _ID, _PU, _OP, _PU, _OP, _NO,
+    /* 8_ */ _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8,
+    /* 9_ */ _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8,
+    /* A_ */ _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8,
+    /* B_ */ _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8,
+    /* C_ */ _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8,
+    /* D_ */ _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8,
+    /* E_ */ _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8,
+    /* F_ */ _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8, _U8
+};
+
+#undef _NO
+#undef _SP
+#undef _NL
+#undef _ID
+#undef _HX
+#undef _D2
+#undef _D8
+#undef _DD
+#undef _OP
+#undef _PU
+#undef _QT
+#undef _U8
+
+const byte_t _chval[256] = {
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 36, 36, 36, 36, 36, 36,
+    36, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24,
+    25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 36, 36, 36, 36,
+    36, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24,
+    25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 36, 36, 36, 36,
+    /* no digit over 0x7F */
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36
+};
+
+// +---- Internal (Scalar) -------------------------------------+
+
+#pragma region Internal (Scalar)
+
+#define _ASCII_MASK UINT64_C(0x8080808080808080)
+
+/* smallest code point of each sequence length, shorter forms are
+   overlong */
+static const uint32_t _utf8_min[UTF8_MAXLEN + 1] = {0, 0, 0x80, 0x800, 0x10000};
+
+/* eight bytes at a time (SWAR) */
+static size_t _scalar_ascii(const char *const str, size_t len)
+{
+    const byte_t *const p = (const byte_t *)str;
+    uint64_t word;
+    size_t i;
+
+    for (i = 0; i + 8 <= len; i += 8)
+    {
+        memcpy(&word, p + i, sizeof(word));
+
+        if (word & _ASCII_MASK)
+            break;
+    }
+
+    while (i < len && p[i] < 0x80)
+        i++;
+
+    return i;
+}
+
+/* skips the ASCII runs with the given function and decodes each
+   sequence in between, the scanner's input is mostly ASCII */
+static size_t _mixed_check(const char *const str, size_t len, size_t (*ascii)(const char *const, size_t))
+{
+    size_t i = 0, n;
+    uint32_t cp;
+
+    while ((i += ascii(str + i, len - i)) < len)
+    {
+        if (!(n = utf8_decode(str + i, len - i, &cp)))
+            return i;
+
+        i += n;
+    }
+
+    return len;
+}
+
+static size_t _scalar_check(const char *const str, size_t len)
+{
+    return _mixed_check(str, len, _scalar_ascii);
+}
+
+#pragma endregion
+
+// +---- Internal (Scalar) ---------------------------- END ----+
+
+#if _CALC_SSE2
+
+#include <emmintrin.h>
+
+// +---- Internal (SSE2) ---------------------------------------+
+
+#pragma region Internal (SSE2)
+
+#define _sse2_load(p) _mm_loadu_si128((const __m128i *)(p))
+
+static size_t _sse2_ascii(const char *const str, size_t len)
+{
+    size_t i;
+    int mask;
+
+    for (i = 0; i + 16 <= len; i += 16)
+        if ((mask = _mm_movemask_epi8(_sse2_load(str + i))) != 0)
+            return i + _ctz32(mask);
+
+    return i + _scalar_ascii(str + i, len - i);
+}
+
+static size_t _sse2_check(const char *const str, size_t len)
+{
+    return _mixed_check(str, len, _sse2_ascii);
+}
+
+#pragma endregion
+
+// +---- Internal (SSE2) ------------------------------ END ----+
+
+#endif // _CALC_SSE2
+
+#if _CALC_AVX2
+
+#include <immintrin.h>
+
+// +---- Internal (AVX2) ---------------------------------------+
+
+#pragma region Internal (AVX2)
+
+/* the lookup validator of Keiser and Lemire: the high nibble of
+   the previous byte, its low nibble and the high nibble of the
+   byte select three masks of the errors the pair can be part of,
+   any bit left by their intersection is an error. Only the third
+   and fourth bytes of the long sequences need a second check */
+
+#define _TOO_SHORT 0x01      /* 11______ 0_______, 11______ 11______ */
+#define _TOO_LONG 0x02       /* 0_______ 10______ */
+#define _OVERLONG_3 0x04     /* 11100000 100_____ */
+#define _TOO_LARGE 0x08      /* 11110100 1001____, 11110101+ 10______ */
+#define _SURROGATE 0x10      /* 11101101 101_____ */
+#define _OVERLONG_2 0x20     /* 1100000_ 10______ */
+#define _TOO_LARGE_1000 0x40 /* 11110101+ 1000____ */
+#define _OVERLONG_4 0x40     /* 11110000 1000____ */
+#define _TWO_CONTS 0x80      /* 10______ 10______ */
+#define _CARRY (_TOO_SHORT | _TOO_LONG | _TWO_CONTS)
+
+#define _avx2_load(p) _mm256_loadu_si256((const __m256i *)(p))
+
+/* a 16 entries table in both lanes, for _mm256_shuffle_epi8 */
+#define _avx2_table(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p) \
+    _mm256_setr_epi8((char)(a), (char)(b), (char)(c), (char)(d), (char)(e), (char)(f), (char)(g), (char)(h), \
+                     (char)(i), (char)(j), (char)(k), (char)(l), (char)(m), (char)(n), (char)(o), (char)(p), \
+                     (char)(a), (char)(b), (char)(c), (char)(d), (char)(e), (char)(f), (char)(g), (char)(h), \
+                     (char)(i), (char)(j), (char)(k), (char)(l), (char)(m), (char)(n), (char)(o), (char)(p))
+
+/* the bytes of input shifted right by n, the first ones from the
+   end of the previous block */
+#define _avx2_prev(input, prev, n) \
+    _mm256_alignr_epi8((input), _mm256_permute2x128_si256((prev), (input), 0x21), 16 - (n))
+
+#define _avx2_high(v, low) _mm256_and_si256(_mm256_srli_epi16((v), 4), (low))
+
+static _TARGET("avx2") size_t _avx2_ascii(const char *const str, size_t len)
+{
+    size_t i;
+    int mask;
+
+    for (i = 0; i + 32 <= len; i += 32)
+        if ((mask = _mm256_movemask_epi8(_avx2_load(str + i))) != 0)
+            return i + _ctz32((unsigned int)mask);
+
+    return i + _scalar_ascii(str + i, len - i);
+}
+
+/* finds the first error from a block that passed the check, all
+   the chars starting before it are valid */
+static size_t _avx2_rescan(const char *const str, size_t len, size_t block)
+{
+    size_t start = (block >= 32) ? block - 32 : 0, back;
+
+    for (back = 0; start > 0 && back < UTF8_MAXLEN - 1 && ((byte_t)str[start] & 0xC0) == 0x80; back++)
+        start--;
+
+    return start + _scalar_check(str + start, len - start);
+}
+
+static _TARGET("avx2") size_t _avx2_check(const char *const str, size_t len)
+{
+    const __m256i low = _mm256_set1_epi8(0x0F);
+    const __m256i byte_1_high = _avx2_table(
+        _TOO_LONG, _TOO_LONG, _TOO_LONG, _TOO_LONG, _TOO_LONG, _TOO_LONG, _TOO_LONG, _TOO_LONG,
+        _TWO_CONTS, _TWO_CONTS, _TWO_CONTS, _TWO_CONTS,
+        _TOO_SHORT | _OVERLONG_2,
+        _TOO_SHORT,
+        _TOO_SHORT | _OVERLONG_3 | _SURROGATE,
+        _TOO_SHORT | _TOO_LARGE | _TOO_LARGE_1000 | _OVERLONG_4);
+    const __m256i byte_1_low = _avx2_table(
+        _CARRY | _OVERLONG_3 | _OVERLONG_2 | _OVERLONG_4,
+        _CARRY | _OVERLONG_2,
+        _CARRY,
+        _CARRY,
+        _CARRY | _TOO_LARGE,
+        _CARRY | _TOO_LARGE | _TOO_LARGE_1000,
+        _CARRY | _TOO_LARGE | _TOO_LARGE_1000,
+        _CARRY | _TOO_LARGE | _TOO_LARGE_1000,
+        _CARRY | _TOO_LARGE | _TOO_LARGE_1000,
+        _CARRY | _TOO_LARGE | _TOO_LARGE_1000,
+        _CARRY | _TOO_LARGE | _TOO_LARGE_1000,
+        _CARRY | _TOO_LARGE | _TOO_LARGE_1000,
+        _CARRY | _TOO_LARGE | _TOO_LARGE_1000,
+        _CARRY | _TOO_LARGE | _TOO_LARGE_1000 | _SURROGATE,
+        _CARRY | _TOO_LARGE | _TOO_LARGE_1000,
+        _CARRY | _TOO_LARGE | _TOO_LARGE_1000);
+    const __m256i byte_2_high = _avx2_table(
+        _TOO_SHORT, _TOO_SHORT, _TOO_SHORT, _TOO_SHORT, _TOO_SHORT, _TOO_SHORT, _TOO_SHORT, _TOO_SHORT,
+        _TOO_LONG | _OVERLONG_2 | _TWO_CONTS | _OVERLONG_3 | _TOO_LARGE_1000 | _OVERLONG_4,
+        _TOO_LONG | _OVERLONG_2 | _TWO_CONTS | _OVERLONG_3 | _TOO_LARGE,
+        _TOO_LONG | _OVERLONG_2 | _TWO_CONTS | _SURROGATE | _TOO_LARGE,
+        _TOO_LONG | _OVERLONG_2 | _TWO_CONTS | _SURROGATE | _TOO_LARGE,
+        _TOO_SHORT, _TOO_SHORT, _TOO_SHORT, _TOO_SHORT);
+    /* a lead in the last bytes needs the next block */
+    const __m256i last = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+
+    __m256i input, prev = _mm256_setzero_si256(), prev1, error = prev, incomplete = prev, special, must23;
+    byte_t tail[32];
+    size_t i;
+
+    for (i = 0; i < len; i += 32)
+    {
+        if (i + 32 <= len)
+            input = _avx2_load(str + i);
+        else
+        {
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, str + i, len - i);
+            input = _avx2_load(tail);
+        }
+
+        if (!_mm256_movemask_epi8(input))
+            error = _mm256_or_si256(error, incomplete);
+        else
+        {
+            prev1 = _avx2_prev(input, prev, 1);
+
+            special = _mm256_and_si256(
+                _mm256_and_si256(_mm256_shuffle_epi8(byte_1_high, _avx2_high(prev1, low)),
+                                 _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(prev1, low))),
+                _mm256_shuffle_epi8(byte_2_high, _avx2_high(input, low)));
+
+            /* third bytes follow 111_____, fourth bytes 1111____ */
+            must23 = _mm256_or_si256(_mm256_subs_epu8(_avx2_prev(input, prev, 2), _mm256_set1_epi8((char)(0xE0 - 0x80))),
+                                     _mm256_subs_epu8(_avx2_prev(input, prev, 3), _mm256_set1_epi8((char)(0xF0 - 0x80))));
+
+            error = _mm256_or_si256(error, _mm256_xor_si256(_mm256_and_si256(must23, _mm256_set1_epi8((char)0x80)), special));
+            incomplete = _mm256_subs_epu8(input, last);
+        }
+
+        if (!_mm256_testz_si256(error, error))
+            return _avx2_rescan(str, len, i);
+
+        prev = input;
+    }
+
+    if (!_mm256_testz_si256(incomplete, incomplete))
+        return _avx2_rescan(str, len, i - 32);
+
+    return len;
+}
+
+#pragma endregion
+
+// +---- Internal (AVX2) ------------------------------ END ----+
+
+#endif // _CALC_AVX2
+
+// +---- Internal (Dispatch) -----------------------------------+
+
+#pragma region Internal (Dispatch)
+
+/// @brief Implementations of the UTF-8 operations for an
+///        instruction set.
+typedef struct _chops
+{
+    const char *isa;
+    size_t (*ascii)(const char *const str, size_t len);
+    size_t (*check)(const char *const str, size_t len);
+} chops_t;
+
+static const chops_t _chops_scalar = {"scalar", _scalar_ascii, _scalar_check};
+
+#if _CALC_SSE2
+static const chops_t _chops_sse2 = {"sse2", _sse2_ascii, _sse2_check};
+#endif // _CALC_SSE2
+
+#if _CALC_AVX2
+static const chops_t _chops_avx2 = {"avx2", _avx2_ascii, _avx2_check};
+#endif // _CALC_AVX2
+
+static const chops_t *_chops_sel = NULL;
+
+static const chops_t *_chops_select()
+{
+    const chops_t *ops = &_chops_scalar;
+
+#if _CALC_AVX2
+    if (cpuhas(CPU_AVX2))
+        ops = &_chops_avx2;
+    else
+#endif // _CALC_AVX2
+#if _CALC_SSE2
+    if (cpuhas(CPU_SSE2))
+        ops = &_chops_sse2;
+#endif // _CALC_SSE2
+
+    atomic_store_ptr(&_chops_sel, ops);
+
+    return ops;
+}
+
+/// @brief Gets the UTF-8 operations of the processor, selecting
+///        them on the first call.
+static inline const chops_t *_chops()
+{
+    const chops_t *ops = (const chops_t *)atomic_load_ptr(&_chops_sel);
+
+    return ops ? ops : _chops_select();
+}
+
+#pragma endregion
+
+// +---- Internal (Dispatch) -------------------------- END ----+
+
+size_t _CDECL ascii_span(const char *const str, size_t len)
+{
+    return _chops()->ascii(str, len);
+}
+
+size_t _CDECL utf8_check(const char *const str, size_t len)
+{
+    return _chops()->check(str, len);
+}
+
+size_t _CDECL utf8_decode(const char *const str, size_t len, uint32_t *const cp)
+{
+    const byte_t *const p = (const byte_t *)str;
+    uint32_t ch;
+    size_t n, i;
+
+    if (!len)
+        return 0;
+
+    if ((ch = p[0]) < 0x80)
+    {
+        *cp = ch;
+        return 1;
+    }
+
+    if (ch < 0xC2)
+        return 0; /* continuation or overlong lead */
+    else if (ch < 0xE0)
+        n = 2, ch &= 0x1F;
+    else if (ch < 0xF0)
+        n = 3, ch &= 0x0F;
+    else if (ch < 0xF5)
+        n = 4, ch &= 0x07;
+    else
+        return 0;
+
+    if (len < n)
+        return 0;
+
+    for (i = 1; i < n; i++)
+    {
+        if ((p[i] & 0xC0) != 0x80)
+            return 0;
+
+        ch = (ch << 6) | (p[i] & 0x3F);
+    }
+
+    if (ch < _utf8_min[n] || (ch >= 0xD800 && ch <= 0xDFFF) || ch > 0x10FFFF)
+        return 0;
+
+    *cp = ch;
+
+    return n;
+}
+
+const char *_CDECL utf8_isa()
+{
+    return _chops()->isa;
+}
+
+// +---- Internal (Identifiers) --------------------------------+
+
+#pragma region Internal (Identifiers)
+
+/// @brief Range of code points.
+typedef struct _uni_range
+{
+    uint32_t first;
+    uint32_t last;
+} uni_range_t;
+
+/* C11, Annex D.1: ranges of the chars allowed in identifiers */
+static const uni_range_t _uni_ident[] = {
+    {0x00A8, 0x00A8}, {0x00AA, 0x00AA}, {0x00AD, 0x00AD}, {0x00AF, 0x00AF},
+    {0x00B2, 0x00B5}, {0x00B7, 0x00BA}, {0x00BC, 0x00BE}, {0x00C0, 0x00D6},
+    {0x00D8, 0x00F6}, {0x00F8, 0x00FF}, {0x0100, 0x167F}, {0x1681, 0x180D},
+    {0x180F, 0x1FFF}, {0x200B, 0x200D}, {0x202A, 0x202E}, {0x203F, 0x2040},
+    {0x2054, 0x2054}, {0x2060, 0x206F}, {0x2070, 0x218F}, {0x2460, 0x24FF},
+    {0x2776, 0x2793}, {0x2C00, 0x2DFF}, {0x2E80, 0x2FFF}, {0x3004, 0x3007},
+    {0x3021, 0x302F}, {0x3031, 0x303F}, {0x3040, 0xD7FF}, {0xF900, 0xFD3D},
+    {0xFD40, 0xFDCF}, {0xFDF0, 0xFE44}, {0xFE47, 0xFFFD},
+    {0x10000, 0x1FFFD}, {0x20000, 0x2FFFD}, {0x30000, 0x3FFFD}, {0x40000, 0x4FFFD},
+    {0x50000, 0x5FFFD}, {0x60000, 0x6FFFD}, {0x70000, 0x7FFFD}, {0x80000, 0x8FFFD},
+    {0x90000, 0x9FFFD}, {0xA0000, 0xAFFFD}, {0xB0000, 0xBFFFD}, {0xC0000, 0xCFFFD},
+    {0xD0000, 0xDFFFD}, {0xE0000, 0xEFFFD}
+};
+
+/* C11, Annex D.2: ranges of the chars not allowed first */
+static const uni_range_t _uni_nostart[] = {
+    {0x0300, 0x036F}, {0x1DC0, 0x1DFF}, {0x20D0, 0x20FF}, {0xFE20, 0xFE2F}
+};
+
+static bool_t _uni_find(const uni_range_t *const ranges, size_t count, uint32_t cp)
+{
+    size_t lo = 0, hi = count, mid;
+
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+
+        if (cp > ranges[mid].last)
+            lo = mid + 1;
+        else if (cp < ranges[mid].first)
+            hi = mid;
+        else
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+/* decodes a non-ASCII identifier char, the slow path */
+static size_t _ident_utf8(const char *const str, size_t len, bool_t start)
+{
+    uint32_t cp;
+    size_t n = utf8_decode(str, len, &cp);
+
+    if (!n || !(start ? uni_isidstart(cp) : uni_isidcont(cp)))
+        return 0;
+
+    return n;
+}
+
+#pragma endregion
+
+// +---- Internal (Identifiers) ----------------------- END ----+
+
+bool_t _CDECL uni_isidstart(uint32_t cp)
+{
+    if (cp < 0x80)
+        return ch_isidstart(cp);
+
+    return _uni_find(_uni_ident, sizeof(_uni_ident) / sizeof(_uni_ident[0]), cp) &&
+           !_uni_find(_uni_nostart, sizeof(_uni_nostart) / sizeof(_uni_nostart[0]), cp);
+}
+
+bool_t _CDECL uni_isidcont(uint32_t cp)
+{
+    if (cp < 0x80)
+        return ch_isidcont(cp);
+
+    return _uni_find(_uni_ident, sizeof(_uni_ident) / sizeof(_uni_ident[0]), cp);
+}
+
+size_t _CDECL ch_identlen(const char *const str, size_t len)
+{
+    size_t i, n;
+
+    if (!len)
+        return 0;
+
+    if (ch_isidstart(str[0]))
+        i = 1;
+    else if (!ch_isutf8(str[0]) || !(i = _ident_utf8(str, len, TRUE)))
+        return 0;
+
+    for (;;)
+    {
+        while (i < len && ch_isidcont(str[i]))
+            i++;
+
+        if (i >= len || !ch_isutf8(str[i]) || !(n = _ident_utf8(str + i, len - i, FALSE)))
+            return i;
+
+        i += n;
+    }
+}
+
+/* =------------------------------------------------------------= */
@@ -26,4 +26,54 @@ _API CALC_C_EXTERN unsigned int _CDECL _getpagesiz()
 
 // +---- System Dependent Definitions ----------------- END ----+
 
+// +---- Processor Dependent Definitions -----------------------+
+
+#pragma region Processor Dependent Definitions
+
+_API CALC_C_EXTERN unsigned int _CDECL _getcpufeat()
+{
+    static int features = -1;
+    unsigned int result = 0;
+
+    if (features >= 0)
+        return (unsigned int)features;
+
+#if defined _MSC_VER && _CALC_SSE2
+    {
+        int info[4];
+
+        __cpuid(info, 1);
+
+        if (info[3] & (1 << 26))
+            result |= CPU_SSE2;
+        if (info[2] & (1 << 20))
+            result |= CPU_SSE42;
+
+        /* AVX2 needs the system to save the YMM registers */
+        if ((info[2] & (1 << 27)) && (_xgetbv(0) & 0x06) == 0x06)
+        {
+            __cpuidex(info, 7, 0);
+
+            if (info[1] & (1 << 5))
+                result |= CPU_AVX2;
+        }
+    }
+#elif defined __GNUC__ && _CALC_SSE2
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("sse2"))
+        result |= CPU_SSE2;
+    if (__builtin_cpu_supports("sse4.2"))
+        result |= CPU_SSE42;
+    if (__builtin_cpu_supports("avx2"))
+        result |= CPU_AVX2;
+#endif // _MSC_VER or __GNUC__
+
+    return (unsigned int)(features = (int)result);
+}
+
+#pragma endregion
+
+// +---- Processor Dependent Definitions -------------- END ----+
+
 /* =------------------------------------------------------------= */
@@ -0,0 +1,78 @@
+#include "calc/base/stdin.h"
+
+#include <errno.h>
+
+/* =---- Chunked Readers ---------------------------------------= */
+
+reader_t *_CDECL reader_init(reader_t *const reader, int fd, size_t chunk, writer_t *const tie)
+{
+    reader->fd = fd;
+    reader->tie = tie;
+    reader->chunk = chunk ? chunk : CALC_READER_CHUNK;
+    reader->cap = reader->chunk;
+    reader->buf = (char *)checked_mallocz(reader->cap + CALC_READER_PAD);
+    reader->pos = reader->len = 0;
+    reader->offset = 0;
+    reader->eof = reader->error = FALSE;
+
+    return reader;
+}
+
+void _CDECL reader_release(reader_t *const reader)
+{
+    checked_free(reader->buf);
+
+    reader->buf = NULL;
+    reader->pos = reader->len = reader->cap = 0;
+}
+
+size_t _CDECL reader_fill(reader_t *const reader)
+{
+    size_t keep = reader->len - reader->pos, room;
+    ssize_t n;
+
+    if (reader->eof || reader->error)
+        return 0;
+
+    /* the consumed bytes are dropped, the kept ones are usually a
+       fraction of a token or a statement */
+    if (reader->pos)
+    {
+        memmove(reader->buf, reader->buf + reader->pos, keep);
+
+        reader->offset += reader->pos;
+        reader->pos = 0;
+        reader->len = keep;
+    }
+
+    if (reader->cap - keep < reader->chunk)
+    {
+        reader->cap = keep + reader->chunk;
+        reader->buf = (char *)checked_realloc(reader->buf, reader->cap + CALC_READER_PAD);
+    }
+
+    room = reader->cap - keep;
+
+    if (room > 0x40000000)
+        room = 0x40000000;
+
+    if (reader->tie)
+        writer_flush(reader->tie);
+
+    while ((n = read(reader->fd, reader->buf + keep, (unsigned int)room)) < 0 && errno == EINTR)
+        continue;
+
+    if (n <= 0)
+    {
+        reader->eof = !n;
+        reader->error = n < 0;
+        n = 0;
+    }
+
+    reader->len = keep + (size_t)n;
+    memset(reader->buf + reader->len, 0, CALC_READER_PAD);
+
+    return (size_t)n;
+}
+
+/* =------------------------------------------------------------= */
@@ -1,4 +1,21 @@
 #include "calc/base/stdmem.h"
+#include "calc/base/stdthrd.h"
+
+#if _CALC_MEM_STATS
+/* the tagging macros would shadow the definitions below */
+#   undef checked_malloc
+#   undef checked_calloc
+#   undef checked_mallocz
+#   undef checked_callocz
+#   undef checked_realloc
+#   undef checked_aligned_malloc
+#   undef checked_aligned_calloc
+#   undef checked_aligned_mallocz
+#   undef checked_aligned_callocz
+#   undef arena_init
+#   undef pool_init
+#   undef pools_init
+#endif // _CALC_MEM_STATS
 
 /* =---- Memory Management -------------------------------------= */
 
@@ -54,90 +71,934 @@ static inline void *_zerofy_block(void *block, size_t size)
 
 // +---- Internal (Memory Checks) --------------------- END ----+
 
+void *_CDECL _calloc_overflow()
+{
+    return _safety_abort(
+#ifdef _DEBUG
+        __func__
+#endif // _DEBUG
+    );
+}
+
+// +---- Internal (Aligned Blocks) -----------------------------+
+
+#pragma region Internal (Aligned Blocks)
+
+#ifdef _WIN32
+#   define _aligned_block_malloc(align, size) _aligned_malloc((size), (align))
+#   define _aligned_block_free(block) _aligned_free(block)
+#elif defined _POSIX_VERSION && _POSIX_VERSION >= 200112L
+static inline void *_aligned_block_malloc(size_t align, size_t size)
+{
+    void *block;
+
+    if (align < sizeof(void *))
+        align = sizeof(void *);
+
+    return posix_memalign(&block, align, size) ? NULL : block;
+}
+
+#   define _aligned_block_free(block) free(block)
+#else
+static inline void *_aligned_block_malloc(size_t align, size_t size)
+{
+    byte_t *base, *block;
+
+    if (align < sizeof(void *))
+        align = sizeof(void *);
+
+    /* over-allocates and stores the base pointer right before
+       the aligned block */
+    if (!(base = (byte_t *)malloc(size + align - 1 + sizeof(void *))))
+        return NULL;
+
+    block = (byte_t *)alignto((size_t)(base + sizeof(void *)), align);
+    ((void **)block)[-1] = base;
+
+    return block;
+}
+
+static inline void _aligned_block_free(void *block)
+{
+    if (block)
+        free(((void **)block)[-1]);
+}
+#endif // _WIN32
+
+#pragma endregion
+
+// +---- Internal (Aligned Blocks) -------------------- END ----+
+
+// +---- Internal (Memory Statistics) --------------------------+
+
+#pragma region Internal (Memory Statistics)
+
+#if _CALC_MEM_STATS
+
+/// @brief Header stored before each tracked block.
+typedef struct _memhdr
+{
+    /// @brief Number of bytes requested.
+    size_t size;
+    /// @brief Subsystem charged for the block.
+    unsigned int tag;
+    /// @brief Distance of the block from the allocated address.
+    unsigned int offset;
+} memhdr_t;
+
+#define _memhdr_siz alignto(sizeof(memhdr_t), 16)
+
+/// @brief Statistics of each subsystem, followed by the totals.
+static memstats_t _memstats[MEMTAG_COUNT + 1];
+
+static inline void _memstats_count(memstats_t *const stats, size_t size)
+{
+    size_t bin = 0, n = (size) ? (size - 1) >> 4 : 0, live, peak;
+
+    while (n && bin < CALC_MEM_HIST_BINS - 1)
+        n >>= 1, bin++;
+
+    atomic_add_size(&stats->allocs, 1);
+    atomic_add_size(&stats->bytes, size);
+    atomic_add_size(&stats->hist[bin], 1);
+
+    live = atomic_add_size(&stats->live, size);
+
+    while ((peak = atomic_load_size(&stats->peak)) < live && !atomic_cas_size(&stats->peak, peak, live))
+        continue;
+}
+
+static inline void _memstats_uncount(memstats_t *const stats, size_t size)
+{
+    atomic_add_size(&stats->frees, 1);
+    atomic_add_size(&stats->live, (size_t)0 - size);
+}
+
+static void *_memstats_attach(void *base, size_t size, memtag_t tag, size_t offset)
+{
+    memhdr_t *hdr;
+
+    if (!base)
+        return NULL;
+
+    hdr = (memhdr_t *)((byte_t *)base + offset) - 1;
+    hdr->size = size;
+    hdr->tag = (unsigned int)tag;
+    hdr->offset = (unsigned int)offset;
+
+    _memstats_count(&_memstats[tag], size);
+    _memstats_count(&_memstats[MEMTAG_COUNT], size);
+
+    return (void *)(hdr + 1);
+}
+
+static void *_memstats_detach(void *block)
+{
+    memhdr_t *hdr;
+
+    if (!block)
+        return NULL;
+
+    hdr = (memhdr_t *)block - 1;
+
+    _memstats_uncount(&_memstats[hdr->tag], hdr->size);
+    _memstats_uncount(&_memstats[MEMTAG_COUNT], hdr->size);
+
+    return (void *)((byte_t *)block - hdr->offset);
+}
+
+static void *_memstats_realloc(void *block, size_t size, memtag_t tag)
+{
+    if (!block)
+        return _memstats_attach(malloc(_memhdr_siz + size), size, tag, _memhdr_siz);
+
+    block = realloc(_memstats_detach(block), _memhdr_siz + size);
+
+    return _memstats_attach(block, size, tag, _memhdr_siz);
+}
+
+#   define _tracked_malloc(size, tag) \
+        _memstats_attach(malloc(_memhdr_siz + (size)), (size), (tag), _memhdr_siz)
+/* the product is checked as calloc does, NULL fails the allocation */
+#   define _tracked_calloc(count, size, tag) \
+        (_calloc_fits((count), (size)) \
+            ? _memstats_attach(calloc(1, _memhdr_siz + (count) * (size)), (count) * (size), (tag), _memhdr_siz) \
+            : NULL)
+#   define _tracked_realloc(block, size, tag) \
+        _memstats_realloc((block), (size), (tag))
+#   define _tracked_free(block) \
+        free(_memstats_detach(block))
+#   define _tracked_aligned_malloc(align, size, tag) \
+        _memstats_attach(_aligned_block_malloc((align), alignto(_memhdr_siz, (align)) + (size)), (size), (tag), alignto(_memhdr_siz, (align)))
+#   define _tracked_aligned_free(block) \
+        _aligned_block_free(_memstats_detach(block))
+
+#else
+
+#   define _tracked_malloc(size, tag) malloc(size)
+#   define _tracked_calloc(count, size, tag) calloc((count), (size))
+#   define _tracked_realloc(block, size, tag) realloc((block), (size))
+#   define _tracked_free(block) free(block)
+#   define _tracked_aligned_malloc(align, size, tag) _aligned_block_malloc((align), (size))
+#   define _tracked_aligned_free(block) _aligned_block_free(block)
+
+#endif // _CALC_MEM_STATS
+
+#pragma endregion
+
+// +---- Internal (Memory Statistics) ----------------- END ----+
+
+#if _CALC_MEM_STATS
+void *_CDECL checked_malloc_tag(size_t size, memtag_t tag)
+#else
 void *_CDECL checked_malloc(size_t size)
+#endif // _CALC_MEM_STATS
 {
     return _safety_check(
 #ifdef _DEBUG
         __func__,
 #endif // _DEBUG
-        malloc(size)
+        _tracked_malloc(size, tag)
     );
 }
 
+#if _CALC_MEM_STATS
+void *_CDECL checked_calloc_tag(size_t count, size_t size, memtag_t tag)
+#else
 void *_CDECL checked_calloc(size_t count, size_t size)
+#endif // _CALC_MEM_STATS
 {
     return _safety_check(
 #ifdef _DEBUG
         __func__,
 #endif // _DEBUG
-        calloc(count, size)
+        _tracked_calloc(count, size, tag)
     );
 }
 
+#if _CALC_MEM_STATS
+void *_CDECL checked_mallocz_tag(size_t size, memtag_t tag)
+#else
 void *_CDECL checked_mallocz(size_t size)
+#endif // _CALC_MEM_STATS
 {
     return _zerofy_block(_safety_check(
 #ifdef _DEBUG
         __func__,
 #endif // _DEBUG
-        malloc(size)
+        _tracked_malloc(size, tag)
     ), size);
 }
 
+#if _CALC_MEM_STATS
+void *_CDECL checked_callocz_tag(size_t count, size_t size, memtag_t tag)
+#else
 void *_CDECL checked_callocz(size_t count, size_t size)
+#endif // _CALC_MEM_STATS
 {
     return _zerofy_block(_safety_check(
 #ifdef _DEBUG
         __func__,
 #endif // _DEBUG
-        calloc(count, size)
+        _tracked_calloc(count, size, tag)
     ), count * size);
 }
 
-// Aligned Allocators
+#if _CALC_MEM_STATS
+void *_CDECL checked_realloc_tag(void *const block, size_t size, memtag_t tag)
+#else
+void *_CDECL checked_realloc(void *const block, size_t size)
+#endif // _CALC_MEM_STATS
+{
+    return _safety_check(
+#ifdef _DEBUG
+        __func__,
+#endif // _DEBUG
+        _tracked_realloc(block, size, tag)
+    );
+}
 
-#if !_CALC_BUILD_INLINES
+void _CDECL checked_free(void *const block)
+{
+    _tracked_free(block);
+}
 
+// Aligned Allocators
+
+#if _CALC_MEM_STATS
+void *_CDECL checked_aligned_malloc_tag(size_t align, size_t size, memtag_t tag)
+#else
 void *_CDECL checked_aligned_malloc(size_t align, size_t size)
+#endif // _CALC_MEM_STATS
 {
+    assert(align && !(align & (align - 1)));
+
     return _safety_check(
 #ifdef _DEBUG
         __func__,
 #endif // _DEBUG
-        malloc(alignto(size, align))
+        _tracked_aligned_malloc(align, size, tag)
     );
 }
 
+#if _CALC_MEM_STATS
+void *_CDECL checked_aligned_calloc_tag(size_t align, size_t count, size_t size, memtag_t tag)
+#else
 void *_CDECL checked_aligned_calloc(size_t align, size_t count, size_t size)
+#endif // _CALC_MEM_STATS
 {
-    return _safety_check(
+    size_t stride = alignto(size, align);
+
+    assert(align && !(align & (align - 1)));
+
+    if (stride < size || !_calloc_fits(count, stride))
+        return _calloc_overflow();
+
+    return _zerofy_block(_safety_check(
 #ifdef _DEBUG
         __func__,
 #endif // _DEBUG
-        calloc(count, alignto(size, align))
-    );
+        _tracked_aligned_malloc(align, count * stride, tag)
+    ), count * stride);
 }
 
+#if _CALC_MEM_STATS
+void *_CDECL checked_aligned_mallocz_tag(size_t align, size_t size, memtag_t tag)
+{
+    return _zerofy_block(checked_aligned_malloc_tag(align, size, tag), size);
+}
+#else
 void *_CDECL checked_aligned_mallocz(size_t align, size_t size)
 {
-    return size = alignto(size, align), _zerofy_block(_safety_check(
+    return _zerofy_block(checked_aligned_malloc(align, size), size);
+}
+#endif // _CALC_MEM_STATS
+
+#if _CALC_MEM_STATS
+void *_CDECL checked_aligned_callocz_tag(size_t align, size_t count, size_t size, memtag_t tag)
+{
+    /* the series is already zeroed */
+    return checked_aligned_calloc_tag(align, count, size, tag);
+}
+#else
+void *_CDECL checked_aligned_callocz(size_t align, size_t count, size_t size)
+{
+    /* the series is already zeroed */
+    return checked_aligned_calloc(align, count, size);
+}
+#endif // _CALC_MEM_STATS
+
+void _CDECL checked_aligned_free(void *const block)
+{
+    _tracked_aligned_free(block);
+}
+
+// Scratch Allocators
+
+_THREAD_LOCAL scratch_t _scratch = { NULL, NULL, NULL, NULL };
+
+void *_CDECL _scratch_spill(size_t size)
+{
+    scratch_spill_t *spill;
+
+    if (!_scratch.base)
+    {
+        _scratch.base = (byte_t *)_safety_check(
+#ifdef _DEBUG
+            __func__,
+#endif // _DEBUG
+            _tracked_malloc(CALC_SCRATCH_RESERVE, MEMTAG_BASE)
+        );
+        _scratch.ptr = _scratch.base;
+        _scratch.end = _scratch.base + CALC_SCRATCH_RESERVE;
+
+        if (size <= CALC_SCRATCH_RESERVE)
+            return (void *)((_scratch.ptr += size) - size);
+    }
+
+    /* the reserve is exhausted, the block is linked to the spill
+       list and freed by the scratch_pop of its scope */
+    spill = (scratch_spill_t *)_safety_check(
 #ifdef _DEBUG
         __func__,
 #endif // _DEBUG
-        malloc(size)
-    ), size);
+        _tracked_malloc(alignto(sizeof(scratch_spill_t), CALC_SCRATCH_ALIGN) + size, MEMTAG_BASE)
+    );
+    spill->prev = _scratch.spill;
+    _scratch.spill = spill;
+
+    return (void *)((byte_t *)spill + alignto(sizeof(scratch_spill_t), CALC_SCRATCH_ALIGN));
 }
 
-void *_CDECL checked_aligned_callocz(size_t align, size_t count, size_t size)
+scratch_mark_t _CDECL scratch_push()
+{
+    scratch_mark_t mark;
+
+    mark.ptr = _scratch.ptr;
+    mark.spill = _scratch.spill;
+
+    return mark;
+}
+
+void _CDECL scratch_pop(const scratch_mark_t mark)
+{
+    scratch_spill_t *prev;
+
+    while (_scratch.spill != mark.spill)
+    {
+        prev = _scratch.spill->prev;
+        _tracked_free(_scratch.spill);
+        _scratch.spill = prev;
+    }
+
+    /* a scope opened before the reserve was allocated */
+    _scratch.ptr = (mark.ptr) ? mark.ptr : _scratch.base;
+}
+
+void _CDECL scratch_release()
 {
-    return size = alignto(size, align), _zerofy_block(_safety_check(
+    scratch_mark_t mark = { NULL, NULL };
+
+    scratch_pop(mark);
+    _tracked_free(_scratch.base);
+
+    _scratch.base = NULL;
+    _scratch.ptr = NULL;
+    _scratch.end = NULL;
+}
+
+#if !_CALC_BUILD_INLINES
+
+void *_CDECL scratch_malloc(size_t size)
+{
+    if (!_malloc_fits(size))
+        return _calloc_overflow();
+
+    return (size = alignto(size, CALC_SCRATCH_ALIGN)) <= (size_t)(_scratch.end - _scratch.ptr)
+        ? (void *)((_scratch.ptr += size) - size)
+        : _scratch_spill(size);
+}
+
+void *_CDECL scratch_calloc(size_t count, size_t size)
+{
+    if (!_calloc_fits(count, size))
+        return _calloc_overflow();
+
+    return scratch_malloc(count * size);
+}
+
+void *_CDECL scratch_mallocz(size_t size)
+{
+    return _zerofy_block(scratch_malloc(size), size);
+}
+
+void *_CDECL scratch_callocz(size_t count, size_t size)
+{
+    return _zerofy_block(scratch_calloc(count, size), count * size);
+}
+
+#endif // _CALC_BUILD_INLINES
+
+// Arena Allocators
+
+#if _CALC_MEM_STATS
+arena_t *_CDECL arena_init_tag(arena_t *const arena, size_t chunksiz, memtag_t tag)
+#else
+arena_t *_CDECL arena_init(arena_t *const arena, size_t chunksiz)
+#endif // _CALC_MEM_STATS
+{
+    assert(arena != NULL);
+
+    arena->chunk = NULL;
+    arena->ptr = NULL;
+    arena->end = NULL;
+    arena->next = (chunksiz) ? chunksiz : CALC_ARENA_CHUNK_MIN;
+#if _CALC_MEM_STATS
+    arena->tag = tag;
+#endif // _CALC_MEM_STATS
+
+    return arena;
+}
+
+void *_CDECL _arena_grow(arena_t *const arena, size_t size)
+{
+    arena_chunk_t *chunk;
+    size_t chunksiz = (size > arena->next) ? size : arena->next;
+
+    chunk = (arena_chunk_t *)_safety_check(
 #ifdef _DEBUG
         __func__,
 #endif // _DEBUG
-        calloc(count, size)
-    ), count * size);
+        _tracked_malloc(_arena_chunk_hdrsiz + chunksiz, arena->tag)
+    );
+    chunk->prev = arena->chunk;
+    chunk->size = chunksiz;
+
+    arena->chunk = chunk;
+    arena->ptr = _arena_chunk_data(chunk) + size;
+    arena->end = _arena_chunk_data(chunk) + chunksiz;
+
+    if (arena->next < CALC_ARENA_CHUNK_MAX)
+        arena->next = (arena->next < CALC_ARENA_CHUNK_MAX / 2) ? arena->next * 2 : CALC_ARENA_CHUNK_MAX;
+
+    return (void *)(arena->ptr - size);
+}
+
+#if !_CALC_BUILD_INLINES
+
+void *_CDECL arena_malloc(arena_t *const arena, size_t size)
+{
+    if (!_malloc_fits(size))
+        return _calloc_overflow();
+
+    return size = alignto(size, CALC_ARENA_ALIGN), _arena_bump(arena, size);
+}
+
+void *_CDECL arena_calloc(arena_t *const arena, size_t count, size_t size)
+{
+    if (!_calloc_fits(count, size))
+        return _calloc_overflow();
+
+    return size = alignto(count * size, CALC_ARENA_ALIGN), _arena_bump(arena, size);
+}
+
+void *_CDECL arena_mallocz(arena_t *const arena, size_t size)
+{
+    return _zerofy_block(arena_malloc(arena, size), size);
+}
+
+void *_CDECL arena_callocz(arena_t *const arena, size_t count, size_t size)
+{
+    return _zerofy_block(arena_calloc(arena, count, size), count * size);
 }
 
 #endif // _CALC_BUILD_INLINES
 
+arena_mark_t _CDECL arena_mark(const arena_t *const arena)
+{
+    arena_mark_t mark;
+
+    mark.chunk = arena->chunk;
+    mark.ptr = arena->ptr;
+
+    return mark;
+}
+
+void _CDECL arena_rewind(arena_t *const arena, const arena_mark_t mark)
+{
+    arena_chunk_t *prev;
+
+    while (arena->chunk != mark.chunk)
+    {
+        assert(arena->chunk != NULL);
+
+        prev = arena->chunk->prev;
+        _tracked_free(arena->chunk);
+        arena->chunk = prev;
+    }
+
+    if (mark.chunk)
+    {
+        arena->ptr = mark.ptr;
+        arena->end = _arena_chunk_data(mark.chunk) + mark.chunk->size;
+    }
+    else
+    {
+        arena->ptr = NULL;
+        arena->end = NULL;
+    }
+}
+
+void _CDECL arena_release(arena_t *const arena)
+{
+    arena_mark_t mark = { NULL, NULL };
+
+    arena_rewind(arena, mark);
+}
+
+// Pool Allocators
+
+#if _CALC_MEM_STATS
+pool_t *_CDECL pool_init_tag(pool_t *const pool, size_t size, memtag_t tag)
+#else
+pool_t *_CDECL pool_init(pool_t *const pool, size_t size)
+#endif // _CALC_MEM_STATS
+{
+    assert(pool != NULL);
+
+    size = alignto((size < sizeof(pool_node_t)) ? sizeof(pool_node_t) : size, CALC_POOL_ALIGN);
+
+    pool->free = NULL;
+    pool->slab = NULL;
+    pool->ptr = NULL;
+    pool->end = NULL;
+    pool->size = size;
+    pool->slabsiz = (_pool_slab_hdrsiz + size * 8 > pagesiz)
+        ? alignto(_pool_slab_hdrsiz + size * 8, pagesiz)
+        : pagesiz;
+    pool->slabs = 0;
+    pool->capacity = 0;
+    pool->used = 0;
+    pool->peak = 0;
+#if _CALC_MEM_STATS
+    pool->tag = tag;
+#endif // _CALC_MEM_STATS
+
+    return pool;
+}
+
+void *_CDECL pool_malloc(pool_t *const pool)
+{
+    pool_node_t *node;
+    pool_slab_t *slab;
+
+    if (pool->free)
+    {
+        node = pool->free;
+        pool->free = node->next;
+    }
+    else
+    {
+        if ((size_t)(pool->end - pool->ptr) < pool->size)
+        {
+            slab = (pool_slab_t *)_safety_check(
+#ifdef _DEBUG
+                __func__,
+#endif // _DEBUG
+                _tracked_malloc(pool->slabsiz, pool->tag)
+            );
+            slab->prev = pool->slab;
+
+            pool->slab = slab;
+            pool->ptr = (byte_t *)slab + _pool_slab_hdrsiz;
+            pool->end = (byte_t *)slab + pool->slabsiz;
+            pool->slabs++;
+            pool->capacity += (pool->slabsiz - _pool_slab_hdrsiz) / pool->size;
+        }
+
+        node = (pool_node_t *)pool->ptr;
+        pool->ptr += pool->size;
+    }
+
+    if (++pool->used > pool->peak)
+        pool->peak = pool->used;
+
+    return (void *)node;
+}
+
+void *_CDECL pool_mallocz(pool_t *const pool)
+{
+    return _zerofy_block(pool_malloc(pool), pool->size);
+}
+
+void _CDECL pool_free(pool_t *const pool, void *const block)
+{
+    pool_node_t *node = (pool_node_t *)block;
+
+    if (!block)
+        return;
+
+    assert(pool->used > 0);
+
+    node->next = pool->free;
+    pool->free = node;
+    pool->used--;
+}
+
+void _CDECL pool_release(pool_t *const pool)
+{
+    pool_slab_t *prev;
+
+    while (pool->slab)
+    {
+        prev = pool->slab->prev;
+        _tracked_free(pool->slab);
+        pool->slab = prev;
+    }
+
+    pool->free = NULL;
+    pool->ptr = NULL;
+    pool->end = NULL;
+    pool->slabs = 0;
+    pool->capacity = 0;
+    pool->used = 0;
+}
+
+#if _CALC_MEM_STATS
+pools_t *_CDECL pools_init_tag(pools_t *const pools, memtag_t tag)
+#else
+pools_t *_CDECL pools_init(pools_t *const pools)
+#endif // _CALC_MEM_STATS
+{
+    size_t i;
+
+    for (i = 0; i < CALC_POOL_CLASSES; i++)
+#if _CALC_MEM_STATS
+        pool_init_tag(&pools->classes[i], (i + 1) * CALC_POOL_ALIGN, tag);
+#else
+        pool_init(&pools->classes[i], (i + 1) * CALC_POOL_ALIGN);
+#endif // _CALC_MEM_STATS
+
+    return pools;
+}
+
+#if !_CALC_BUILD_INLINES
+
+void *_CDECL pools_malloc(pools_t *const pools, size_t size)
+{
+    return (size <= CALC_POOL_CLASS_MAX)
+        ? pool_malloc(&pools->classes[_pools_class(size)])
+        : checked_malloc(size);
+}
+
+void *_CDECL pools_mallocz(pools_t *const pools, size_t size)
+{
+    return (size <= CALC_POOL_CLASS_MAX)
+        ? pool_mallocz(&pools->classes[_pools_class(size)])
+        : checked_mallocz(size);
+}
+
+#endif // _CALC_BUILD_INLINES
+
+void _CDECL pools_free(pools_t *const pools, void *const block, size_t size)
+{
+    if (size <= CALC_POOL_CLASS_MAX)
+        pool_free(&pools->classes[_pools_class(size)], block);
+    else
+        checked_free(block);
+}
+
+void _CDECL pools_release(pools_t *const pools)
+{
+    size_t i;
+
+    for (i = 0; i < CALC_POOL_CLASSES; i++)
+        pool_release(&pools->classes[i]);
+}
+
+// Thread Heaps
+
+/// @brief Heap of the calling thread.
+static _THREAD_LOCAL heap_t *_heap = NULL;
+
+static void _heap_collect(heap_t *const heap, pool_t *const pool, size_t index)
+{
+    pool_node_t *head, *tail;
+    size_t count = 1;
+
+    head = (pool_node_t *)atomic_xchg_ptr(&heap->remote[index], NULL);
+
+    if (!head)
+        return;
+
+    for (tail = head; tail->next; tail = tail->next)
+        count++;
+
+    tail->next = pool->free;
+    pool->free = head;
+    pool->used -= count;
+}
+
+heap_t *_CDECL heap_current()
+{
+    if (!_heap)
+    {
+        _heap = line_allocz(heap_t);
+
+        arena_init(&_heap->arena, 0);
+        pools_init(&_heap->pools);
+    }
+
+    return _heap;
+}
+
+void *_CDECL heap_malloc(heap_t *const heap, size_t size)
+{
+    pool_t *pool;
+
+    if (size > CALC_POOL_CLASS_MAX)
+        return checked_malloc(size);
+
+    pool = &heap->pools.classes[_pools_class(size)];
+
+    if (!pool->free && atomic_load_ptr(&heap->remote[_pools_class(size)]))
+        _heap_collect(heap, pool, _pools_class(size));
+
+    return pool_malloc(pool);
+}
+
+void *_CDECL heap_mallocz(heap_t *const heap, size_t size)
+{
+    return _zerofy_block(heap_malloc(heap, size), size);
+}
+
+void _CDECL heap_free(heap_t *const heap, void *const block, size_t size)
+{
+    pool_node_t *node = (pool_node_t *)block, *head;
+
+    if (!block)
+        return;
+
+    if (size > CALC_POOL_CLASS_MAX)
+        checked_free(block);
+    else if (heap == _heap)
+        pool_free(&heap->pools.classes[_pools_class(size)], block);
+    else
+    {
+        do
+            node->next = head = (pool_node_t *)atomic_load_ptr(&heap->remote[_pools_class(size)]);
+        while (!atomic_cas_ptr(&heap->remote[_pools_class(size)], head, node));
+    }
+}
+
+arena_t _CDECL heap_take_arena(heap_t *const heap)
+{
+    arena_t arena = heap->arena;
+
+    arena_init(&heap->arena, arena.next);
+
+    return arena;
+}
+
+void _CDECL heap_release()
+{
+    if (!_heap)
+        return;
+
+    arena_release(&_heap->arena);
+    pools_release(&_heap->pools);
+    checked_aligned_free(_heap);
+
+    _heap = NULL;
+}
+
+// Allocation Statistics
+
+#if _CALC_MEM_STATS
+
+void *_CDECL checked_malloc(size_t size)
+{
+    return checked_malloc_tag(size, MEMTAG_BASE);
+}
+
+void *_CDECL checked_calloc(size_t count, size_t size)
+{
+    return checked_calloc_tag(count, size, MEMTAG_BASE);
+}
+
+void *_CDECL checked_mallocz(size_t size)
+{
+    return checked_mallocz_tag(size, MEMTAG_BASE);
+}
+
+void *_CDECL checked_callocz(size_t count, size_t size)
+{
+    return checked_callocz_tag(count, size, MEMTAG_BASE);
+}
+
+void *_CDECL checked_realloc(void *const block, size_t size)
+{
+    return checked_realloc_tag(block, size, MEMTAG_BASE);
+}
+
+void *_CDECL checked_aligned_malloc(size_t align, size_t size)
+{
+    return checked_aligned_malloc_tag(align, size, MEMTAG_BASE);
+}
+
+void *_CDECL checked_aligned_calloc(size_t align, size_t count, size_t size)
+{
+    return checked_aligned_calloc_tag(align, count, size, MEMTAG_BASE);
+}
+
+void *_CDECL checked_aligned_mallocz(size_t align, size_t size)
+{
+    return checked_aligned_mallocz_tag(align, size, MEMTAG_BASE);
+}
+
+void *_CDECL checked_aligned_callocz(size_t align, size_t count, size_t size)
+{
+    return checked_aligned_callocz_tag(align, count, size, MEMTAG_BASE);
+}
+
+arena_t *_CDECL arena_init(arena_t *const arena, size_t chunksiz)
+{
+    return arena_init_tag(arena, chunksiz, MEMTAG_BASE);
+}
+
+pool_t *_CDECL pool_init(pool_t *const pool, size_t size)
+{
+    return pool_init_tag(pool, size, MEMTAG_BASE);
+}
+
+pools_t *_CDECL pools_init(pools_t *const pools)
+{
+    return pools_init_tag(pools, MEMTAG_BASE);
+}
+
+const memstats_t *_CDECL memstats_get(memtag_t tag)
+{
+    return (tag <= MEMTAG_COUNT) ? &_memstats[tag] : NULL;
+}
+
+int _CDECL memstats_print(FILE *const stream)
+{
+    static const char *const names[MEMTAG_COUNT + 1] =
+    {
+        "base", "lex", "ast", "parse", "eval", "total"
+    };
+
+    const memstats_t *stats;
+    char label[32];
+    size_t i, size;
+    int result;
+
+    result = fprintfn(stream, "%-8s %12s %12s %14s %14s %14s",
+                      "memory", "allocs", "frees", "bytes", "live", "peak");
+
+    for (i = 0; i <= MEMTAG_COUNT; i++)
+    {
+        stats = &_memstats[i];
+
+        result += fprintfn(stream, "%-8s %12lu %12lu %14lu %14lu %14lu", names[i],
+                           (unsigned long)stats->allocs, (unsigned long)stats->frees,
+                           (unsigned long)stats->bytes, (unsigned long)stats->live,
+                           (unsigned long)stats->peak);
+    }
+
+    stats = &_memstats[MEMTAG_COUNT];
+    result += fprintfn(stream, "%-9s %11s", "size", "allocs");
+
+    for (i = 0, size = 16; i < CALC_MEM_HIST_BINS; i++, size <<= 1)
+    {
+        if (!stats->hist[i])
+            continue;
+
+        if (i < CALC_MEM_HIST_BINS - 1)
+            sprintf(label, "<= %lu", (unsigned long)size);
+        else
+            sprintf(label, "> %lu", (unsigned long)(size >> 1));
+
+        result += fprintfn(stream, "%-9s %11lu", label, (unsigned long)stats->hist[i]);
+    }
+
+    return result;
+}
+
+#else
+
+const memstats_t *_CDECL memstats_get(memtag_t tag)
+{
+    (void)tag;
+
+    return NULL;
+}
+
+int _CDECL memstats_print(FILE *const stream)
+{
+    return fprintfn(stream, "%s", "memory statistics are not available (build with CALC_MEM_STATS)");
+}
+
+#endif // _CALC_MEM_STATS
+
 /* =------------------------------------------------------------= */
@@ -1,4 +1,464 @@
 #include "calc/base/stdout.h"
+#include "calc/base/stdthrd.h"
+
+#include <errno.h>
+
+#ifndef _WIN32
+#   include <sys/uio.h>
+#endif // _WIN32
+
+/* =---- Buffered Writers --------------------------------------= */
+
+// +---- Internal (Writers) ------------------------------------+
+
+#pragma region Internal (Writers)
+
+/// @brief Maximum number of pieces gathered by a system call.
+#define _WRITER_IOV 16
+
+static char _wstdout_buf[CALC_WRITER_BUFSIZ];
+static char _wstderr_buf[0x1000];
+
+writer_t _wstdout = {STDOUT_FILENO, NULL, _wstdout_buf, 0, sizeof(_wstdout_buf), WRITER_AUTO, FALSE};
+writer_t _wstderr = {STDERR_FILENO, NULL, _wstderr_buf, 0, sizeof(_wstderr_buf), WRITER_AUTO, FALSE};
+
+/// @brief Lock of the standard writers, held while the print
+///        functions write a message.
+static size_t _wstd_lock = 0;
+
+/// @brief Two digits for each number below 100.
+static const char _digits2[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static int _writer_sys(int fd, const char *data, size_t size)
+{
+    ssize_t n;
+
+    while (size)
+    {
+        if ((n = write(fd, data, (unsigned int)(size > 0x40000000 ? 0x40000000 : size))) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return -1;
+        }
+
+        data += n;
+        size -= (size_t)n;
+    }
+
+    return 0;
+}
+
+static int _writer_sysv(int fd, const writer_piece_t *pieces, size_t count)
+{
+#ifdef _WIN32
+    for (; count; pieces++, count--)
+        if (_writer_sys(fd, (const char *)pieces->data, pieces->size) < 0)
+            return -1;
+#else
+    struct iovec iov[_WRITER_IOV], *v = iov;
+    size_t i;
+    ssize_t n;
+
+    for (i = 0; i < count; i++)
+    {
+        iov[i].iov_base = (void *)pieces[i].data;
+        iov[i].iov_len = pieces[i].size;
+    }
+
+    /* resumes after partial writes */
+    while (count)
+    {
+        if ((n = writev(fd, v, (int)count)) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return -1;
+        }
+
+        for (; count && (size_t)n >= v->iov_len; v++, count--)
+            n -= (ssize_t)v->iov_len;
+
+        if (count)
+        {
+            v->iov_base = (char *)v->iov_base + n;
+            v->iov_len -= (size_t)n;
+        }
+    }
+#endif // _WIN32
+
+    return 0;
+}
+
+static void _writer_exit(void)
+{
+    writer_flush(wstdout);
+    writer_flush(wstderr);
+}
+
+/* the standard writers are set up on their first write */
+static void _writer_setup(writer_t *const writer)
+{
+    static bool_t registered = FALSE;
+
+    if (writer == wstdout || writer == wstderr)
+    {
+        writer->stream = (writer == wstdout) ? stdout : stderr;
+
+        if (!registered)
+            registered = !atexit(_writer_exit);
+    }
+
+    if (writer == wstderr)
+        writer->mode = WRITER_NONE;
+    else
+        writer->mode = isatty(writer->fd) ? WRITER_LINE : WRITER_FULL;
+}
+
+/* applies the flushing mode after some data was written */
+static inline void _writer_done(writer_t *const writer, const char *const data, size_t size)
+{
+    if (writer->mode == WRITER_NONE || (writer->mode == WRITER_LINE && memchr(data, '\n', size)))
+        writer_flush(writer);
+}
+
+/* formats an integer ending at end, returning its first char */
+static char *_writer_fmtu(char *end, uint64_t value)
+{
+    while (value >= 100)
+    {
+        end -= 2;
+        memcpy(end, &_digits2[(value % 100) * 2], 2);
+        value /= 100;
+    }
+
+    if (value >= 10)
+    {
+        end -= 2;
+        memcpy(end, &_digits2[value * 2], 2);
+    }
+    else
+        *--end = (char)('0' + value);
+
+    return end;
+}
+
+static inline void _writer_lock(void)
+{
+    while (!atomic_cas_size(&_wstd_lock, 0, 1))
+        thread_yield();
+}
+
+static inline void _writer_unlock(void)
+{
+    atomic_store_size(&_wstd_lock, 0);
+}
+
+#pragma endregion
+
+// +---- Internal (Writers) --------------------------- END ----+
+
+writer_t *_CDECL writer_init(writer_t *const writer, int fd, char *const buf, size_t size, writer_mode_t mode)
+{
+    writer->fd = fd;
+    writer->stream = NULL;
+    writer->buf = buf;
+    writer->len = 0;
+    writer->cap = size;
+    writer->mode = mode;
+    writer->error = FALSE;
+
+    if (mode == WRITER_AUTO)
+        _writer_setup(writer);
+
+    return writer;
+}
+
+int _CDECL writer_flush(writer_t *const writer)
+{
+    int r = 0;
+
+    if (writer->stream)
+        fflush(writer->stream);
+
+    if (writer->len)
+    {
+        if ((r = _writer_sys(writer->fd, writer->buf, writer->len)) < 0)
+            writer->error = TRUE;
+
+        writer->len = 0;
+    }
+
+    return r;
+}
+
+int _CDECL writer_write(writer_t *const writer, const void *const data, size_t size)
+{
+    writer_piece_t pieces[2];
+
+    if (writer->mode == WRITER_AUTO)
+        _writer_setup(writer);
+
+    if (size > writer->cap - writer->len)
+    {
+        if (size >= writer->cap)
+        {
+            /* too large to buffer, written along with the buffer */
+            if (writer->stream)
+                fflush(writer->stream);
+
+            pieces[0].data = writer->buf;
+            pieces[0].size = writer->len;
+            pieces[1].data = data;
+            pieces[1].size = size;
+
+            if (_writer_sysv(writer->fd, pieces, 2) < 0)
+                writer->error = TRUE;
+
+            writer->len = 0;
+
+            return (int)size;
+        }
+
+        writer_flush(writer);
+    }
+
+    memcpy(writer->buf + writer->len, data, size);
+    writer->len += size;
+
+    _writer_done(writer, (const char *)data, size);
+
+    return (int)size;
+}
+
+int _CDECL writer_writev(writer_t *const writer, const writer_piece_t *const pieces, size_t count)
+{
+    writer_piece_t batch[_WRITER_IOV];
+    size_t i, n = 0, total = 0;
+
+    if (writer->mode == WRITER_AUTO)
+        _writer_setup(writer);
+
+    for (i = 0; i < count; i++)
+        total += pieces[i].size;
+
+    if (total < writer->cap)
+    {
+        if (total > writer->cap - writer->len)
+            writer_flush(writer);
+
+        for (i = 0; i < count; i++)
+        {
+            memcpy(writer->buf + writer->len, pieces[i].data, pieces[i].size);
+            writer->len += pieces[i].size;
+        }
+
+        _writer_done(writer, writer->buf + writer->len - total, total);
+
+        return (int)total;
+    }
+
+    if (writer->stream)
+        fflush(writer->stream);
+
+    if (writer->len)
+    {
+        batch[n].data = writer->buf;
+        batch[n++].size = writer->len;
+        writer->len = 0;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        batch[n++] = pieces[i];
+
+        if (n == _WRITER_IOV || i + 1 == count)
+        {
+            if (_writer_sysv(writer->fd, batch, n) < 0)
+                writer->error = TRUE;
+
+            n = 0;
+        }
+    }
+
+    return (int)total;
+}
+
+int _CDECL _writer_putc(writer_t *const writer, int ch)
+{
+    char c = (char)ch;
+
+    if (writer->mode == WRITER_AUTO)
+        _writer_setup(writer);
+
+    if (writer->len == writer->cap)
+        writer_flush(writer);
+
+    writer->buf[writer->len++] = c;
+
+    _writer_done(writer, &c, 1);
+
+    return 1;
+}
+
+#if !_CALC_BUILD_INLINES
+
+int _CDECL writer_putc(writer_t *const writer, int ch)
+{
+    return (writer->mode == WRITER_FULL && writer->len < writer->cap)
+        ? (writer->buf[writer->len++] = (char)ch, 1)
+        : _writer_putc(writer, ch);
+}
+
+int _CDECL writer_puts(writer_t *const writer, const char *const str)
+{
+    return writer_write(writer, str, strlen(str));
+}
+
+#endif // _CALC_BUILD_INLINES
+
+int _CDECL writer_putu(writer_t *const writer, uint64_t value)
+{
+    char buf[20], *p = _writer_fmtu(buf + sizeof(buf), value);
+
+    return writer_write(writer, p, (size_t)(buf + sizeof(buf) - p));
+}
+
+int _CDECL writer_puti(writer_t *const writer, int64_t value)
+{
+    char buf[21], *p;
+
+    /* the magnitude of INT64_MIN only fits unsigned */
+    p = _writer_fmtu(buf + sizeof(buf), value < 0 ? 0 - (uint64_t)value : (uint64_t)value);
+
+    if (value < 0)
+        *--p = '-';
+
+    return writer_write(writer, p, (size_t)(buf + sizeof(buf) - p));
+}
+
+int _CDECL writer_putx(writer_t *const writer, uint64_t value)
+{
+    char buf[16], *p = buf + sizeof(buf);
+
+    do
+        *--p = "0123456789abcdef"[value & 0xF];
+    while (value >>= 4);
+
+    return writer_write(writer, p, (size_t)(buf + sizeof(buf) - p));
+}
+
+int _CDECL writer_vprintf(writer_t *const writer, const char *const format, va_list arglist)
+{
+    size_t avail;
+    va_list retry;
+    char *tmp;
+    int r;
+
+    if (writer->mode == WRITER_AUTO)
+        _writer_setup(writer);
+
+    avail = writer->cap - writer->len;
+
+    /* formats in place, after a flush if it did not fit */
+    va_copy(retry, arglist);
+    r = vsnprintf(writer->buf + writer->len, avail, format, arglist);
+
+    if (r >= 0 && (size_t)r >= avail)
+    {
+        if ((size_t)r < writer->cap)
+        {
+            writer_flush(writer);
+            vsnprintf(writer->buf, writer->cap, format, retry);
+        }
+        else
+        {
+            if ((tmp = (char *)malloc((size_t)r + 1)) != NULL)
+            {
+                vsnprintf(tmp, (size_t)r + 1, format, retry);
+                writer_write(writer, tmp, (size_t)r);
+                free(tmp);
+            }
+            else
+                r = -1;
+
+            va_end(retry);
+
+            return r;
+        }
+    }
+
+    va_end(retry);
+
+    if (r > 0)
+    {
+        writer->len += (size_t)r;
+        _writer_done(writer, writer->buf + writer->len - r, (size_t)r);
+    }
+
+    return r;
+}
+
+int _CDECL writer_printf(writer_t *const writer, const char *const format, ...)
+{
+    va_list arglist;
+    int r;
+
+    va_start(arglist, format);
+    r = writer_vprintf(writer, format, arglist);
+    va_end(arglist);
+
+    return r;
+}
+
+int _CDECL _stdout_wputs(writer_t *const writer, const char *const message, bool_t line)
+{
+    int r;
+
+    _writer_lock();
+    r = writer_puts(writer, message);
+
+    if (line)
+        r += writer_putc(writer, '\n');
+
+    _writer_unlock();
+
+    return r;
+}
+
+int _CDECL _stdout_wvprintf(writer_t *const writer, bool_t line, const char *const format, va_list arglist)
+{
+    int r;
+
+    _writer_lock();
+    r = writer_vprintf(writer, format, arglist);
+
+    if (line)
+        r += writer_putc(writer, '\n');
+
+    _writer_unlock();
+
+    return r;
+}
+
+int _CDECL _stdout_wprintf(writer_t *const writer, bool_t line, const char *const format, ...)
+{
+    va_list arglist;
+    int r;
+
+    va_start(arglist, format);
+    r = _stdout_wvprintf(writer, line, format, arglist);
+    va_end(arglist);
+
+    return r;
+}
+
+/* =------------------------------------------------------------= */
 
 /* =---- Common Output Functions -------------------------------= */
 
@@ -0,0 +1,921 @@
+#include "calc/base/stdstr.h"
+#include "calc/base/stdthrd.h"
+
+/* =---- String Operations -------------------------------------= */
+
+// +---- Internal (Hashing) ------------------------------------+
+
+#pragma region Internal (Hashing)
+
+#define _HASH_K1 UINT64_C(0x9E3779B97F4A7C15)
+#define _HASH_K2 UINT64_C(0xBF58476D1CE4E5B9)
+#define _HASH_K3 UINT64_C(0x94D049BB133111EB)
+
+static inline uint64_t _read64(const byte_t *const p)
+{
+    uint64_t v;
+
+    memcpy(&v, p, sizeof(v));
+
+    return v;
+}
+
+static inline uint64_t _readtail(const byte_t *const p, size_t len)
+{
+    uint64_t v = 0;
+
+    while (len--)
+        v = (v << 8) | p[len];
+
+    return v;
+}
+
+#pragma endregion
+
+// +---- Internal (Hashing) --------------------------- END ----+
+
+uint64_t _CDECL strhash(const char *const str, size_t len)
+{
+    const byte_t *p = (const byte_t *)str;
+    uint64_t h = (uint64_t)len * _HASH_K1;
+
+    for (; len >= 8; len -= 8, p += 8)
+    {
+        h = (h ^ _read64(p)) * _HASH_K2;
+        h ^= h >> 31;
+    }
+
+    h = (h ^ _readtail(p, len)) * _HASH_K2;
+    h ^= h >> 30;
+    h *= _HASH_K3;
+    h ^= h >> 31;
+
+    return h;
+}
+
+// Case Conversion and Comparison
+
+// +---- Internal (Case Conversion) ----------------------------+
+
+#pragma region Internal (Case Conversion)
+
+/// @brief Below this length the operations are done inline.
+#define _STR_SHORT 16
+
+#define _SWAR_ONES UINT64_C(0x0101010101010101)
+#define _SWAR_HIGH UINT64_C(0x8080808080808080)
+
+#define _asclow(c) ((char)((unsigned char)((c) - 'A') < 26 ? (c) | 0x20 : (c)))
+#define _ascupp(c) ((char)((unsigned char)((c) - 'a') < 26 ? (c) & ~0x20 : (c)))
+
+static inline void _write64(byte_t *const p, uint64_t v)
+{
+    memcpy(p, &v, sizeof(v));
+}
+
+/* marks with 0x20 the bytes of word between first and first + 25 */
+static inline uint64_t _swar_range(uint64_t word, unsigned char first)
+{
+    uint64_t low = word & ~_SWAR_HIGH;
+    uint64_t ge = low + (0x80 - first) * _SWAR_ONES;
+    uint64_t gt = low + (0x80 - first - 26) * _SWAR_ONES;
+
+    return (~word & (ge ^ gt) & _SWAR_HIGH) >> 2;
+}
+
+static void _scalar_lower(char *const dst, const char *const src, size_t len)
+{
+    size_t i = 0;
+
+    for (; i + 8 <= len; i += 8)
+    {
+        uint64_t word = _read64((const byte_t *)src + i);
+
+        _write64((byte_t *)dst + i, word | _swar_range(word, 'A'));
+    }
+
+    for (; i < len; i++)
+        dst[i] = _asclow(src[i]);
+}
+
+static void _scalar_upper(char *const dst, const char *const src, size_t len)
+{
+    size_t i = 0;
+
+    for (; i + 8 <= len; i += 8)
+    {
+        uint64_t word = _read64((const byte_t *)src + i);
+
+        _write64((byte_t *)dst + i, word ^ _swar_range(word, 'a'));
+    }
+
+    for (; i < len; i++)
+        dst[i] = _ascupp(src[i]);
+}
+
+static bool_t _scalar_eq(const char *const str1, const char *const str2, size_t len)
+{
+    return !memcmp(str1, str2, len);
+}
+
+static bool_t _scalar_iq(const char *const str1, const char *const str2, size_t len)
+{
+    size_t i = 0;
+
+    for (; i + 8 <= len; i += 8)
+    {
+        uint64_t word1 = _read64((const byte_t *)str1 + i);
+        uint64_t word2 = _read64((const byte_t *)str2 + i);
+
+        if (word1 != word2 && (word1 | _swar_range(word1, 'A')) != (word2 | _swar_range(word2, 'A')))
+            return FALSE;
+    }
+
+    for (; i < len; i++)
+        if (_asclow(str1[i]) != _asclow(str2[i]))
+            return FALSE;
+
+    return TRUE;
+}
+
+static const char *_scalar_chr(const char *const str, int ch, size_t len)
+{
+    return (const char *)memchr(str, ch, len);
+}
+
+#pragma endregion
+
+// +---- Internal (Case Conversion) ------------------- END ----+
+
+#if _CALC_SSE2
+
+#include <emmintrin.h>
+
+// +---- Internal (SSE2) ---------------------------------------+
+
+#pragma region Internal (SSE2)
+
+#define _sse2_load(p) _mm_loadu_si128((const __m128i *)(p))
+#define _sse2_store(p, v) _mm_storeu_si128((__m128i *)(p), (v))
+
+/* marks with 0x20 the bytes of v between first and first + 25 */
+static inline __m128i _sse2_range(__m128i v, char first)
+{
+    __m128i t = _mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - first)));
+
+    return _mm_and_si128(_mm_cmplt_epi8(t, _mm_set1_epi8((char)(0x80 + 26))), _mm_set1_epi8(0x20));
+}
+
+#define _sse2_lower(v) _mm_or_si128((v), _sse2_range((v), 'A'))
+#define _sse2_upper(v) _mm_xor_si128((v), _sse2_range((v), 'a'))
+
+/* the last block of each loop overlaps the previous one, all
+   the operations are idempotent so no scalar tail is needed */
+
+static void _sse2_lower_n(char *const dst, const char *const src, size_t len)
+{
+    size_t i;
+
+    if (len < 16)
+    {
+        _scalar_lower(dst, src, len);
+        return;
+    }
+
+    for (i = 0; i + 16 <= len; i += 16)
+        _sse2_store(dst + i, _sse2_lower(_sse2_load(src + i)));
+
+    if (i < len)
+        _sse2_store(dst + len - 16, _sse2_lower(_sse2_load(src + len - 16)));
+}
+
+static void _sse2_upper_n(char *const dst, const char *const src, size_t len)
+{
+    size_t i;
+
+    if (len < 16)
+    {
+        _scalar_upper(dst, src, len);
+        return;
+    }
+
+    for (i = 0; i + 16 <= len; i += 16)
+        _sse2_store(dst + i, _sse2_upper(_sse2_load(src + i)));
+
+    if (i < len)
+        _sse2_store(dst + len - 16, _sse2_upper(_sse2_load(src + len - 16)));
+}
+
+static bool_t _sse2_eq(const char *const str1, const char *const str2, size_t len)
+{
+    size_t i;
+
+    if (len < 16)
+        return _scalar_eq(str1, str2, len);
+
+    for (i = 0; i + 16 <= len; i += 16)
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_sse2_load(str1 + i), _sse2_load(str2 + i))) != 0xFFFF)
+            return FALSE;
+
+    i = len - 16;
+
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_sse2_load(str1 + i), _sse2_load(str2 + i))) == 0xFFFF;
+}
+
+static bool_t _sse2_iq(const char *const str1, const char *const str2, size_t len)
+{
+    __m128i v1, v2;
+    size_t i;
+
+    if (len < 16)
+        return _scalar_iq(str1, str2, len);
+
+    for (i = 0;; i += 16)
+    {
+        if (i + 16 > len)
+            i = len - 16;
+
+        v1 = _sse2_load(str1 + i);
+        v2 = _sse2_load(str2 + i);
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_sse2_lower(v1), _sse2_lower(v2))) != 0xFFFF)
+            return FALSE;
+
+        if (i + 16 == len)
+            return TRUE;
+    }
+}
+
+static const char *_sse2_chr(const char *const str, int ch, size_t len)
+{
+    __m128i needle = _mm_set1_epi8((char)ch);
+    unsigned int mask;
+    size_t i;
+
+    if (len < 16)
+        return _scalar_chr(str, ch, len);
+
+    for (i = 0;; i += 16)
+    {
+        if (i + 16 > len)
+            i = len - 16;
+
+        mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_sse2_load(str + i), needle));
+
+        if (mask)
+            return str + i + _ctz32(mask);
+
+        if (i + 16 == len)
+            return NULL;
+    }
+}
+
+#pragma endregion
+
+// +---- Internal (SSE2) ------------------------------ END ----+
+
+#endif // _CALC_SSE2
+
+#if _CALC_AVX2
+
+#include <immintrin.h>
+
+// +---- Internal (AVX2) ---------------------------------------+
+
+#pragma region Internal (AVX2)
+
+#define _avx2_load(p) _mm256_loadu_si256((const __m256i *)(p))
+#define _avx2_store(p, v) _mm256_storeu_si256((__m256i *)(p), (v))
+
+/* marks with 0x20 the bytes of v between first and first + 25 */
+static inline _TARGET("avx2") __m256i _avx2_range(__m256i v, char first)
+{
+    __m256i t = _mm256_add_epi8(v, _mm256_set1_epi8((char)(0x80 - first)));
+
+    return _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + 26)), t), _mm256_set1_epi8(0x20));
+}
+
+#define _avx2_lower(v) _mm256_or_si256((v), _avx2_range((v), 'A'))
+#define _avx2_upper(v) _mm256_xor_si256((v), _avx2_range((v), 'a'))
+
+static _TARGET("avx2") void _avx2_lower_n(char *const dst, const char *const src, size_t len)
+{
+    size_t i;
+
+    if (len < 32)
+    {
+        _sse2_lower_n(dst, src, len);
+        return;
+    }
+
+    for (i = 0; i + 32 <= len; i += 32)
+        _avx2_store(dst + i, _avx2_lower(_avx2_load(src + i)));
+
+    if (i < len)
+        _avx2_store(dst + len - 32, _avx2_lower(_avx2_load(src + len - 32)));
+}
+
+static _TARGET("avx2") void _avx2_upper_n(char *const dst, const char *const src, size_t len)
+{
+    size_t i;
+
+    if (len < 32)
+    {
+        _sse2_upper_n(dst, src, len);
+        return;
+    }
+
+    for (i = 0; i + 32 <= len; i += 32)
+        _avx2_store(dst + i, _avx2_upper(_avx2_load(src + i)));
+
+    if (i < len)
+        _avx2_store(dst + len - 32, _avx2_upper(_avx2_load(src + len - 32)));
+}
+
+static _TARGET("avx2") bool_t _avx2_eq(const char *const str1, const char *const str2, size_t len)
+{
+    size_t i;
+
+    if (len < 32)
+        return _sse2_eq(str1, str2, len);
+
+    for (i = 0; i + 32 <= len; i += 32)
+        if (~_mm256_movemask_epi8(_mm256_cmpeq_epi8(_avx2_load(str1 + i), _avx2_load(str2 + i))))
+            return FALSE;
+
+    i = len - 32;
+
+    return !~_mm256_movemask_epi8(_mm256_cmpeq_epi8(_avx2_load(str1 + i), _avx2_load(str2 + i)));
+}
+
+static _TARGET("avx2") bool_t _avx2_iq(const char *const str1, const char *const str2, size_t len)
+{
+    __m256i v1, v2;
+    size_t i;
+
+    if (len < 32)
+        return _sse2_iq(str1, str2, len);
+
+    for (i = 0;; i += 32)
+    {
+        if (i + 32 > len)
+            i = len - 32;
+
+        v1 = _avx2_load(str1 + i);
+        v2 = _avx2_load(str2 + i);
+
+        if (~_mm256_movemask_epi8(_mm256_cmpeq_epi8(_avx2_lower(v1), _avx2_lower(v2))))
+            return FALSE;
+
+        if (i + 32 == len)
+            return TRUE;
+    }
+}
+
+static _TARGET("avx2") const char *_avx2_chr(const char *const str, int ch, size_t len)
+{
+    __m256i needle = _mm256_set1_epi8((char)ch);
+    unsigned int mask;
+    size_t i;
+
+    if (len < 32)
+        return _sse2_chr(str, ch, len);
+
+    for (i = 0;; i += 32)
+    {
+        if (i + 32 > len)
+            i = len - 32;
+
+        mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_avx2_load(str + i), needle));
+
+        if (mask)
+            return str + i + _ctz32(mask);
+
+        if (i + 32 == len)
+            return NULL;
+    }
+}
+
+#pragma endregion
+
+// +---- Internal (AVX2) ------------------------------ END ----+
+
+#endif // _CALC_AVX2
+
+// +---- Internal (Dispatch) -----------------------------------+
+
+#pragma region Internal (Dispatch)
+
+/// @brief Implementations of the string operations for an
+///        instruction set.
+typedef struct _strops
+{
+    const char *isa;
+    void (*lower)(char *const dst, const char *const src, size_t len);
+    void (*upper)(char *const dst, const char *const src, size_t len);
+    bool_t (*eq)(const char *const str1, const char *const str2, size_t len);
+    bool_t (*iq)(const char *const str1, const char *const str2, size_t len);
+    const char *(*chr)(const char *const str, int ch, size_t len);
+} strops_t;
+
+static const strops_t _strops_scalar = {
+    "scalar", _scalar_lower, _scalar_upper, _scalar_eq, _scalar_iq, _scalar_chr};
+
+#if _CALC_SSE2
+static const strops_t _strops_sse2 = {
+    "sse2", _sse2_lower_n, _sse2_upper_n, _sse2_eq, _sse2_iq, _sse2_chr};
+#endif // _CALC_SSE2
+
+#if _CALC_AVX2
+static const strops_t _strops_avx2 = {
+    "avx2", _avx2_lower_n, _avx2_upper_n, _avx2_eq, _avx2_iq, _avx2_chr};
+#endif // _CALC_AVX2
+
+static const strops_t *_strops_sel = NULL;
+
+static const strops_t *_strops_select()
+{
+    const strops_t *ops = &_strops_scalar;
+
+#if _CALC_AVX2
+    if (cpuhas(CPU_AVX2))
+        ops = &_strops_avx2;
+    else
+#endif // _CALC_AVX2
+#if _CALC_SSE2
+    if (cpuhas(CPU_SSE2))
+        ops = &_strops_sse2;
+#endif // _CALC_SSE2
+
+    atomic_store_ptr(&_strops_sel, ops);
+
+    return ops;
+}
+
+/// @brief Gets the string operations of the processor, selecting
+///        them on the first call.
+static inline const strops_t *_strops()
+{
+    const strops_t *ops = (const strops_t *)atomic_load_ptr(&_strops_sel);
+
+    return ops ? ops : _strops_select();
+}
+
+#pragma endregion
+
+// +---- Internal (Dispatch) -------------------------- END ----+
+
+char *_CDECL strnget(char *const dst, const char *const src, size_t count)
+{
+    char *r = dst ? dst : dim(char, count + 1);
+
+    if (src && count)
+        memcpy(r, src, count);
+    else if (count)
+        r[0] = NUL;
+
+    r[count] = NUL;
+
+    return r;
+}
+
+char *_CDECL strnlow(char *const dst, const char *const src, size_t count)
+{
+    char *r;
+
+    if (!src)
+        return strnget(dst, (const char *)NULL, count);
+
+    /* the destination is not touched before the conversion, it can
+       be the source */
+    r = dst ? dst : dim(char, count + 1);
+
+    if (count < _STR_SHORT)
+        _scalar_lower(r, src, count);
+    else
+        _strops()->lower(r, src, count);
+
+    r[count] = NUL;
+
+    return r;
+}
+
+char *_CDECL strnupp(char *const dst, const char *const src, size_t count)
+{
+    char *r;
+
+    if (!src)
+        return strnget(dst, (const char *)NULL, count);
+
+    /* the destination is not touched before the conversion, it can
+       be the source */
+    r = dst ? dst : dim(char, count + 1);
+
+    if (count < _STR_SHORT)
+        _scalar_upper(r, src, count);
+    else
+        _strops()->upper(r, src, count);
+
+    r[count] = NUL;
+
+    return r;
+}
+
+char *_CDECL strget(char *const dst, const char *const src)
+{
+    return strnget(dst, src, src ? strlen(src) : 0);
+}
+
+char *_CDECL strlow(char *const dst, const char *const src)
+{
+    return src ? strnlow(dst, src, strlen(src)) : dst;
+}
+
+char *_CDECL strupp(char *const dst, const char *const src)
+{
+    return src ? strnupp(dst, src, strlen(src)) : dst;
+}
+
+bool_t _CDECL strneq(const char *const str1, const char *const str2, size_t len)
+{
+    if (len < _STR_SHORT)
+        return _scalar_eq(str1, str2, len);
+
+    return _strops()->eq(str1, str2, len);
+}
+
+bool_t _CDECL strniq(const char *const str1, const char *const str2, size_t len)
+{
+    if (len < _STR_SHORT)
+        return _scalar_iq(str1, str2, len);
+
+    return _strops()->iq(str1, str2, len);
+}
+
+const char *_CDECL strnchr(const char *const str, int ch, size_t len)
+{
+    if (len < _STR_SHORT)
+        return _scalar_chr(str, ch, len);
+
+    return _strops()->chr(str, ch, len);
+}
+
+bool_t _CDECL streq(const char *const str1, const char *const str2)
+{
+    size_t len;
+
+    if (str1 == str2)
+        return TRUE;
+
+    if (!str1 || !str2)
+        return FALSE;
+
+    len = strlen(str1);
+
+    return len == strlen(str2) && strneq(str1, str2, len);
+}
+
+bool_t _CDECL striq(const char *const str1, const char *const str2)
+{
+    size_t len;
+
+    if (str1 == str2)
+        return TRUE;
+
+    if (!str1 || !str2)
+        return FALSE;
+
+    len = strlen(str1);
+
+    return len == strlen(str2) && strniq(str1, str2, len);
+}
+
+const char *_CDECL strisa()
+{
+    return _strops()->isa;
+}
+
+bool_t _CDECL strsetisa(const char *const isa)
+{
+    const strops_t *ops = NULL;
+
+    if (!strcmp(isa, _strops_scalar.isa))
+        ops = &_strops_scalar;
+#if _CALC_SSE2
+    else if (!strcmp(isa, _strops_sse2.isa) && cpuhas(CPU_SSE2))
+        ops = &_strops_sse2;
+#endif // _CALC_SSE2
+#if _CALC_AVX2
+    else if (!strcmp(isa, _strops_avx2.isa) && cpuhas(CPU_AVX2))
+        ops = &_strops_avx2;
+#endif // _CALC_AVX2
+
+    if (!ops)
+        return FALSE;
+
+    atomic_store_ptr(&_strops_sel, ops);
+
+    return TRUE;
+}
+
+// String Views
+
+// +---- Internal (String Views) -------------------------------+
+
+#pragma region Internal (String Views)
+
+/// @brief Longest number parsed from a local buffer.
+#define _STRV_NUMBUF 64
+
+static inline unsigned int _digit(char c)
+{
+    if (c >= '0' && c <= '9')
+        return (unsigned int)(c - '0');
+
+    c = _asclow(c);
+
+    return (c >= 'a' && c <= 'z') ? (unsigned int)(c - 'a' + 10) : 36;
+}
+
+#pragma endregion
+
+// +---- Internal (String Views) ---------------------- END ----+
+
+strv_t _CDECL strv(const char *const ptr, size_t len)
+{
+    strv_t view;
+
+    view.ptr = ptr;
+    view.len = len;
+
+    return view;
+}
+
+strv_t _CDECL strv_cstr(const char *const cstr)
+{
+    return strv(cstr ? cstr : "", cstr ? strlen(cstr) : 0);
+}
+
+strv_t _CDECL strv_sub(strv_t view, size_t start, size_t len)
+{
+    if (start > view.len)
+        start = view.len;
+
+    if (len > view.len - start)
+        len = view.len - start;
+
+    return strv(view.ptr + start, len);
+}
+
+char *_CDECL strv_dup(strv_t view)
+{
+    return strnget(NULL, view.ptr, view.len);
+}
+
+#if !_CALC_BUILD_INLINES
+
+bool_t _CDECL strv_eq(strv_t view1, strv_t view2)
+{
+    return view1.len == view2.len && strneq(view1.ptr, view2.ptr, view1.len);
+}
+
+bool_t _CDECL strv_iq(strv_t view1, strv_t view2)
+{
+    return view1.len == view2.len && strniq(view1.ptr, view2.ptr, view1.len);
+}
+
+bool_t _CDECL strv_eqc(strv_t view, const char *const cstr)
+{
+    return strlen(cstr) == view.len && strneq(view.ptr, cstr, view.len);
+}
+
+bool_t _CDECL strv_prefix(strv_t view, strv_t prefix)
+{
+    return view.len >= prefix.len && strneq(view.ptr, prefix.ptr, prefix.len);
+}
+
+bool_t _CDECL strv_suffix(strv_t view, strv_t suffix)
+{
+    return view.len >= suffix.len && strneq(view.ptr + view.len - suffix.len, suffix.ptr, suffix.len);
+}
+
+uint64_t _CDECL strv_hash(strv_t view)
+{
+    return strhash(view.ptr, view.len);
+}
+
+#endif // _CALC_BUILD_INLINES
+
+int _CDECL strv_cmp(strv_t view1, strv_t view2)
+{
+    int r = memcmp(view1.ptr, view2.ptr, view1.len < view2.len ? view1.len : view2.len);
+
+    if (r)
+        return r;
+
+    return (view1.len > view2.len) - (view1.len < view2.len);
+}
+
+size_t _CDECL strv_chr(strv_t view, int ch)
+{
+    const char *p = strnchr(view.ptr, ch, view.len);
+
+    return p ? (size_t)(p - view.ptr) : view.len;
+}
+
+bool_t _CDECL strv_toi(strv_t view, int64_t *const value)
+{
+    const char *p = view.ptr, *end = view.ptr + view.len, *q;
+    uint64_t r = 0, limit = (uint64_t)INT64_MAX;
+    unsigned int base = 10, d;
+    bool_t neg = FALSE;
+
+    if (p < end && (*p == '+' || *p == '-'))
+    {
+        neg = (*p++ == '-');
+        limit += neg;
+    }
+
+    /* the radix follows one or more zeros, as in the literals */
+    for (q = p; q < end && *q == '0'; q++)
+        continue;
+
+    if (q > p && end - q > 1)
+    {
+        switch (_asclow(*q))
+        {
+        case 'b':
+            base = 2;
+            break;
+        case 'c':
+            base = 8;
+            break;
+        case 'd':
+            base = 10;
+            break;
+        case 'x':
+            base = 16;
+            break;
+        default:
+            q = p;
+            break;
+        }
+
+        if (q > p)
+            p = q + 1;
+    }
+
+    if (p == end)
+        return FALSE;
+
+    for (; p < end; p++)
+    {
+        if ((d = _digit(*p)) >= base || r > (limit - d) / base)
+            return FALSE;
+
+        r = r * base + d;
+    }
+
+    /* the magnitude of INT64_MIN does not fit in int64_t */
+    *value = neg ? (int64_t)(0 - r) : (int64_t)r;
+
+    return TRUE;
+}
+
+bool_t _CDECL strv_tof(strv_t view, double *const value)
+{
+    char buf[_STRV_NUMBUF], *str, *end;
+    scratch_mark_t mark;
+    bool_t r;
+
+    if (!view.len || (_digit(view.ptr[0]) > 9 && !strchr("+-.", view.ptr[0])))
+        return FALSE;
+
+    if (view.len < _STRV_NUMBUF)
+        str = buf;
+    else
+    {
+        mark = scratch_push();
+        str = (char *)scratch_malloc(view.len + 1);
+    }
+
+    strnget(str, view.ptr, view.len);
+
+    *value = strtod(str, &end);
+    r = (end == str + view.len);
+
+    if (str != buf)
+        scratch_pop(mark);
+
+    return r;
+}
+
+// String Interning
+
+// +---- Internal (String Tables) ------------------------------+
+
+#pragma region Internal (String Tables)
+
+/// @brief Maximum load of a string table (numerator over 4).
+#define _STRTAB_LOAD 3
+
+static void _strtab_grow(strtab_t *const tab)
+{
+    strtab_slot_t *old = tab->slots, *slot;
+    size_t i, size = tab->mask + 1;
+
+    tab->slots = dimz(strtab_slot_t, size * 2);
+    tab->mask = size * 2 - 1;
+
+    for (i = 0; i < size; i++)
+    {
+        if (!old[i].str)
+            continue;
+
+        for (slot = &tab->slots[old[i].hash & tab->mask]; slot->str;)
+            slot = &tab->slots[(slot - tab->slots + 1) & tab->mask];
+
+        *slot = old[i];
+    }
+
+    checked_free(old);
+}
+
+static inline strtab_slot_t *_strtab_probe(const strtab_t *const tab, const char *const str, size_t len, uint32_t hash)
+{
+    strtab_slot_t *slot;
+    size_t i = hash & tab->mask;
+
+    for (;; i = (i + 1) & tab->mask)
+    {
+        slot = &tab->slots[i];
+
+        if (!slot->str || (slot->hash == hash && slot->len == len && !memcmp(slot->str, str, len)))
+            return slot;
+    }
+}
+
+#pragma endregion
+
+// +---- Internal (String Tables) --------------------- END ----+
+
+strtab_t *_CDECL strtab_init(strtab_t *const tab, size_t capacity)
+{
+    size_t size = 16;
+
+    while (size * _STRTAB_LOAD / 4 < capacity)
+        size *= 2;
+
+    tab->slots = dimz(strtab_slot_t, size);
+    tab->mask = size - 1;
+    tab->count = 0;
+
+    arena_init(&tab->arena, 0);
+
+    return tab;
+}
+
+istr_t _CDECL strtab_intern(strtab_t *const tab, const char *const str, size_t len)
+{
+    uint32_t hash = (uint32_t)strhash(str, len);
+    strtab_slot_t *slot = _strtab_probe(tab, str, len, hash);
+    istr_hdr_t *hdr;
+    char *text;
+
+    if (slot->str)
+        return slot->str;
+
+    hdr = (istr_hdr_t *)arena_malloc(&tab->arena, sizeof(istr_hdr_t) + len + 1);
+    hdr->hash = hash;
+    hdr->len = (uint32_t)len;
+
+    text = (char *)(hdr + 1);
+    memcpy(text, str, len);
+    text[len] = NUL;
+
+    slot->hash = hash;
+    slot->len = (uint32_t)len;
+    slot->str = text;
+
+    if (++tab->count > (tab->mask + 1) * _STRTAB_LOAD / 4)
+        _strtab_grow(tab);
+
+    return text;
+}
+
+istr_t _CDECL strtab_find(const strtab_t *const tab, const char *const str, size_t len)
+{
+    return _strtab_probe(tab, str, len, (uint32_t)strhash(str, len))->str;
+}
+
+void _CDECL strtab_release(strtab_t *const tab)
+{
+    checked_free(tab->slots);
+    arena_release(&tab->arena);
+
+    tab->slots = NULL;
+    tab->mask = 0;
+    tab->count = 0;
+}
+
+/* =------------------------------------------------------------= */
@@ -0,0 +1,421 @@
+#include "calc/base/stdtab.h"
+
+#if _CALC_SSE2
+#   include <emmintrin.h>
+#endif // _CALC_SSE2
+
+/* =---- Hash Tables -------------------------------------------= */
+
+// +---- Internal (Groups) -------------------------------------+
+
+#pragma region Internal (Groups)
+
+/// @brief Control byte of an empty slot, the full ones hold the
+///        7 low bits of the hash.
+#define _CTRL_EMPTY 0x80
+
+#if _CALC_SSE2
+
+/* bit i is set if the control byte i matches */
+static inline unsigned int _group_match(const byte_t *const ctrl, byte_t h2)
+{
+    __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+
+    return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)h2)));
+}
+
+/* bit i is set if the slot i is empty */
+static inline unsigned int _group_empty(const byte_t *const ctrl)
+{
+    return (unsigned int)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+}
+
+#else
+
+#define _SWAR_ONES UINT64_C(0x0101010101010101)
+#define _SWAR_HIGH UINT64_C(0x8080808080808080)
+
+/* gathers the high bit of each byte in the low byte */
+#define _swar_bits(word) ((unsigned int)((((word) & _SWAR_HIGH) * UINT64_C(0x0002040810204081)) >> 56))
+
+static inline uint64_t _group_word(const byte_t *const ctrl)
+{
+    uint64_t word;
+
+    memcpy(&word, ctrl, sizeof(word));
+
+    return word;
+}
+
+/* it can report a false match above a true one, the keys are
+   compared anyway */
+static inline unsigned int _group_match(const byte_t *const ctrl, byte_t h2)
+{
+    uint64_t lo = _group_word(ctrl) ^ (h2 * _SWAR_ONES);
+    uint64_t hi = _group_word(ctrl + 8) ^ (h2 * _SWAR_ONES);
+
+    lo = (lo - _SWAR_ONES) & ~lo;
+    hi = (hi - _SWAR_ONES) & ~hi;
+
+    return _swar_bits(lo) | (_swar_bits(hi) << 8);
+}
+
+static inline unsigned int _group_empty(const byte_t *const ctrl)
+{
+    return _swar_bits(_group_word(ctrl)) | (_swar_bits(_group_word(ctrl + 8)) << 8);
+}
+
+#endif // _CALC_SSE2
+
+#pragma endregion
+
+// +---- Internal (Groups) ---------------------------- END ----+
+
+// +---- Internal (Hash Tables) --------------------------------+
+
+#pragma region Internal (Hash Tables)
+
+#define _tab_slot(tab, index) ((tab)->slots + (index) * (tab)->slotsiz)
+#define _tab_hash(tab, key) ((tab)->hash ? (tab)->hash(key) : strhash((const char *)(key), (tab)->keysiz))
+#define _tab_eq(tab, key1, key2) ((tab)->eq ? (tab)->eq((key1), (key2)) : !memcmp((key1), (key2), (tab)->keysiz))
+
+/* the low 7 bits go in the control byte, the others choose the slot */
+#define _tab_h2(hash) ((byte_t)((hash) & 0x7F))
+#define _tab_h1(hash) ((uint32_t)((hash) >> 7))
+
+static inline void _tab_setctrl(tab_t *const tab, size_t index, byte_t ctrl)
+{
+    tab->ctrl[index] = ctrl;
+
+    /* the first group is mirrored after the last slot */
+    if (index < CALC_TAB_GROUP - 1)
+        tab->ctrl[tab->mask + 1 + index] = ctrl;
+}
+
+static void _tab_alloc(tab_t *const tab, size_t capacity)
+{
+    tab->ctrl = dim(byte_t, capacity + CALC_TAB_GROUP - 1);
+    tab->slots = (byte_t *)checked_malloc(capacity * tab->slotsiz);
+    tab->hashes = dim(uint32_t, capacity);
+    tab->mask = capacity - 1;
+
+    memset(tab->ctrl, _CTRL_EMPTY, capacity + CALC_TAB_GROUP - 1);
+}
+
+/* finds the slot of a key, or the empty slot where it goes */
+static size_t _tab_probe(const tab_t *const tab, const void *const key, uint64_t hash, bool_t *const found)
+{
+    size_t pos = _tab_h1(hash) & tab->mask, index;
+    byte_t h2 = _tab_h2(hash);
+    unsigned int match, empty;
+
+    for (;; pos = (pos + CALC_TAB_GROUP) & tab->mask)
+    {
+        for (match = _group_match(tab->ctrl + pos, h2); match; match &= match - 1)
+        {
+            index = (pos + _ctz32(match)) & tab->mask;
+
+            if (_tab_eq(tab, key, _tab_slot(tab, index)))
+            {
+                *found = TRUE;
+                return index;
+            }
+        }
+
+        /* a key is never past an empty slot (linear probing) */
+        if ((empty = _group_empty(tab->ctrl + pos)) != 0)
+        {
+            *found = FALSE;
+            return (pos + _ctz32(empty)) & tab->mask;
+        }
+    }
+}
+
+static void _tab_grow(tab_t *const tab)
+{
+    byte_t *ctrl = tab->ctrl, *slots = tab->slots;
+    uint32_t *hashes = tab->hashes;
+    size_t i, pos, size = tab->mask + 1;
+    unsigned int empty;
+
+    _tab_alloc(tab, size * 2);
+
+    for (i = 0; i < size; i++)
+    {
+        if (ctrl[i] == _CTRL_EMPTY)
+            continue;
+
+        /* the keys are distinct, only an empty slot is needed */
+        for (pos = hashes[i] & tab->mask; !(empty = _group_empty(tab->ctrl + pos));)
+            pos = (pos + CALC_TAB_GROUP) & tab->mask;
+
+        pos = (pos + _ctz32(empty)) & tab->mask;
+
+        _tab_setctrl(tab, pos, ctrl[i]);
+        tab->hashes[pos] = hashes[i];
+        memcpy(_tab_slot(tab, pos), slots + i * tab->slotsiz, tab->slotsiz);
+    }
+
+    checked_free(hashes);
+    checked_free(slots);
+    checked_free(ctrl);
+}
+
+#pragma endregion
+
+// +---- Internal (Hash Tables) ----------------------- END ----+
+
+tab_t *_CDECL tab_init(tab_t *const tab, size_t keysiz, size_t valsiz, tab_hash_t hash, tab_eq_t eq, size_t capacity)
+{
+    size_t size = CALC_TAB_GROUP, align = 8;
+
+    while (size * CALC_TAB_LOAD / 8 < capacity)
+        size *= 2;
+
+    /* the strictest alignment both the key and the value allow */
+    while (align > 1 && ((keysiz % align) || (valsiz % align)))
+        align /= 2;
+
+    tab->count = 0;
+    tab->keysiz = keysiz;
+    tab->valsiz = valsiz;
+    tab->valoff = alignto(keysiz, align);
+    tab->slotsiz = alignto(tab->valoff + valsiz, align);
+    tab->hash = hash;
+    tab->eq = eq;
+
+    _tab_alloc(tab, size);
+
+    return tab;
+}
+
+void _CDECL tab_release(tab_t *const tab)
+{
+    checked_free(tab->hashes);
+    checked_free(tab->slots);
+    checked_free(tab->ctrl);
+
+    tab->ctrl = tab->slots = NULL;
+    tab->hashes = NULL;
+    tab->mask = 0;
+    tab->count = 0;
+}
+
+void _CDECL tab_clear(tab_t *const tab)
+{
+    memset(tab->ctrl, _CTRL_EMPTY, tab->mask + CALC_TAB_GROUP);
+
+    tab->count = 0;
+}
+
+void *_CDECL tab_find(const tab_t *const tab, const void *const key)
+{
+    bool_t found;
+    size_t index = _tab_probe(tab, key, _tab_hash(tab, key), &found);
+
+    return found ? _tab_slot(tab, index) : NULL;
+}
+
+void *_CDECL tab_put(tab_t *const tab, const void *const key, bool_t *const isnew)
+{
+    uint64_t hash = _tab_hash(tab, key);
+    bool_t found;
+    size_t index = _tab_probe(tab, key, hash, &found);
+    byte_t *slot;
+
+    if (isnew)
+        *isnew = !found;
+
+    if (found)
+        return _tab_slot(tab, index);
+
+    if (tab->count + 1 > (tab->mask + 1) * CALC_TAB_LOAD / 8)
+    {
+        _tab_grow(tab);
+        index = _tab_probe(tab, key, hash, &found);
+    }
+
+    _tab_setctrl(tab, index, _tab_h2(hash));
+    tab->hashes[index] = _tab_h1(hash);
+    tab->count++;
+
+    slot = _tab_slot(tab, index);
+    memcpy(slot, key, tab->keysiz);
+    memset(slot + tab->valoff, 0, tab->valsiz);
+
+    return slot;
+}
+
+bool_t _CDECL tab_remove(tab_t *const tab, const void *const key)
+{
+    bool_t found;
+    size_t hole = _tab_probe(tab, key, _tab_hash(tab, key), &found), i;
+
+    if (!found)
+        return FALSE;
+
+    /* backward shift: the following keys of the cluster move back
+       into the hole unless it would put them before their home */
+    for (i = (hole + 1) & tab->mask; tab->ctrl[i] != _CTRL_EMPTY; i = (i + 1) & tab->mask)
+    {
+        if (((i - tab->hashes[i]) & tab->mask) >= ((i - hole) & tab->mask))
+        {
+            _tab_setctrl(tab, hole, tab->ctrl[i]);
+            tab->hashes[hole] = tab->hashes[i];
+            memcpy(_tab_slot(tab, hole), _tab_slot(tab, i), tab->slotsiz);
+
+            hole = i;
+        }
+    }
+
+    _tab_setctrl(tab, hole, _CTRL_EMPTY);
+    tab->count--;
+
+    return TRUE;
+}
+
+void *_CDECL tab_next(const tab_t *const tab, size_t *const index)
+{
+    size_t i;
+
+    while ((i = (*index)++) <= tab->mask)
+        if (tab->ctrl[i] != _CTRL_EMPTY)
+            return _tab_slot(tab, i);
+
+    return NULL;
+}
+
+void _CDECL tab_stats(const tab_t *const tab, tab_stats_t *const stats)
+{
+    size_t i, probe, total = 0;
+
+    stats->count = tab->count;
+    stats->capacity = tab->mask + 1;
+    stats->load = (double)tab->count / (double)(tab->mask + 1);
+    stats->probe_max = 0;
+
+    for (i = 0; i <= tab->mask; i++)
+    {
+        if (tab->ctrl[i] == _CTRL_EMPTY)
+            continue;
+
+        probe = ((i - tab->hashes[i]) & tab->mask) + 1;
+        total += probe;
+
+        if (probe > stats->probe_max)
+            stats->probe_max = probe;
+    }
+
+    stats->probe_avg = tab->count ? (double)total / (double)tab->count : 0.0;
+}
+
+#if !_CALC_BUILD_INLINES
+
+void *_CDECL _tab_value(const tab_t *const tab, void *const slot)
+{
+    return slot ? (void *)((byte_t *)slot + tab->valoff) : NULL;
+}
+
+#endif // _CALC_BUILD_INLINES
+
+// Common Keys
+
+uint64_t _CDECL tab_hash_strv(const void *key)
+{
+    return strv_hash(*(const strv_t *)key);
+}
+
+bool_t _CDECL tab_eq_strv(const void *key1, const void *key2)
+{
+    return strv_eq(*(const strv_t *)key1, *(const strv_t *)key2);
+}
+
+uint64_t _CDECL tab_hash_ptr(const void *key)
+{
+    uint64_t h = (uint64_t)(size_t)*(const void *const *)key;
+
+    h = (h ^ (h >> 33)) * UINT64_C(0xFF51AFD7ED558CCD);
+    h = (h ^ (h >> 33)) * UINT64_C(0xC4CEB9FE1A85EC53);
+
+    return h ^ (h >> 33);
+}
+
+// Scoped Tables
+
+symtab_t *_CDECL symtab_init(symtab_t *const symtab)
+{
+    tab_init(&symtab->names, sizeof(istr_t), sizeof(symtab_entry_t), &tab_hash_ptr, NULL, 0);
+    buf_init(&symtab->undo);
+    buf_init(&symtab->marks);
+
+    return symtab;
+}
+
+void _CDECL symtab_release(symtab_t *const symtab)
+{
+    tab_release(&symtab->names);
+    buf_release(&symtab->undo);
+    buf_release(&symtab->marks);
+}
+
+void _CDECL symtab_enter(symtab_t *const symtab)
+{
+    *buf_push(&symtab->marks, size_t) = symtab->undo.len;
+}
+
+void _CDECL symtab_exit(symtab_t *const symtab)
+{
+    size_t mark = *buf_pop(&symtab->marks, size_t);
+    symtab_undo_t *undo;
+
+    /* the newest bindings are undone first, restoring the shadowed
+       ones in the reverse order they were replaced */
+    while (symtab->undo.len > mark)
+    {
+        undo = buf_pop(&symtab->undo, symtab_undo_t);
+
+        if (undo->prev.sym)
+            *tab_get(&symtab->names, symtab_entry_t, &undo->name) = undo->prev;
+        else
+            tab_remove(&symtab->names, &undo->name);
+    }
+}
+
+bool_t _CDECL symtab_bind(symtab_t *const symtab, istr_t name, void *const sym)
+{
+    size_t depth = symtab_depth(symtab);
+    symtab_entry_t *entry = tab_set(&symtab->names, symtab_entry_t, &name);
+    symtab_undo_t *undo;
+
+    if (entry->sym && entry->depth == depth)
+        return FALSE;
+
+    /* the global scope is never left, its bindings need no undo */
+    if (depth)
+    {
+        undo = buf_push(&symtab->undo, symtab_undo_t);
+        undo->name = name;
+        undo->prev = *entry;
+    }
+
+    entry->sym = sym;
+    entry->depth = depth;
+
+    return TRUE;
+}
+
+const symtab_entry_t *_CDECL symtab_lookup(const symtab_t *const symtab, istr_t name)
+{
+    return tab_get(&symtab->names, const symtab_entry_t, &name);
+}
+
+#if !_CALC_BUILD_INLINES
+
+void *_CDECL _symtab_sym(const symtab_entry_t *const entry)
+{
+    return entry ? entry->sym : NULL;
+}
+
+#endif // _CALC_BUILD_INLINES
+
+/* =------------------------------------------------------------= */
@@ -0,0 +1,91 @@
+#include "calc/base/stdthrd.h"
+
+#ifndef _WIN32
+#   include <sched.h>
+#endif // _WIN32
+
+/* =---- Threads -----------------------------------------------= */
+
+#ifdef _WIN32
+
+static DWORD WINAPI _thread_entry(LPVOID arg)
+{
+    thread_t *thread = (thread_t *)arg;
+
+    thread->result = thread->func(thread->arg);
+
+    return 0;
+}
+
+bool_t _CDECL thread_start(thread_t *const thread, thread_func_t func, void *arg)
+{
+    thread->func = func;
+    thread->arg = arg;
+    thread->result = NULL;
+    thread->handle = CreateThread(NULL, 0, &_thread_entry, thread, 0, NULL);
+
+    return (thread->handle != NULL);
+}
+
+void *_CDECL thread_join(thread_t *const thread)
+{
+    WaitForSingleObject(thread->handle, INFINITE);
+    CloseHandle(thread->handle);
+
+    return thread->result;
+}
+
+void _CDECL thread_yield()
+{
+    SwitchToThread();
+}
+
+unsigned int _CDECL thread_cpus()
+{
+    SYSTEM_INFO sys_info;
+
+    GetSystemInfo(&sys_info);
+
+    return (sys_info.dwNumberOfProcessors) ? sys_info.dwNumberOfProcessors : 1;
+}
+
+#else
+
+static void *_thread_entry(void *arg)
+{
+    thread_t *thread = (thread_t *)arg;
+
+    return thread->result = thread->func(thread->arg);
+}
+
+bool_t _CDECL thread_start(thread_t *const thread, thread_func_t func, void *arg)
+{
+    thread->func = func;
+    thread->arg = arg;
+    thread->result = NULL;
+
+    return !pthread_create(&thread->handle, NULL, &_thread_entry, thread);
+}
+
+void *_CDECL thread_join(thread_t *const thread)
+{
+    pthread_join(thread->handle, NULL);
+
+    return thread->result;
+}
+
+void _CDECL thread_yield()
+{
+    sched_yield();
+}
+
+unsigned int _CDECL thread_cpus()
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return (cpus > 0) ? (unsigned int)cpus : 1;
+}
+
+#endif // _WIN32
+
+/* =------------------------------------------------------------= */
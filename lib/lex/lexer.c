@@ -0,0 +1,468 @@
+#include "calc/lex/lexer.h"
+#include "calc/base/stdch.h"
+#include "calc/base/stdthrd.h"
+
+#include <string.h>
+
+/* =---- Lexer -------------------------------------------------= */
+
+/// @brief Tokens scanned at once, then spread over the stream.
+#define _LEX_BATCH 256
+/// @brief Minimum size of the chunks lexed by the threads.
+#define _LEX_CHUNK (1 << 20)
+
+// +---- Internal (Lexer) --------------------------------------+
+
+#pragma region Internal (Lexer)
+
+/* appends the tokens of the scanner to a stream up to the first one
+   that ends at the limit or after it, returns TRUE if the scan
+   reached the end of the text before it */
+static bool_t _lex_scan(scanner_t *const scanner, tokstream_t *const tokens, size_t limit)
+{
+    token_t batch[_LEX_BATCH];
+    size_t n, i;
+
+    while ((n = scanner_scan(scanner, batch, _LEX_BATCH)))
+    {
+        if (tokens->cap - tokens->count < n)
+            tokstream_reserve(tokens, tokens->cap + tokens->cap / 2 + n);
+
+        for (i = 0; i < n; i++)
+        {
+            tokens->kinds[tokens->count + i] = (byte_t)batch[i].kind;
+            tokens->offsets[tokens->count + i] = (uint32_t)batch[i].offset;
+            tokens->lens[tokens->count + i] = (uint32_t)batch[i].len;
+        }
+
+        if (batch[n - 1].offset + batch[n - 1].len >= limit)
+        {
+            for (i = 0; batch[i].offset + batch[i].len < limit; i++)
+                continue;
+
+            tokens->count += i + 1;
+
+            return FALSE;
+        }
+
+        tokens->count += n;
+    }
+
+    return TRUE;
+}
+
+static size_t _lex_eof(tokstream_t *const tokens, size_t len)
+{
+    token_t token;
+
+    token.kind = TOK_EOF;
+    token.offset = len;
+    token.len = 0;
+
+    tokstream_push(tokens, &token);
+
+    return tokens->count;
+}
+
+#pragma endregion
+
+// +---- Internal (Lexer) ----------------------------- END ----+
+
+// +---- Internal (Chunks) -------------------------------------+
+
+#pragma region Internal (Chunks)
+
+/// @brief Chunk of a text lexed by a thread: it starts at a line
+///        and it ends with the first token over the start of the
+///        next chunk, so that the two overlap.
+typedef struct _lexchunk
+{
+    /// @brief Text to split.
+    const char *text;
+    /// @brief Length of the text.
+    size_t len;
+    /// @brief Offset of the first byte.
+    size_t start;
+    /// @brief Offset of the start of the next chunk.
+    size_t limit;
+    /// @brief Tokens of the chunk, the output stream for the first.
+    tokstream_t *tokens;
+    /// @brief Own stream of the other chunks.
+    tokstream_t stream;
+    /// @brief Output stream.
+    tokstream_t *join;
+    /// @brief Index of the first token joined to the output.
+    size_t from;
+    /// @brief Index of the first token in the output.
+    size_t at;
+    /// @brief The scan reached the end of the text.
+    bool_t eof;
+    /// @brief The chunk is lexed by its thread.
+    bool_t started;
+    /// @brief Thread of the chunk.
+    thread_t thread;
+} lexchunk_t;
+
+static void *_lex_chunk(void *arg)
+{
+    lexchunk_t *const chunk = (lexchunk_t *)arg;
+    scanner_t scanner;
+
+    scanner_init(&scanner, chunk->text, chunk->len);
+    scanner.ptr = chunk->text + chunk->start;
+
+    tokstream_reserve(chunk->tokens, chunk->tokens->count + (chunk->limit - chunk->start) / 6 + _LEX_BATCH);
+    chunk->eof = _lex_scan(&scanner, chunk->tokens, chunk->limit);
+
+    return chunk;
+}
+
+/* splits the text after the first new line past each nth of it,
+   returns the number of chunks (at least one) */
+static size_t _lex_split(lexchunk_t *const chunks, size_t n, const char *const text, size_t len)
+{
+    size_t count = 1, start = 0, k;
+    const char *nl;
+
+    for (k = 1; k < n; k++)
+    {
+        if (start >= k * (len / n))
+            continue;
+
+        if (!(nl = (const char *)memchr(text + k * (len / n), '\n', len - k * (len / n))) || (size_t)(nl - text) + 1 >= len)
+            break;
+
+        start = (size_t)(nl - text) + 1;
+        chunks[count - 1].limit = start;
+        chunks[count++].start = start;
+    }
+
+    chunks[count - 1].limit = len + 1;
+
+    return count;
+}
+
+/* the index after the token of a stream that ends at an offset, 0 if
+   none ends there: the ends grow with the tokens */
+static size_t _lex_find(const tokstream_t *const tokens, size_t end)
+{
+    size_t lo = 0, hi = tokens->count, mid;
+
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+
+        if ((size_t)tokens->offsets[mid] + tokens->lens[mid] < end)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return (lo < tokens->count && (size_t)tokens->offsets[lo] + tokens->lens[lo] == end) ? lo + 1 : 0;
+}
+
+/* copies the joined tokens of a chunk to the output */
+static void *_lex_copy(void *arg)
+{
+    lexchunk_t *const chunk = (lexchunk_t *)arg;
+    size_t n = chunk->tokens->count - chunk->from;
+
+    memcpy(chunk->join->kinds + chunk->at, chunk->tokens->kinds + chunk->from, n * sizeof(byte_t));
+    memcpy(chunk->join->offsets + chunk->at, chunk->tokens->offsets + chunk->from, n * sizeof(uint32_t));
+    memcpy(chunk->join->lens + chunk->at, chunk->tokens->lens + chunk->from, n * sizeof(uint32_t));
+
+    return chunk;
+}
+
+/* finds the tokens of each chunk joined to those of the first one,
+   returns the count of the output. The scan is stateless between two
+   tokens, so the tokens of a chunk after the end of the last joined
+   token are the tokens of the text: a chunk that started in a comment
+   or in a literal has no token that ends there, the text is scanned
+   again from it until the two meet (these tokens go after those of
+   the last joined chunk) */
+static size_t _lex_plan(lexchunk_t *const chunks, size_t n, size_t base)
+{
+    tokstream_t *tokens = chunks[0].tokens;
+    size_t pos = (tokens->count > base) ? (size_t)tokens->offsets[tokens->count - 1] + tokens->lens[tokens->count - 1] : 0;
+    size_t index, count, k;
+    bool_t eof = chunks[0].eof;
+    scanner_t scanner;
+    token_t token;
+
+    for (k = 1; k < n; k++)
+        chunks[k].from = chunks[k].tokens->count;
+
+    for (k = 1; k < n && !eof; k++)
+    {
+        if (!(index = _lex_find(chunks[k].tokens, pos)))
+        {
+            scanner_init(&scanner, chunks[k].text, chunks[k].len);
+            scanner.ptr = chunks[k].text + pos;
+
+            while (!index && pos < chunks[k].limit)
+            {
+                if (scanner_next(&scanner, &token) == TOK_EOF)
+                {
+                    eof = TRUE;
+                    break;
+                }
+
+                tokstream_push(tokens, &token);
+
+                index = _lex_find(chunks[k].tokens, pos = token.offset + token.len);
+            }
+
+            if (!index)
+                continue;
+        }
+
+        chunks[k].from = index;
+        tokens = chunks[k].tokens;
+
+        if (tokens->count > index)
+            pos = (size_t)tokens->offsets[tokens->count - 1] + tokens->lens[tokens->count - 1];
+
+        eof = chunks[k].eof;
+    }
+
+    for (count = chunks[0].tokens->count, k = 1; k < n; k++)
+    {
+        chunks[k].at = count;
+        count += chunks[k].tokens->count - chunks[k].from;
+    }
+
+    return count;
+}
+
+#pragma endregion
+
+// +---- Internal (Chunks) ---------------------------- END ----+
+
+// +---- Internal (Edits) --------------------------------------+
+
+#pragma region Internal (Edits)
+
+/* adds a shift to the stored offsets of some tokens */
+static void _lex_shift(tokstream_t *const tokens, size_t from, size_t to, uint32_t shift)
+{
+    for (; from < to; from++)
+        tokens->offsets[from] += shift;
+}
+
+/* the index of the first token scanned again for an edit at an
+   offset: the one after the last token that ends before the edit
+   and is followed by a blank. The automaton reads a blank only in
+   a comment or in a literal, whose prefixes are all tokens (maybe
+   errors), so it stopped there */
+static size_t _lex_restart(const tokstream_t *const tokens, const char *const text, size_t offset)
+{
+    size_t lo = 0, hi = tokens->count, mid;
+
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+
+        if (tokstream_end(tokens, mid) < offset)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    while (lo && !ch_isspace(text[tokstream_end(tokens, lo - 1)]))
+        lo--;
+
+    return lo;
+}
+
+/* replaces the tokens of a stream from first to last with new ones,
+   the tokens after them are shifted. The pending shift of the stream
+   is applied to the tokens between its start and the edit, so that
+   one shift covers both */
+static void _lex_splice(tokstream_t *const tokens, size_t first, size_t last, const tokstream_t *const fresh, uint32_t shift)
+{
+    size_t shifted = last + 1, tail = tokens->count - shifted, removed = last + 1 - first;
+
+    if (tokens->shift)
+    {
+        if (tokens->shifted < first)
+            _lex_shift(tokens, tokens->shifted, first, tokens->shift);
+        else if (tokens->shifted > shifted)
+        {
+            _lex_shift(tokens, shifted, tokens->shifted, shift);
+            shifted = tokens->shifted;
+        }
+    }
+
+    if (fresh->count != removed)
+    {
+        /* grows as a push does, typing adds a token at a time */
+        if (fresh->count > removed && tokens->cap - tokens->count < fresh->count - removed)
+            tokstream_reserve(tokens, tokens->cap + tokens->cap / 2 + fresh->count - removed);
+
+        memmove(tokens->kinds + first + fresh->count, tokens->kinds + last + 1, tail * sizeof(byte_t));
+        memmove(tokens->offsets + first + fresh->count, tokens->offsets + last + 1, tail * sizeof(uint32_t));
+        memmove(tokens->lens + first + fresh->count, tokens->lens + last + 1, tail * sizeof(uint32_t));
+    }
+
+    memcpy(tokens->kinds + first, fresh->kinds, fresh->count * sizeof(byte_t));
+    memcpy(tokens->offsets + first, fresh->offsets, fresh->count * sizeof(uint32_t));
+    memcpy(tokens->lens + first, fresh->lens, fresh->count * sizeof(uint32_t));
+
+    tokens->count = first + fresh->count + tail;
+    tokens->shifted = shifted - removed + fresh->count;
+    tokens->shift += shift;
+}
+
+#pragma endregion
+
+// +---- Internal (Edits) ----------------------------- END ----+
+
+size_t _CDECL lex_text(const char *const text, size_t len, tokstream_t *const tokens)
+{
+    size_t base = tokens->count;
+    scanner_t scanner;
+
+    if (len > CALC_SRCLOC_MAX)
+        return 0;
+
+    tokstream_settle(tokens);
+    scanner_init(&scanner, text, len);
+
+    /* about one token in six bytes of a real source */
+    tokstream_reserve(tokens, tokens->count + len / 6 + _LEX_BATCH);
+    _lex_scan(&scanner, tokens, len + 1);
+
+    return _lex_eof(tokens, len) - base;
+}
+
+size_t _CDECL lex_text_parallel(const char *const text, size_t len, tokstream_t *const tokens, unsigned int threads)
+{
+    size_t base = tokens->count, count, n, k;
+    lexchunk_t *chunks;
+
+    if (!threads)
+        threads = thread_cpus();
+
+    if ((n = len / _LEX_CHUNK) > threads)
+        n = threads;
+
+    if (n <= 1 || len > CALC_SRCLOC_MAX)
+        return lex_text(text, len, tokens);
+
+    tokstream_settle(tokens);
+
+    chunks = dim(lexchunk_t, n);
+
+    /* a text without new lines is not split */
+    if ((n = _lex_split(chunks, n, text, len)) == 1)
+    {
+        checked_free(chunks);
+
+        return lex_text(text, len, tokens);
+    }
+
+    for (k = 0; k < n; k++)
+    {
+        chunks[k].text = text;
+        chunks[k].len = len;
+        chunks[k].tokens = k ? tokstream_init(&chunks[k].stream) : tokens;
+        chunks[k].join = tokens;
+    }
+
+    for (k = 1; k < n; k++)
+        chunks[k].started = thread_start(&chunks[k].thread, _lex_chunk, chunks + k);
+
+    _lex_chunk(chunks);
+
+    for (k = 1; k < n; k++)
+    {
+        if (chunks[k].started)
+            thread_join(&chunks[k].thread);
+        else
+            _lex_chunk(chunks + k);
+    }
+
+    /* the tokens are copied to the output by the threads again */
+    tokstream_reserve(tokens, (count = _lex_plan(chunks, n, base)) + 1);
+
+    for (k = 2; k < n; k++)
+        chunks[k].started = thread_start(&chunks[k].thread, _lex_copy, chunks + k);
+
+    _lex_copy(chunks + 1);
+
+    for (k = 2; k < n; k++)
+    {
+        if (chunks[k].started)
+            thread_join(&chunks[k].thread);
+        else
+            _lex_copy(chunks + k);
+    }
+
+    tokens->count = count;
+
+    for (k = 1; k < n; k++)
+        tokstream_release(&chunks[k].stream);
+
+    checked_free(chunks);
+
+    return _lex_eof(tokens, len) - base;
+}
+
+lexedit_t *_CDECL lex_edit(tokstream_t *const tokens, const char *const text, size_t len,
+                           size_t offset, size_t removed, size_t inserted, lexedit_t *const edit)
+{
+    size_t first, last, target;
+    tokstream_t fresh;
+    scanner_t scanner;
+    token_t token;
+
+    if (len > CALC_SRCLOC_MAX)
+        return NULL;
+
+    first = last = _lex_restart(tokens, text, offset);
+
+    scanner_init(&scanner, text, len);
+    scanner.ptr = text + (first ? tokstream_end(tokens, first - 1) : 0);
+    tokstream_init(&fresh);
+
+    /* the scan is stateless between two tokens: once a new token ends
+       after the edit where an old one ended, the next tokens are the
+       old ones (the TOK_EOF at last) */
+    for (;;)
+    {
+        scanner_next(&scanner, &token);
+        tokstream_push(&fresh, &token);
+
+        /* the last token may end with the text, as the TOK_EOF, only
+           this replaces it */
+        if (token.kind == TOK_EOF)
+        {
+            last = tokens->count - 1;
+            break;
+        }
+
+        if (token.offset + token.len < offset + inserted)
+            continue;
+
+        target = token.offset + token.len - inserted + removed;
+
+        while (last < tokens->count - 1 && tokstream_end(tokens, last) < target)
+            last++;
+
+        if (last < tokens->count - 1 && tokstream_end(tokens, last) == target)
+            break;
+    }
+
+    _lex_splice(tokens, first, last, &fresh, (uint32_t)inserted - (uint32_t)removed);
+
+    edit->index = first;
+    edit->removed = last + 1 - first;
+    edit->inserted = fresh.count;
+
+    tokstream_release(&fresh);
+
+    return edit;
+}
+
+/* =------------------------------------------------------------= */
@@ -0,0 +1,520 @@
+#include "calc/lex/literal.h"
+#include "calc/base/stdch.h"
+
+#include <float.h>
+#include <string.h>
+
+/* =---- Literals ----------------------------------------------= */
+
+// +---- Internal (Integers) -----------------------------------+
+
+#pragma region Internal (Integers)
+
+#define _SWAR_ONES UINT64_C(0x0101010101010101)
+#define _SWAR_HIGH UINT64_C(0x8080808080808080)
+
+/* sets the high bit of the bytes of word (all below 0x80) between
+   lo and hi */
+#define _swar_in(word, lo, hi) \
+    ((((word) + (0x80 - (lo)) * _SWAR_ONES) ^ ((word) + (0x7F - (hi)) * _SWAR_ONES)) & _SWAR_HIGH)
+
+/* loads 8 chars, the first one in the low byte */
+static inline uint64_t _lit_load(const char *const p)
+{
+    uint64_t word;
+
+    memcpy(&word, p, sizeof(word));
+
+#if defined __BYTE_ORDER__ && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = ((word & UINT64_C(0x00FF00FF00FF00FF)) << 8) | ((word >> 8) & UINT64_C(0x00FF00FF00FF00FF));
+    word = ((word & UINT64_C(0x0000FFFF0000FFFF)) << 16) | ((word >> 16) & UINT64_C(0x0000FFFF0000FFFF));
+    word = (word << 32) | (word >> 32);
+#endif // __BYTE_ORDER__
+
+    return word;
+}
+
+/* the digits of a word are merged in pairs, then in pairs of pairs:
+   the first digit of each pair is the most significant */
+
+static inline bool_t _lit_bin8(uint64_t word, uint64_t *const value)
+{
+    if ((word & UINT64_C(0xFEFEFEFEFEFEFEFE)) != UINT64_C(0x3030303030303030))
+        return FALSE;
+
+    /* each bit is moved to the top byte by one product */
+    *value = (*value << 8) | (((word & _SWAR_ONES) * UINT64_C(0x8040201008040201)) >> 56);
+
+    return TRUE;
+}
+
+static inline bool_t _lit_oct8(uint64_t word, uint64_t *const value)
+{
+    if ((word & UINT64_C(0xF8F8F8F8F8F8F8F8)) != UINT64_C(0x3030303030303030))
+        return FALSE;
+
+    word &= UINT64_C(0x0707070707070707);
+    word = ((word << 3) | (word >> 8)) & UINT64_C(0x003F003F003F003F);
+    word = ((word << 6) | (word >> 16)) & UINT64_C(0x00000FFF00000FFF);
+    *value = (*value << 24) | (((word << 12) | (word >> 32)) & UINT64_C(0xFFFFFF));
+
+    return TRUE;
+}
+
+static inline bool_t _lit_dec8(uint64_t word, uint64_t *const value)
+{
+    /* a byte above '9' carries into the high nibble */
+    if (((word & UINT64_C(0xF0F0F0F0F0F0F0F0)) |
+         (((word + UINT64_C(0x0606060606060606)) & UINT64_C(0xF0F0F0F0F0F0F0F0)) >> 4)) !=
+        UINT64_C(0x3333333333333333))
+        return FALSE;
+
+    /* the pairs are merged by products by 10 * 2^8 + 1, 100 * 2^16 + 1
+       and 10000 * 2^32 + 1 */
+    word = ((word & UINT64_C(0x0F0F0F0F0F0F0F0F)) * 2561) >> 8;
+    word = ((word & UINT64_C(0x00FF00FF00FF00FF)) * 6553601) >> 16;
+    *value = *value * 100000000 + (((word & UINT64_C(0x0000FFFF0000FFFF)) * UINT64_C(42949672960001)) >> 32);
+
+    return TRUE;
+}
+
+static inline bool_t _lit_hex8(uint64_t word, uint64_t *const value)
+{
+    if ((word & _SWAR_HIGH) ||
+        (_swar_in(word, '0', '9') | _swar_in(word | (0x20 * _SWAR_ONES), 'a', 'f')) != _SWAR_HIGH)
+        return FALSE;
+
+    /* the letters have the bit 6 set and their low nibble is 1 to 6 */
+    word = (word & UINT64_C(0x0F0F0F0F0F0F0F0F)) + 9 * ((word >> 6) & _SWAR_ONES);
+    word = ((word << 4) | (word >> 8)) & UINT64_C(0x00FF00FF00FF00FF);
+    word = ((word << 8) | (word >> 16)) & UINT64_C(0x0000FFFF0000FFFF);
+    *value = (*value << 32) | (((word << 16) | (word >> 32)) & UINT64_C(0xFFFFFFFF));
+
+    return TRUE;
+}
+
+/* appends n digits of a radix to a value, 8 at a time: the caller
+   checks that the result fits */
+static bool_t _lit_digits(const char *p, size_t n, unsigned int radix, uint64_t *const value)
+{
+    const char *const end = p + n;
+    unsigned int digit;
+    uint64_t r = *value;
+
+    switch (radix)
+    {
+    case 2:
+        for (; end - p >= 8; p += 8)
+            if (!_lit_bin8(_lit_load(p), &r))
+                return FALSE;
+        break;
+    case 8:
+        for (; end - p >= 8; p += 8)
+            if (!_lit_oct8(_lit_load(p), &r))
+                return FALSE;
+        break;
+    case 10:
+        for (; end - p >= 8; p += 8)
+            if (!_lit_dec8(_lit_load(p), &r))
+                return FALSE;
+        break;
+    default:
+        for (; end - p >= 8; p += 8)
+            if (!_lit_hex8(_lit_load(p), &r))
+                return FALSE;
+        break;
+    }
+
+    for (; p < end; p++)
+    {
+        if ((digit = ch_digit(*p)) >= radix)
+            return FALSE;
+
+        r = r * radix + digit;
+    }
+
+    *value = r;
+
+    return TRUE;
+}
+
+#pragma endregion
+
+// +---- Internal (Integers) -------------------------- END ----+
+
+lit_status_t _CDECL lit_int(const char *const str, size_t len, uint64_t *const value)
+{
+    const char *p = str, *end = str + len;
+    unsigned int radix = 10;
+    bool_t overflow;
+    size_t n;
+
+    for (; p < end && *p == '0'; p++)
+        continue;
+
+    /* the zeros are followed by the radix or by the digits */
+    if (p > str && p < end && (byte_t)(*p - '0') >= 10)
+    {
+        switch (*p | 0x20)
+        {
+        case 'b':
+            radix = 2;
+            break;
+        case 'c':
+            radix = 8;
+            break;
+        case 'd':
+            radix = 10;
+            break;
+        case 'x':
+            radix = 16;
+            break;
+        default:
+            return LIT_MALFORMED;
+        }
+
+        if (++p == end)
+            return LIT_MALFORMED;
+
+        for (; p < end && *p == '0'; p++)
+            continue;
+    }
+    else if (!len)
+        return LIT_MALFORMED;
+
+    /* the significant digits that fit 64 bits */
+    switch (n = (size_t)(end - p), radix)
+    {
+    case 2:
+        overflow = n > 64;
+        break;
+    case 8:
+        overflow = n > 22 || (n == 22 && *p > '1');
+        break;
+    case 10:
+        overflow = n > 20 || (n == 20 && memcmp(p, "18446744073709551615", 20) > 0);
+        break;
+    default:
+        overflow = n > 16;
+        break;
+    }
+
+    *value = 0;
+
+    if (!_lit_digits(p, n, radix, value))
+        return LIT_MALFORMED;
+
+    if (overflow)
+    {
+        *value = UINT64_MAX;
+
+        return LIT_OVERFLOW;
+    }
+
+    return LIT_OK;
+}
+
+// +---- Internal (Reals) --------------------------------------+
+
+#pragma region Internal (Reals)
+
+/// @brief Most significant digits of a real converted exactly.
+#define _LIT_DIGITS 19
+/// @brief Decimal exponents are read up to this value, a larger one
+///        gives zero or infinity whatever the digits.
+#define _LIT_EXPMAX (INT64_C(1) << 40)
+/// @brief Bits of the infinity.
+#define _LIT_INF (UINT64_C(0x7FF) << 52)
+
+#define LITERAL_TABLE
+#include "calc/lex/tokens.inc"
+
+#if defined FLT_EVAL_METHOD && FLT_EVAL_METHOD == 0
+/// @brief The products of doubles are rounded once (not in extended
+///        precision), the exact powers of ten are used directly.
+#   define _LIT_CLINGER 1
+#endif // FLT_EVAL_METHOD
+
+#ifdef _LIT_CLINGER
+/* the powers of ten exact in a double */
+static const double _lit_pow10[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+#endif // _LIT_CLINGER
+
+#if defined __GNUC__ && defined __SIZEOF_INT128__
+/* the high half of a * b, the low half in lo */
+static inline uint64_t _lit_mul(uint64_t a, uint64_t b, uint64_t *const lo)
+{
+    unsigned __int128 r = (unsigned __int128)a * b;
+
+    *lo = (uint64_t)r;
+
+    return (uint64_t)(r >> 64);
+}
+#elif defined _MSC_VER && defined _M_X64
+/* the high half of a * b, the low half in lo */
+static __inline uint64_t _lit_mul(uint64_t a, uint64_t b, uint64_t *const lo)
+{
+    uint64_t hi;
+
+    *lo = _umul128(a, b, &hi);
+
+    return hi;
+}
+#else
+/* the high half of a * b, the low half in lo */
+static inline uint64_t _lit_mul(uint64_t a, uint64_t b, uint64_t *const lo)
+{
+    uint64_t ll = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF), lh = (a & 0xFFFFFFFF) * (b >> 32);
+    uint64_t hl = (a >> 32) * (b & 0xFFFFFFFF), hh = (a >> 32) * (b >> 32);
+    uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+
+    *lo = (mid << 32) | (ll & 0xFFFFFFFF);
+
+    return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+}
+#endif // __SIZEOF_INT128__ or _M_X64
+
+#ifdef __GNUC__
+#   define _lit_clz(w) ((int)__builtin_clzll(w))
+#elif defined _MSC_VER && defined _M_X64
+static __inline int _lit_clz(uint64_t w)
+{
+    unsigned long index;
+
+    _BitScanReverse64(&index, w);
+
+    return 63 - (int)index;
+}
+#else
+static inline int _lit_clz(uint64_t w)
+{
+    int n = 0;
+
+    for (; !(w >> 63); w <<= 1)
+        n++;
+
+    return n;
+}
+#endif // __GNUC__ or _M_X64
+
+/* the bits of the double nearest to w * 10^q (Eisel-Lemire): w is
+   normalized and multiplied by the 128 bits of 5^q, the power of two
+   is added to the exponent. The product is always exact enough for
+   w below 10^19 (Lemire, "Number Parsing at a Gigabyte per Second",
+   2021) */
+static uint64_t _lit_lemire(uint64_t w, int64_t q)
+{
+    uint64_t hi, lo, low, tail, mantissa;
+    int lz, upper, shift;
+    int64_t power;
+
+    if (!w || q < _LIT_POW_MIN)
+        return 0;
+
+    if (q > _LIT_POW_MAX)
+        return _LIT_INF;
+
+    lz = _lit_clz(w);
+    w <<= lz;
+    hi = _lit_mul(w, _lit_pow5[q - _LIT_POW_MIN][0], &lo);
+
+    /* the 9 bits below the 55 kept are all ones, the carry of the low
+       half of the power can reach them */
+    if ((hi & 0x1FF) == 0x1FF)
+    {
+        low = _lit_mul(w, _lit_pow5[q - _LIT_POW_MIN][1], &tail);
+        lo += low;
+        hi += low > lo;
+    }
+
+    upper = (int)(hi >> 63);
+    shift = upper + 9;
+    mantissa = hi >> shift;
+    /* floor(q * log2(10)) + 63 and the bias */
+    power = ((217706 * q) >> 16) + 63 + upper - lz + 1023;
+
+    /* a subnormal, a mantissa rounded up to 2^52 is the smallest
+       normal and has the same bits */
+    if (power <= 0)
+    {
+        if (-power + 1 >= 64)
+            return 0;
+
+        mantissa >>= -power + 1;
+        mantissa += mantissa & 1;
+
+        return mantissa >> 1;
+    }
+
+    /* exactly halfway, only possible for the small exponents: ties to
+       even instead of up */
+    if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << shift) == hi)
+        mantissa &= ~UINT64_C(1);
+
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+
+    if (mantissa >= UINT64_C(2) << 52)
+    {
+        mantissa = UINT64_C(1) << 52;
+        power++;
+    }
+
+    if (power >= 0x7FF)
+        return _LIT_INF;
+
+    return (mantissa & ~(UINT64_C(1) << 52)) | ((uint64_t)power << 52);
+}
+
+#pragma endregion
+
+// +---- Internal (Reals) ----------------------------- END ----+
+
+lit_status_t _CDECL lit_real(const char *const str, size_t len, double *const value)
+{
+    const char *p = str, *end = str + len, *dot, *frac, *exp;
+    uint64_t w = 0, bits;
+    bool_t truncated = FALSE, neg = FALSE;
+    int64_t q, e = 0;
+    size_t n, m, k;
+
+    if (!len || !(dot = (const char *)memchr(str, '.', len)) || dot == str)
+        return LIT_MALFORMED;
+
+    for (exp = dot + 1; exp < end && (byte_t)(*exp - '0') < 10; exp++)
+        continue;
+
+    if (exp == dot + 1)
+        return LIT_MALFORMED;
+
+    if (exp < end)
+    {
+        if ((*exp | 0x20) != 'e')
+            return LIT_MALFORMED;
+
+        if ((p = exp + 1) < end && (*p == '+' || *p == '-'))
+            neg = *p++ == '-';
+
+        if (p == end)
+            return LIT_MALFORMED;
+
+        for (; p < end; p++)
+        {
+            if ((byte_t)(*p - '0') >= 10)
+                return LIT_MALFORMED;
+
+            if (e < _LIT_EXPMAX)
+                e = e * 10 + (*p - '0');
+        }
+
+        if (neg)
+            e = -e;
+    }
+
+    /* w takes the first digits, from the first one not zero, and the
+       exponent q is of the last one taken */
+    q = e - (int64_t)(exp - dot - 1);
+
+    for (p = str; p < dot && *p == '0'; p++)
+        continue;
+
+    frac = dot + 1;
+    n = (size_t)(dot - p);
+
+    if (!n)
+        for (; frac < exp && *frac == '0'; frac++)
+            continue;
+
+    m = (size_t)(exp - frac);
+
+    if (n + m > _LIT_DIGITS)
+    {
+        k = n < _LIT_DIGITS ? n : _LIT_DIGITS;
+
+        if (!_lit_digits(p, k, 10, &w) || !_lit_digits(frac, _LIT_DIGITS - k, 10, &w))
+            return LIT_MALFORMED;
+
+        /* the digits left out */
+        for (p += k; p < dot; p++)
+        {
+            if ((byte_t)(*p - '0') >= 10)
+                return LIT_MALFORMED;
+
+            truncated |= *p != '0';
+        }
+
+        for (p = frac + (_LIT_DIGITS - k); p < exp; p++)
+            truncated |= *p != '0';
+
+        q += (int64_t)(n + m - _LIT_DIGITS);
+    }
+    else
+    {
+        if (!_lit_digits(p, n, 10, &w) || !_lit_digits(frac, m, 10, &w))
+            return LIT_MALFORMED;
+
+#ifdef _LIT_CLINGER
+        /* w and 10^q are exact doubles, the product is rounded once */
+        if (w <= UINT64_C(1) << 53 && q >= -22 && q <= 22)
+        {
+            *value = q < 0 ? (double)w / _lit_pow10[-q] : (double)w * _lit_pow10[q];
+
+            return LIT_OK;
+        }
+#endif // _LIT_CLINGER
+    }
+
+    bits = _lit_lemire(w, q);
+
+    /* the digits left out decide the rounding if w + 1 is rounded
+       otherwise */
+    if (truncated && bits != _lit_lemire(w + 1, q))
+    {
+        if (!strv_tof(strv(str, len), value))
+            return LIT_MALFORMED;
+    }
+    else
+        memcpy(value, &bits, sizeof(bits));
+
+    return *value > DBL_MAX ? LIT_OVERFLOW : LIT_OK;
+}
+
+lit_status_t _CDECL lit_decode(const tokstream_t *const tokens, const char *const text, size_t index,
+                               litval_t *const value)
+{
+    const char *const str = text + tokstream_offset(tokens, index);
+
+    switch (value->kind = tokstream_kind(tokens, index))
+    {
+    case TOK_LIT_BIN:
+    case TOK_LIT_OCT:
+    case TOK_LIT_DEC:
+    case TOK_LIT_HEX:
+        return lit_int(str, tokens->lens[index], &value->as.u);
+    case TOK_LIT_REAL:
+        return lit_real(str, tokens->lens[index], &value->as.r);
+    default:
+        return LIT_MALFORMED;
+    }
+}
+
+const char *_CDECL lit_strerror(lit_status_t status)
+{
+    switch (status)
+    {
+    case LIT_OK:
+        return "no error";
+    case LIT_MALFORMED:
+        return "malformed number";
+    case LIT_OVERFLOW:
+        return "number too large";
+    }
+
+    return "unknown error";
+}
+
+/* =------------------------------------------------------------= */
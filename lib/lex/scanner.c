@@ -0,0 +1,379 @@
+#include "calc/lex/scanner.h"
+#include "calc/base/stdch.h"
+#include "calc/base/stdthrd.h"
+
+#include <string.h>
+
+/* =---- Scanner -----------------------------------------------= */
+
+// +---- Internal (Automaton) ----------------------------------+
+
+#pragma region Internal (Automaton)
+
+/// @brief No token is accepted in the state.
+#define _SCAN_NONE 0xFFFF
+/// @brief Blanks and comments, skipped.
+#define _SCAN_SKIP TOK_COUNT
+/// @brief Identifier with some non-ASCII chars, checked by the slow
+///        path.
+#define _SCAN_UIDENT (TOK_COUNT + 1)
+
+/// @brief Length of the runs skipped without the vector loop.
+#define _SCAN_SHORT 8
+
+#define SCANNER_TABLE
+#include "calc/lex/tokens.inc"
+
+/* the automaton takes any UTF-8 byte in an identifier, the code
+   points are checked here and the token is cut before the first
+   char that cannot be part of it */
+static tok_kind_t _scan_uident(const char *const str, size_t *const len)
+{
+    size_t n = ch_identlen(str, *len);
+    uint32_t cp;
+
+    if (!n)
+    {
+        n = utf8_decode(str, *len, &cp);
+        *len = n ? n : 1;
+
+        return TOK_ERR_CHAR;
+    }
+
+    *len = n;
+
+    return tok_keyword(str, n);
+}
+
+/* the token of str[0..len) ended in a state without a token: it is
+   scanned again up to its longest accepted prefix (there is always
+   one, any byte is at least an error token) */
+static size_t _scan_back(const byte_t *const str, size_t len, unsigned int *const kind)
+{
+    unsigned int state = _SCAN_START, accept;
+    size_t i, last = 1;
+
+    for (i = 0; i < len; )
+    {
+        state = _scan_dfa[state + _scan_class[str[i++]]];
+
+        if ((accept = _scan_dfa[state + _SCAN_CLASSES]) != _SCAN_NONE)
+            last = i, *kind = accept;
+    }
+
+    return last;
+}
+
+#pragma endregion
+
+// +---- Internal (Automaton) ------------------------- END ----+
+
+// +---- Internal (Scalar) -------------------------------------+
+
+#pragma region Internal (Scalar)
+
+/* the bytes of str on which the state loops */
+static size_t _scalar_skip(const byte_t *const str, size_t len, unsigned int state)
+{
+    size_t i = 0;
+
+    while (i < len && _scan_dfa[state + _scan_class[str[i]]] == state)
+        i++;
+
+    return i;
+}
+
+#pragma endregion
+
+// +---- Internal (Scalar) ---------------------------- END ----+
+
+/* a byte is in a run if it is in one of its ranges: its distance
+   from the first byte of the range, unsigned, is at most the length
+   of the range minus one, so the minimum of the two is the distance */
+
+#if _CALC_SSE2
+
+#include <emmintrin.h>
+
+// +---- Internal (SSE2) ---------------------------------------+
+
+#pragma region Internal (SSE2)
+
+static size_t _sse2_skip(const byte_t *const str, size_t len, unsigned int state)
+{
+    const byte_t (*const run)[16] = _scan_runs[_scan_run[state / _SCAN_WIDTH]];
+    __m128i first[_SCAN_RANGES], span[_SCAN_RANGES], bytes, dist, in;
+    unsigned int mask;
+    size_t i;
+    int k;
+
+    for (k = 0; k < _SCAN_RANGES; k++)
+    {
+        first[k] = _mm_loadu_si128((const __m128i *)run[k]);
+        span[k] = _mm_loadu_si128((const __m128i *)run[_SCAN_RANGES + k]);
+    }
+
+    for (i = 0; i + 16 <= len; i += 16)
+    {
+        bytes = _mm_loadu_si128((const __m128i *)(str + i));
+        in = _mm_setzero_si128();
+
+        for (k = 0; k < _SCAN_RANGES; k++)
+        {
+            dist = _mm_sub_epi8(bytes, first[k]);
+            in = _mm_or_si128(in, _mm_cmpeq_epi8(_mm_min_epu8(dist, span[k]), dist));
+        }
+
+        if ((mask = ~(unsigned int)_mm_movemask_epi8(in) & 0xFFFF) != 0)
+            return i + _ctz32(mask);
+    }
+
+    return i + _scalar_skip(str + i, len - i, state);
+}
+
+#pragma endregion
+
+// +---- Internal (SSE2) ------------------------------ END ----+
+
+#endif // _CALC_SSE2
+
+#if _CALC_AVX2
+
+#include <immintrin.h>
+
+// +---- Internal (AVX2) ---------------------------------------+
+
+#pragma region Internal (AVX2)
+
+static _TARGET("avx2") size_t _avx2_skip(const byte_t *const str, size_t len, unsigned int state)
+{
+    const byte_t (*const run)[16] = _scan_runs[_scan_run[state / _SCAN_WIDTH]];
+    __m256i first[_SCAN_RANGES], span[_SCAN_RANGES], bytes, dist, in;
+    unsigned int mask;
+    size_t i;
+    int k;
+
+    for (k = 0; k < _SCAN_RANGES; k++)
+    {
+        first[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)run[k]));
+        span[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)run[_SCAN_RANGES + k]));
+    }
+
+    for (i = 0; i + 32 <= len; i += 32)
+    {
+        bytes = _mm256_loadu_si256((const __m256i *)(str + i));
+        in = _mm256_setzero_si256();
+
+        for (k = 0; k < _SCAN_RANGES; k++)
+        {
+            dist = _mm256_sub_epi8(bytes, first[k]);
+            in = _mm256_or_si256(in, _mm256_cmpeq_epi8(_mm256_min_epu8(dist, span[k]), dist));
+        }
+
+        if ((mask = ~(unsigned int)_mm256_movemask_epi8(in)) != 0)
+            return i + _ctz32(mask);
+    }
+
+    return i + _scalar_skip(str + i, len - i, state);
+}
+
+#pragma endregion
+
+// +---- Internal (AVX2) ------------------------------ END ----+
+
+#endif // _CALC_AVX2
+
+// +---- Internal (Dispatch) -----------------------------------+
+
+#pragma region Internal (Dispatch)
+
+/// @brief Skip loop of the scanner for an instruction set: it
+///        returns the number of leading bytes of a string on which
+///        a state loops.
+typedef struct _scanops
+{
+    const char *isa;
+    size_t (*skip)(const byte_t *const str, size_t len, unsigned int state);
+} scanops_t;
+
+static const scanops_t _scanops[] =
+{
+#if _CALC_AVX2
+    {"avx2", _avx2_skip},
+#endif // _CALC_AVX2
+#if _CALC_SSE2
+    {"sse2", _sse2_skip},
+#endif // _CALC_SSE2
+    {"scalar", _scalar_skip}
+};
+
+static const scanops_t *_scanops_sel = NULL;
+
+/* the instruction set can be used by the processor */
+static bool_t _scanops_has(const scanops_t *const ops)
+{
+#if _CALC_AVX2
+    if (ops->skip == _avx2_skip)
+        return cpuhas(CPU_AVX2);
+#endif // _CALC_AVX2
+#if _CALC_SSE2
+    if (ops->skip == _sse2_skip)
+        return cpuhas(CPU_SSE2);
+#endif // _CALC_SSE2
+
+    return TRUE;
+}
+
+static const scanops_t *_scanops_select()
+{
+    const scanops_t *ops = _scanops;
+
+    while (!_scanops_has(ops))
+        ops++;
+
+    atomic_store_ptr(&_scanops_sel, ops);
+
+    return ops;
+}
+
+/// @brief Gets the skip loop of the processor, selecting it on the
+///        first call.
+static inline const scanops_t *_scanops_get()
+{
+    const scanops_t *ops = (const scanops_t *)atomic_load_ptr(&_scanops_sel);
+
+    return ops ? ops : _scanops_select();
+}
+
+#pragma endregion
+
+// +---- Internal (Dispatch) -------------------------- END ----+
+
+// +---- Internal (Scanner) ------------------------------------+
+
+#pragma region Internal (Scanner)
+
+/* scans the token at text[i], skipping the blanks and the comments
+   before it, and returns its end: the token is TOK_EOF at the end of
+   the text. The automaton stops only at the boundary after a token,
+   so the next one starts from a constant state and the processor
+   can overlap them */
+static size_t _scan_token(const byte_t *const text, size_t i, size_t end, token_t *const token, const scanops_t *const ops)
+{
+    unsigned int state, next, flags, kind;
+    size_t start, stop, len;
+
+    do
+    {
+        start = i;
+        state = _SCAN_START;
+
+        while (i < end && !((flags = _scan_flags[next = state + _scan_class[text[i]]]) & _SCAN_BOUNDARY))
+        {
+            state = _scan_dfa[next];
+            i++;
+
+            if (flags & _SCAN_RUN)
+            {
+                /* the short runs are skipped here, the long ones by
+                   the vector loop */
+                for (stop = (end - i > _SCAN_SHORT) ? i + _SCAN_SHORT : end;
+                     i < stop && _scan_dfa[state + _scan_class[text[i]]] == state; i++)
+                    continue;
+
+                if (i == stop && i < end)
+                    i += ops->skip(text + i, end - i, state);
+            }
+        }
+
+        if (i == start)
+        {
+            token->kind = TOK_EOF;
+            token->offset = end;
+            token->len = 0;
+
+            return end;
+        }
+
+        if ((kind = _scan_dfa[state + _SCAN_CLASSES]) == _SCAN_NONE)
+            i = start + _scan_back(text + start, i - start, &kind);
+    }
+    while (kind == _SCAN_SKIP);
+
+    len = i - start;
+
+    /* the identifiers are looked up in the keywords, the non-ASCII
+       ones are checked and maybe cut */
+    if (kind == TOK_IDENT)
+        kind = tok_keyword((const char *)text + start, len);
+    else if (kind == _SCAN_UIDENT)
+        kind = _scan_uident((const char *)text + start, &len);
+
+    token->kind = (tok_kind_t)kind;
+    token->offset = start;
+    token->len = len;
+
+    return start + len;
+}
+
+#pragma endregion
+
+// +---- Internal (Scanner) --------------------------- END ----+
+
+scanner_t *_CDECL scanner_init(scanner_t *const scanner, const char *const text, size_t len)
+{
+    scanner->text = text;
+    scanner->ptr = text;
+    scanner->end = text + len;
+
+    return scanner;
+}
+
+tok_kind_t _CDECL scanner_next(scanner_t *const scanner, token_t *const token)
+{
+    const byte_t *const text = (const byte_t *)scanner->text;
+
+    scanner->ptr = (const char *)text + _scan_token(text, scanner_offset(scanner), (size_t)(scanner->end - scanner->text), token,
+                                                    _scanops_get());
+
+    return token->kind;
+}
+
+size_t _CDECL scanner_scan(scanner_t *const scanner, token_t *const tokens, size_t max)
+{
+    const byte_t *const text = (const byte_t *)scanner->text;
+    size_t i = scanner_offset(scanner), end = (size_t)(scanner->end - scanner->text), count;
+    const scanops_t *const ops = _scanops_get();
+
+    for (count = 0; count < max; count++)
+        if ((i = _scan_token(text, i, end, tokens + count, ops)) == end && tokens[count].kind == TOK_EOF)
+            break;
+
+    scanner->ptr = (const char *)text + i;
+
+    return count;
+}
+
+const char *_CDECL scanner_isa()
+{
+    return _scanops_get()->isa;
+}
+
+bool_t _CDECL scanner_setisa(const char *const isa)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(_scanops) / sizeof(_scanops[0]); i++)
+    {
+        if (!strcmp(_scanops[i].isa, isa) && _scanops_has(_scanops + i))
+        {
+            atomic_store_ptr(&_scanops_sel, _scanops + i);
+
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/* =------------------------------------------------------------= */
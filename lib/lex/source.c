@@ -0,0 +1,607 @@
+#include "calc/lex/source.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifndef _WIN32
+#   include <sys/mman.h>
+#endif // _WIN32
+
+#if _CALC_SSE2
+#   include <emmintrin.h>
+#endif // _CALC_SSE2
+
+/* =---- Sources -----------------------------------------------= */
+
+// +---- Internal (Sources) ------------------------------------+
+
+#pragma region Internal (Sources)
+
+#ifdef _WIN32
+#   define _src_open(path) _open((path), _O_RDONLY | _O_BINARY)
+#   define _src_read(fd, buf, size) _read((fd), (buf), (unsigned int)(size))
+#   define _src_close(fd) _close(fd)
+#else
+#   define _src_open(path) open((path), O_RDONLY)
+#   define _src_read(fd, buf, size) read((fd), (buf), (size))
+#   define _src_close(fd) close(fd)
+#endif // _WIN32
+
+#ifndef S_ISREG
+#   define S_ISREG(mode) (((mode) & S_IFMT) == S_IFREG)
+#endif // S_ISREG
+
+#if !defined MAP_ANONYMOUS && defined MAP_ANON
+#   define MAP_ANONYMOUS MAP_ANON
+#endif // MAP_ANONYMOUS
+
+/// @brief Largest read, some systems refuse larger counts.
+#define _SRC_READMAX 0x40000000
+
+static void _source_init(source_t *const src, const char *const name)
+{
+    src->name = strv_dup(strv_cstr(name));
+    src->text = NULL;
+    src->len = 0;
+    src->map = NULL;
+    src->mapsiz = 0;
+}
+
+/* reads until the end of the descriptor, the size of a regular
+   file is the first capacity so it is read without copies */
+static bool_t _source_fill(source_t *const src, int fd, size_t hint)
+{
+    size_t cap = hint ? hint + 1 : CALC_SRC_CHUNK, len = 0, count;
+    char *text = (char *)checked_malloc(cap + CALC_SRC_PAD);
+    ssize_t r;
+
+    for (;;)
+    {
+        if (len == cap)
+        {
+            cap *= 2;
+            text = (char *)checked_realloc(text, cap + CALC_SRC_PAD);
+        }
+
+        count = (cap - len < _SRC_READMAX) ? cap - len : _SRC_READMAX;
+
+        if ((r = _src_read(fd, text + len, count)) > 0)
+            len += (size_t)r;
+        else if (!r)
+            break;
+        else if (errno != EINTR)
+        {
+            checked_free(text);
+            return FALSE;
+        }
+    }
+
+    memset(text + len, 0, CALC_SRC_PAD);
+
+    src->text = text;
+    src->len = len;
+
+    return TRUE;
+}
+
+#ifdef _WIN32
+
+/* the files are read, a mapping cannot be padded in place */
+#define _source_map(src, fd, size) FALSE
+
+#else
+
+static bool_t _source_map(source_t *const src, int fd, size_t size)
+{
+    size_t page = pagesiz, mapsiz = alignto(size + CALC_SRC_PAD, page);
+    void *map;
+
+    /* the rest of the last page of a file reads as zeros, when it
+       is too short for the padding the file is mapped over the
+       start of a zeroed anonymous mapping */
+    if (mapsiz == alignto(size, page))
+        map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    else if ((map = mmap(NULL, mapsiz, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)) != MAP_FAILED &&
+             mmap(map, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED)
+    {
+        munmap(map, mapsiz);
+        map = MAP_FAILED;
+    }
+
+    if (map == MAP_FAILED)
+        return FALSE;
+
+    /* the scanner reads it once from the start, the kernel can read
+       ahead aggressively and drop the pages behind */
+    madvise(map, size, MADV_SEQUENTIAL);
+
+    src->text = (const char *)map;
+    src->len = size;
+    src->map = map;
+    src->mapsiz = mapsiz;
+
+    return TRUE;
+}
+
+#endif // _WIN32
+
+#pragma endregion
+
+// +---- Internal (Sources) --------------------------- END ----+
+
+bool_t _CDECL source_open(source_t *const src, const char *const path)
+{
+    struct stat st;
+    bool_t result;
+    int fd, err;
+
+    if (!path || !strcmp(path, "-"))
+        return source_read(src, STDIN_FILENO, "<stdin>");
+
+    if ((fd = _src_open(path)) < 0)
+        return FALSE;
+
+    if (fstat(fd, &st) < 0)
+    {
+        err = errno;
+        _src_close(fd);
+        errno = err;
+
+        return FALSE;
+    }
+
+    if (S_ISREG(st.st_mode) && (uint64_t)st.st_size > SIZE_MAX / 2)
+    {
+        _src_close(fd);
+        errno = EFBIG;
+
+        return FALSE;
+    }
+
+    _source_init(src, path);
+
+    /* a mapping can fail on some file systems, they are read */
+    if (S_ISREG(st.st_mode))
+        result = ((size_t)st.st_size >= CALC_SRC_MAPMIN && _source_map(src, fd, (size_t)st.st_size)) ||
+            _source_fill(src, fd, (size_t)st.st_size);
+    else
+        result = _source_fill(src, fd, 0);
+
+    err = errno;
+    _src_close(fd);
+
+    if (!result)
+    {
+        checked_free(src->name);
+        src->name = NULL;
+    }
+
+    errno = err;
+
+    return result;
+}
+
+bool_t _CDECL source_read(source_t *const src, int fd, const char *const name)
+{
+    _source_init(src, name);
+
+    if (_source_fill(src, fd, 0))
+        return TRUE;
+
+    checked_free(src->name);
+    src->name = NULL;
+
+    return FALSE;
+}
+
+source_t *_CDECL source_string(source_t *const src, const char *const name, const char *const text, size_t len)
+{
+    char *copy = (char *)checked_malloc(len + CALC_SRC_PAD);
+
+    memcpy(copy, text, len);
+    memset(copy + len, 0, CALC_SRC_PAD);
+
+    _source_init(src, name);
+    src->text = copy;
+    src->len = len;
+
+    return src;
+}
+
+void _CDECL source_close(source_t *const src)
+{
+#ifndef _WIN32
+    if (src->map)
+        munmap(src->map, src->mapsiz);
+    else
+#endif // _WIN32
+        checked_free((void *)src->text);
+
+    checked_free(src->name);
+
+    src->name = NULL;
+    src->text = NULL;
+    src->len = 0;
+    src->map = NULL;
+    src->mapsiz = 0;
+}
+
+// Source Manager
+
+// +---- Internal (Source Manager) -----------------------------+
+
+#pragma region Internal (Source Manager)
+
+/* finds the start of each line, a vector of chars at a time (the
+   padding lets the last one read past the end, it has no newline) */
+static void _srcfile_lines(srcfile_t *const file)
+{
+    const char *const text = file->src.text;
+    size_t i, len = file->src.len;
+    buf_t lines;
+#if _CALC_SSE2
+    const __m128i nl = _mm_set1_epi8('\n');
+    unsigned int mask;
+#else
+    const char *p;
+#endif // _CALC_SSE2
+
+    buf_init(&lines);
+    *buf_push(&lines, uint32_t) = 0;
+
+#if _CALC_SSE2
+    for (i = 0; i < len; i += 16)
+        for (mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(text + i)), nl));
+             mask; mask &= mask - 1)
+            *buf_push(&lines, uint32_t) = (uint32_t)(i + _ctz32(mask) + 1);
+#else
+    for (i = 0; (p = (const char *)memchr(text + i, '\n', len - i)) != NULL; i = (size_t)(p - text) + 1)
+        *buf_push(&lines, uint32_t) = (uint32_t)(p - text + 1);
+#endif // _CALC_SSE2
+
+    file->nlines = buf_count(&lines, uint32_t);
+    file->lines = (uint32_t *)memcpy(dim(uint32_t, file->nlines), lines.data, lines.len);
+
+    buf_release(&lines);
+}
+
+#pragma endregion
+
+// +---- Internal (Source Manager) -------------------- END ----+
+
+srcmgr_t *_CDECL srcmgr_init(srcmgr_t *const mgr)
+{
+    buf_init(&mgr->files);
+    tab_init(&mgr->names, sizeof(strv_t), sizeof(srcfile_t *), &tab_hash_strv, &tab_eq_strv, 0);
+
+    /* zero is no location */
+    mgr->next = 1;
+
+    return mgr;
+}
+
+void _CDECL srcmgr_release(srcmgr_t *const mgr)
+{
+    size_t i;
+    srcfile_t *file;
+
+    for (i = 0; i < srcmgr_count(mgr); i++)
+    {
+        file = buf_at(&mgr->files, srcfile_t *, i);
+
+        source_close(&file->src);
+        checked_free(file->lines);
+        checked_free(file);
+    }
+
+    buf_release(&mgr->files);
+    tab_release(&mgr->names);
+}
+
+srcfile_t *_CDECL srcmgr_load(srcmgr_t *const mgr, const char *const path)
+{
+    strv_t name = strv_cstr((!path || !strcmp(path, "-")) ? "<stdin>" : path);
+    srcfile_t **known = tab_get(&mgr->names, srcfile_t *, &name), *file;
+    source_t src;
+
+    if (known)
+        return *known;
+
+    if (!source_open(&src, path))
+        return NULL;
+
+    if (!(file = srcmgr_add(mgr, &src)))
+    {
+        source_close(&src);
+        errno = EFBIG;
+    }
+
+    return file;
+}
+
+srcfile_t *_CDECL srcmgr_add(srcmgr_t *const mgr, const source_t *const src)
+{
+    srcfile_t *file;
+    strv_t name;
+
+    /* a file takes a location more, for its end */
+    if (src->len >= (size_t)(CALC_SRCLOC_MAX - mgr->next))
+        return NULL;
+
+    file = alloc(srcfile_t);
+    file->src = *src;
+    file->base = mgr->next;
+    file->lines = NULL;
+    file->nlines = 0;
+
+    mgr->next += (srcloc_t)src->len + 1;
+    *buf_push(&mgr->files, srcfile_t *) = file;
+
+    name = strv_cstr(file->src.name);
+    *tab_set(&mgr->names, srcfile_t *, &name) = file;
+
+    return file;
+}
+
+srcfile_t *_CDECL srcmgr_file(const srcmgr_t *const mgr, srcloc_t loc)
+{
+    srcfile_t *const *files = (srcfile_t *const *)mgr->files.data;
+    size_t lo = 0, hi = srcmgr_count(mgr), mid;
+
+    if (!loc || loc >= mgr->next)
+        return NULL;
+
+    /* the last file whose base is not past the location */
+    while (hi - lo > 1)
+    {
+        mid = lo + (hi - lo) / 2;
+
+        if (files[mid]->base <= loc)
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    return files[lo];
+}
+
+bool_t _CDECL srcmgr_decode(const srcmgr_t *const mgr, srcloc_t loc, srcpos_t *const pos)
+{
+    srcfile_t *const file = srcmgr_file(mgr, loc);
+    size_t lo = 0, hi, mid, off;
+    const char *p, *end;
+    uint32_t col = 1;
+
+    if (!file)
+        return FALSE;
+
+    if (!file->lines)
+        _srcfile_lines(file);
+
+    off = loc - file->base;
+
+    for (hi = file->nlines; hi - lo > 1;)
+    {
+        mid = lo + (hi - lo) / 2;
+
+        if (file->lines[mid] <= off)
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    /* the continuation bytes of UTF-8 chars are not columns */
+    for (p = file->src.text + file->lines[lo], end = file->src.text + off; p < end; p++)
+        col += ((byte_t)*p & 0xC0) != 0x80;
+
+    pos->file = file;
+    pos->line = (uint32_t)lo + 1;
+    pos->col = col;
+
+    return TRUE;
+}
+
+// Streaming Sources
+
+// +---- Internal (Streaming Sources) --------------------------+
+
+#pragma region Internal (Streaming Sources)
+
+/// @brief Lexical states of the statement splitter.
+enum
+{
+    _SPLIT_CODE,
+    _SPLIT_STRING,
+    _SPLIT_CHAR,
+    _SPLIT_LINE,
+    _SPLIT_BLOCK,
+    _SPLIT_DOC
+};
+
+/* the splitter looks at most two chars ahead, for the doc
+   comment delimiters */
+#define _SPLIT_AHEAD 2
+
+static inline void _srcstream_reset(srcstream_t *const stream)
+{
+    stream->scan = 0;
+    stream->depth = 0;
+    stream->state = _SPLIT_CODE;
+    stream->code = FALSE;
+}
+
+/* scans the pending statement from where the last call stopped,
+   returning the length of the statement or zero if it is open */
+static size_t _srcstream_split(srcstream_t *const stream, const char *const text, size_t limit)
+{
+    size_t i = stream->scan, depth = stream->depth;
+    int state = stream->state;
+    bool_t code = stream->code;
+
+    for (; i < limit; i++)
+    {
+        switch (state)
+        {
+            case _SPLIT_CODE:
+                switch (text[i])
+                {
+                    case ' ': case '\t': case '\r': case '\n':
+                        break;
+
+                    case '/':
+                        if (text[i + 1] == '/')
+                        {
+                            state = (text[i + 2] == '*') ? _SPLIT_DOC : _SPLIT_LINE;
+                            i += (state == _SPLIT_DOC) ? 2 : 1;
+                        }
+                        else if (text[i + 1] == '*')
+                        {
+                            state = _SPLIT_BLOCK;
+                            i++;
+                        }
+                        else
+                            code = TRUE;
+                        break;
+
+                    case '"':
+                        state = _SPLIT_STRING;
+                        code = TRUE;
+                        break;
+
+                    case '\'':
+                        state = _SPLIT_CHAR;
+                        code = TRUE;
+                        break;
+
+                    case '(': case '[': case '{':
+                        depth++;
+                        code = TRUE;
+                        break;
+
+                    case ')': case ']':
+                        depth -= depth > 0;
+                        code = TRUE;
+                        break;
+
+                    case '}':
+                        code = TRUE;
+
+                        if (depth && !--depth)
+                            goto split;
+                        break;
+
+                    case ';':
+                        if (!depth)
+                            goto split;
+                        break;
+
+                    default:
+                        code = TRUE;
+                        break;
+                }
+                break;
+
+            case _SPLIT_STRING:
+            case _SPLIT_CHAR:
+                if (text[i] == '\\')
+                    i++;
+                else if (text[i] == ((state == _SPLIT_STRING) ? '"' : '\''))
+                    state = _SPLIT_CODE;
+                break;
+
+            case _SPLIT_LINE:
+                if (text[i] == '\n')
+                    state = _SPLIT_CODE;
+                break;
+
+            case _SPLIT_BLOCK:
+                if (text[i] == '*' && text[i + 1] == '/')
+                {
+                    state = _SPLIT_CODE;
+                    i++;
+                }
+                break;
+
+            case _SPLIT_DOC:
+                if (text[i] == '*' && text[i + 1] == '/' && text[i + 2] == '/')
+                {
+                    state = _SPLIT_CODE;
+                    i += 2;
+                }
+                break;
+        }
+    }
+
+    stream->scan = i;
+    stream->depth = depth;
+    stream->state = state;
+    stream->code = code;
+
+    return 0;
+
+split:
+    stream->code = code;
+
+    return i + 1;
+}
+
+#pragma endregion
+
+// +---- Internal (Streaming Sources) ----------------- END ----+
+
+srcstream_t *_CDECL srcstream_init(srcstream_t *const stream, int fd, size_t chunk, writer_t *const tie)
+{
+    reader_init(&stream->reader, fd, chunk, tie);
+    _srcstream_reset(stream);
+
+    return stream;
+}
+
+void _CDECL srcstream_release(srcstream_t *const stream)
+{
+    reader_release(&stream->reader);
+}
+
+bool_t _CDECL srcstream_next(srcstream_t *const stream, strv_t *const stmt)
+{
+    reader_t *const reader = &stream->reader;
+    size_t avail, len;
+    bool_t code;
+
+    for (;;)
+    {
+        avail = reader_avail(reader);
+
+        /* until the end a token can continue in the next chunk, the
+           last chars are split once the chars after them are read
+           (past the end there are the zeros of the padding) */
+        if (reader->eof)
+            len = _srcstream_split(stream, reader_data(reader), avail);
+        else
+            len = _srcstream_split(stream, reader_data(reader), avail > _SPLIT_AHEAD ? avail - _SPLIT_AHEAD : 0);
+
+        if (!len && reader->eof)
+            len = avail;
+
+        if (len)
+        {
+            code = stream->code;
+            *stmt = strv(reader_data(reader), len);
+
+            reader_consume(reader, len);
+            _srcstream_reset(stream);
+
+            /* blanks, comments and empty statements are skipped */
+            if (code)
+                return TRUE;
+
+            continue;
+        }
+
+        if (reader->eof || (!reader_fill(reader) && reader->error))
+            return FALSE;
+    }
+}
+
+/* =------------------------------------------------------------= */
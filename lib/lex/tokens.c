@@ -0,0 +1,129 @@
+#include "calc/lex/tokens.h"
+
+/* =---- Tokens ------------------------------------------------= */
+
+// +---- Internal (Keywords) -----------------------------------+
+
+#pragma region Internal (Keywords)
+
+#define KEYWORD_TABLE
+#include "calc/lex/tokens.inc"
+
+/// @brief Text of each keyword, indexed by kind.
+static const strv_t _kw_text[TOK_EOF] =
+{
+    { "", 0 },
+#define KEYWORD(name, text) { text, sizeof(text) - 1 },
+#include "calc/lex/tokens.inc"
+};
+
+/* packs the chars and the length the generator hashed */
+#define _kw_hash(str, len) ((uint32_t)(((uint32_t)(byte_t)(str)[0] | \
+    ((uint32_t)(byte_t)(str)[1] << 8) | ((uint32_t)(byte_t)(str)[(len) - 1] << 16) | \
+    ((uint32_t)(len) << 24)) * _KW_MUL) >> (32 - _KW_BITS))
+
+/// @brief Text of each token kind (see tok_text).
+static const char *const _tok_text[TOK_COUNT] =
+{
+    "identifier",
+#define KEYWORD(name, text) text,
+#include "calc/lex/tokens.inc"
+#define TOKEN(name, text) text,
+#include "calc/lex/tokens.inc"
+#define PUNCT(name, text) text,
+#include "calc/lex/tokens.inc"
+};
+
+#pragma endregion
+
+// +---- Internal (Keywords) -------------------------- END ----+
+
+tok_kind_t _CDECL tok_keyword(const char *const str, size_t len)
+{
+    tok_kind_t kind;
+
+    if (len < _KW_MINLEN || len > _KW_MAXLEN)
+        return TOK_IDENT;
+
+    kind = (tok_kind_t)_kw_slots[_kw_hash(str, len)];
+
+    return (_kw_text[kind].len == len && !memcmp(_kw_text[kind].ptr, str, len)) ? kind : TOK_IDENT;
+}
+
+strv_t _CDECL tok_kwtext(tok_kind_t kind)
+{
+    return _kw_text[tok_iskeyword(kind) ? kind : TOK_IDENT];
+}
+
+const char *_CDECL tok_text(tok_kind_t kind)
+{
+    return ((unsigned int)kind < TOK_COUNT) ? _tok_text[kind] : "unknown token";
+}
+
+// Token Streams
+
+tokstream_t *_CDECL tokstream_init(tokstream_t *const stream)
+{
+    stream->kinds = NULL;
+    stream->offsets = NULL;
+    stream->lens = NULL;
+    stream->count = 0;
+    stream->cap = 0;
+    stream->shifted = 0;
+    stream->shift = 0;
+
+    return stream;
+}
+
+void _CDECL tokstream_release(tokstream_t *const stream)
+{
+    checked_free(stream->kinds);
+    checked_free(stream->offsets);
+    checked_free(stream->lens);
+
+    tokstream_init(stream);
+}
+
+void _CDECL tokstream_reserve(tokstream_t *const stream, size_t cap)
+{
+    if (cap <= stream->cap)
+        return;
+
+    stream->kinds = (byte_t *)checked_realloc(stream->kinds, cap);
+    stream->offsets = (uint32_t *)checked_realloc(stream->offsets, cap * sizeof(uint32_t));
+    stream->lens = (uint32_t *)checked_realloc(stream->lens, cap * sizeof(uint32_t));
+    stream->cap = cap;
+}
+
+void _CDECL tokstream_settle(tokstream_t *const stream)
+{
+    size_t i;
+
+    for (i = stream->shifted; i < stream->count && stream->shift; i++)
+        stream->offsets[i] += stream->shift;
+
+    stream->shifted = 0;
+    stream->shift = 0;
+}
+
+void _CDECL tokstream_push(tokstream_t *const stream, const token_t *const token)
+{
+    if (stream->count == stream->cap)
+        tokstream_reserve(stream, stream->cap + stream->cap / 2 + 64);
+
+    stream->kinds[stream->count] = (byte_t)token->kind;
+    stream->offsets[stream->count] = (uint32_t)token->offset - (stream->count >= stream->shifted ? stream->shift : 0);
+    stream->lens[stream->count] = (uint32_t)token->len;
+    stream->count++;
+}
+
+token_t *_CDECL tokstream_get(const tokstream_t *const stream, size_t index, token_t *const token)
+{
+    token->kind = tokstream_kind(stream, index);
+    token->offset = tokstream_offset(stream, index);
+    token->len = stream->lens[index];
+
+    return token;
+}
+
+/* =------------------------------------------------------------= */
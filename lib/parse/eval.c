@@ -0,0 +1,269 @@
+#include "calc/parse/eval.h"
+#include "calc/lex/literal.h"
+#include "calc/lex/scanner.h"
+
+#include <math.h>
+
+/* =---- Evaluator ---------------------------------------------= */
+
+// +---- Internal (Evaluator) ----------------------------------+
+
+#pragma region Internal (Evaluator)
+
+/// @brief Position of the evaluator in the statement.
+typedef struct _eval_state
+{
+    /// @brief Scanner of the statement.
+    scanner_t scanner;
+    /// @brief Next token, not consumed yet.
+    token_t token;
+} eval_state_t;
+
+#define _real(value) ((value)->kind == EVAL_REAL ? (value)->as.r : (double)(value)->as.i)
+
+static eval_status_t _eval_sum(eval_state_t *const state, eval_value_t *const value);
+
+/* consumes the next token, the scanner skips the blanks and the
+   comments */
+static tok_kind_t _eval_next(eval_state_t *const state)
+{
+    return scanner_next(&state->scanner, &state->token);
+}
+
+/* decodes a literal as the lexer split it, the integers above
+   INT64_MAX overflow */
+static eval_status_t _eval_number(eval_state_t *const state, eval_value_t *const value)
+{
+    const char *str = state->scanner.text + state->token.offset;
+    lit_status_t status;
+    uint64_t n;
+
+    if (state->token.kind == TOK_LIT_REAL)
+    {
+        value->kind = EVAL_REAL;
+
+        /* a real too large for a double is infinite */
+        status = lit_real(str, state->token.len, &value->as.r);
+    }
+    else
+    {
+        value->kind = EVAL_INT;
+
+        if ((status = lit_int(str, state->token.len, &n)) == LIT_OVERFLOW || (!status && n > (uint64_t)INT64_MAX))
+            return EVAL_OVERFLOW;
+
+        value->as.i = (int64_t)n;
+    }
+
+    if (status == LIT_MALFORMED)
+        return EVAL_SYNTAX;
+
+    _eval_next(state);
+
+    return EVAL_OK;
+}
+
+static eval_status_t _eval_primary(eval_state_t *const state, eval_value_t *const value)
+{
+    eval_status_t status;
+
+    switch (state->token.kind)
+    {
+        case TOK_LIT_BIN:
+        case TOK_LIT_OCT:
+        case TOK_LIT_DEC:
+        case TOK_LIT_HEX:
+        case TOK_LIT_REAL:
+            return _eval_number(state, value);
+
+        case TOK_LPAREN:
+            _eval_next(state);
+
+            if ((status = _eval_sum(state, value)) != EVAL_OK)
+                return status;
+
+            if (state->token.kind != TOK_RPAREN)
+                return EVAL_SYNTAX;
+
+            _eval_next(state);
+
+            return EVAL_OK;
+
+        /* names, calls, declarations and increments need the parser */
+        case TOK_IDENT:
+        case TOK_PLUSPLUS:
+        case TOK_MINUSMINUS:
+            return EVAL_UNSUPPORTED;
+
+        default:
+            return tok_iskeyword(state->token.kind) ? EVAL_UNSUPPORTED : EVAL_SYNTAX;
+    }
+}
+
+static eval_status_t _eval_unary(eval_state_t *const state, eval_value_t *const value)
+{
+    eval_status_t status;
+    tok_kind_t op = state->token.kind;
+
+    if (op != TOK_MINUS && op != TOK_PLUS)
+        return _eval_primary(state, value);
+
+    _eval_next(state);
+
+    if ((status = _eval_unary(state, value)) != EVAL_OK || op == TOK_PLUS)
+        return status;
+
+    if (value->kind == EVAL_REAL)
+        value->as.r = -value->as.r;
+    else if (value->as.i == INT64_MIN)
+        return EVAL_OVERFLOW;
+    else
+        value->as.i = -value->as.i;
+
+    return EVAL_OK;
+}
+
+/* applies a binary operator, integers stay integers */
+static eval_status_t _eval_apply(tok_kind_t op, eval_value_t *const lhs, const eval_value_t *const rhs)
+{
+    int64_t a = lhs->as.i, b = rhs->as.i;
+
+    if (lhs->kind == EVAL_REAL || rhs->kind == EVAL_REAL)
+    {
+        double x = _real(lhs), y = _real(rhs);
+
+        switch (op)
+        {
+            case TOK_PLUS: x += y; break;
+            case TOK_MINUS: x -= y; break;
+            case TOK_STAR: x *= y; break;
+            case TOK_SLASH: x /= y; break;
+            case TOK_PERCENT: x = fmod(x, y); break;
+            default: break;
+        }
+
+        lhs->kind = EVAL_REAL;
+        lhs->as.r = x;
+
+        return EVAL_OK;
+    }
+
+    switch (op)
+    {
+        case TOK_PLUS:
+            if ((b > 0 && a > INT64_MAX - b) || (b < 0 && a < INT64_MIN - b))
+                return EVAL_OVERFLOW;
+
+            a += b;
+            break;
+
+        case TOK_MINUS:
+            if ((b < 0 && a > INT64_MAX + b) || (b > 0 && a < INT64_MIN + b))
+                return EVAL_OVERFLOW;
+
+            a -= b;
+            break;
+
+        case TOK_STAR:
+            if (a > 0 ? (b > 0 ? a > INT64_MAX / b : b < INT64_MIN / a)
+                      : (b > 0 ? a < INT64_MIN / b : (a && b < INT64_MAX / a)))
+                return EVAL_OVERFLOW;
+
+            a *= b;
+            break;
+
+        case TOK_SLASH:
+        case TOK_PERCENT:
+            if (!b)
+                return EVAL_DIVZERO;
+
+            if (a == INT64_MIN && b == -1)
+                return EVAL_OVERFLOW;
+
+            a = (op == TOK_SLASH) ? a / b : a % b;
+            break;
+
+        default:
+            break;
+    }
+
+    lhs->as.i = a;
+
+    return EVAL_OK;
+}
+
+static eval_status_t _eval_product(eval_state_t *const state, eval_value_t *const value)
+{
+    eval_status_t status = _eval_unary(state, value);
+    eval_value_t rhs;
+    tok_kind_t op;
+
+    while (status == EVAL_OK && ((op = state->token.kind) == TOK_STAR || op == TOK_SLASH || op == TOK_PERCENT))
+    {
+        _eval_next(state);
+
+        if ((status = _eval_unary(state, &rhs)) == EVAL_OK)
+            status = _eval_apply(op, value, &rhs);
+    }
+
+    return status;
+}
+
+static eval_status_t _eval_sum(eval_state_t *const state, eval_value_t *const value)
+{
+    eval_status_t status = _eval_product(state, value);
+    eval_value_t rhs;
+    tok_kind_t op;
+
+    while (status == EVAL_OK && ((op = state->token.kind) == TOK_PLUS || op == TOK_MINUS))
+    {
+        _eval_next(state);
+
+        if ((status = _eval_product(state, &rhs)) == EVAL_OK)
+            status = _eval_apply(op, value, &rhs);
+    }
+
+    return status;
+}
+
+#pragma endregion
+
+// +---- Internal (Evaluator) ------------------------- END ----+
+
+eval_status_t _CDECL eval_expr(strv_t text, eval_value_t *const value)
+{
+    eval_state_t state;
+    eval_status_t status;
+
+    scanner_init(&state.scanner, text.ptr, text.len);
+    _eval_next(&state);
+
+    if ((status = _eval_sum(&state, value)) != EVAL_OK)
+        return status;
+
+    if (state.token.kind == TOK_SEMI)
+        _eval_next(&state);
+
+    return (state.token.kind != TOK_EOF) ? EVAL_SYNTAX : EVAL_OK;
+}
+
+const char *_CDECL eval_strerror(eval_status_t status)
+{
+    switch (status)
+    {
+        case EVAL_OK:
+            return "no error";
+        case EVAL_SYNTAX:
+            return "syntax error";
+        case EVAL_UNSUPPORTED:
+            return "not a constant expression";
+        case EVAL_DIVZERO:
+            return "division by zero";
+        case EVAL_OVERFLOW:
+            return "integer overflow";
+    }
+
+    return "unknown error";
+}
+
+/* =------------------------------------------------------------= */
@@ -0,0 +1,136 @@
+# Keyword Perfect Hash Generator Script
+#
+# Reads the keywords from the grammar of the VS Code extension and
+# writes their X-macro list and a collision-free hash table into
+# include/calc/lex/tokens.inc, between the keywords region markers
+# (the rest of the file is kept).
+#
+# The hash packs the first two chars, the last char and the length
+# of a keyword in 32 bits and keeps the top bits of their product
+# with a multiplier, searched until no two keywords collide.
+
+import json
+import os
+import random
+import re
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+GRAMMAR = os.path.join(ROOT, "utils", "vscode-calc", "syntaxes", "calc.tmLanguage.json")
+OUTPUT = os.path.join(ROOT, "include", "calc", "lex", "tokens.inc")
+
+BEGIN = "// +---- Keywords (Generated) ----------------------------------+"
+END = "// +---- Keywords (Generated) ------------------------- END ----+"
+
+# grammar rules whose words are reserved
+RULES = ["keywords", "types", "meta-types"]
+
+
+def GetKeywords():
+    with open(GRAMMAR) as file:
+        repository = json.load(file)["repository"]
+
+    keywords = []
+
+    for rule in RULES:
+        for pattern in repository[rule]["patterns"]:
+            for group in re.findall(r"\\b\(([a-z|]+)\)\\b", pattern.get("match", "")):
+                for word in group.split("|"):
+                    if word not in keywords:
+                        keywords.append(word)
+
+    return keywords
+
+
+def GetKey(word):
+    return ord(word[0]) | (ord(word[1]) << 8) | (ord(word[-1]) << 16) | (len(word) << 24)
+
+
+def GetHash(key, mul, bits):
+    return ((key * mul) & 0xFFFFFFFF) >> (32 - bits)
+
+
+def FindMultiplier(keys, bits, tries):
+    rng = random.Random(0x5EED)
+
+    for _ in range(tries):
+        mul = rng.getrandbits(32) | 1
+
+        if len(set(GetHash(key, mul, bits) for key in keys)) == len(keys):
+            return mul
+
+    return None
+
+
+def GenKeywordHash():
+    keywords = GetKeywords()
+    keys = [GetKey(word) for word in keywords]
+
+    if len(set(keys)) != len(keys):
+        raise SystemExit("two keywords share the hashed chars and length")
+
+    bits = max(len(keywords) - 1, 1).bit_length()
+    mul = None
+
+    while mul is None:
+        mul = FindMultiplier(keys, bits, 1000000)
+
+        if mul is None:
+            bits = bits + 1
+
+    slots = ["TOK_IDENT"] * (1 << bits)
+
+    for word, key in zip(keywords, keys):
+        slots[GetHash(key, mul, bits)] = "TOK_KW_" + word.upper()
+
+    lines = [BEGIN, ""]
+    lines.append("/* generated by scripts/GenKeywordHash.py, do not edit */")
+    lines.append("")
+    lines.append("#ifdef KEYWORD")
+    lines.append("")
+
+    for word in keywords:
+        lines.append("KEYWORD(%s, \"%s\")" % (word.upper(), word))
+
+    lines.append("")
+    lines.append("#undef KEYWORD")
+    lines.append("#endif // KEYWORD")
+    lines.append("")
+    lines.append("#ifdef KEYWORD_TABLE")
+    lines.append("")
+    lines.append("#define _KW_MINLEN %d" % min(len(word) for word in keywords))
+    lines.append("#define _KW_MAXLEN %d" % max(len(word) for word in keywords))
+    lines.append("#define _KW_BITS %d" % bits)
+    lines.append("#define _KW_MUL 0x%08XU" % mul)
+    lines.append("")
+    lines.append("/* kind of the keyword of each hash, TOK_IDENT if none */")
+    lines.append("static const byte_t _kw_slots[%d] =" % (1 << bits))
+    lines.append("{")
+
+    for i in range(0, len(slots), 4):
+        lines.append("    " + " ".join(slot + "," for slot in slots[i:i + 4]))
+
+    lines.append("};")
+    lines.append("")
+    lines.append("#undef KEYWORD_TABLE")
+    lines.append("#endif // KEYWORD_TABLE")
+    lines.append("")
+    lines.append(END)
+
+    text = ""
+
+    if os.path.exists(OUTPUT):
+        with open(OUTPUT) as file:
+            text = file.read()
+
+    if BEGIN in text and END in text:
+        text = text[:text.index(BEGIN)] + "\n".join(lines) + text[text.index(END) + len(END):]
+    else:
+        text = text + "\n".join(lines) + "\n"
+
+    with open(OUTPUT, "w", newline="\n") as file:
+        file.write(text)
+
+    print("%d keywords, %d slots, multiplier 0x%08X" % (len(keywords), 1 << bits, mul))
+
+
+GenKeywordHash()
@@ -0,0 +1,87 @@
+# Power Table Generator Script
+#
+# Writes into include/calc/lex/tokens.inc, between the power region
+# markers (the rest of the file is kept), the powers of five used by
+# the real literal decoder (see lib/lex/literal.c): for each decimal
+# exponent q the 128 most significant bits of 5^q, normalized so the
+# highest bit is set, as two 64 bits halves. The negative powers are
+# the reciprocals, rounded up, as in the Eisel-Lemire algorithm.
+
+import os
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+OUTPUT = os.path.join(ROOT, "include", "calc", "lex", "tokens.inc")
+
+BEGIN = "// +---- Powers of Five (Generated) ----------------------------+"
+END = "// +---- Powers of Five (Generated) ------------------- END ----+"
+
+# range of the exponents, a decimal real beyond them is zero or
+# infinite whatever its 19 digits
+SMALLEST = -342
+LARGEST = 308
+
+
+def GetPower(q):
+    power = 5 ** abs(q)
+
+    if q >= 0:
+        while power < (1 << 127):
+            power *= 2
+
+        while power >= (1 << 128):
+            power //= 2
+
+        return power
+
+    bits = power.bit_length()
+
+    if q >= -27:
+        return (1 << (bits + 127)) // power + 1
+
+    power = (1 << (2 * bits + 128)) // power + 1
+
+    while power >= (1 << 128):
+        power //= 2
+
+    return power
+
+
+def GenPowerTable():
+    lines = [BEGIN, "", "/* generated by scripts/GenPowerTable.py, do not edit */", ""]
+
+    lines.append("#ifdef LITERAL_TABLE")
+    lines.append("")
+    lines.append("#define _LIT_POW_MIN (%d)" % SMALLEST)
+    lines.append("#define _LIT_POW_MAX %d" % LARGEST)
+    lines.append("")
+    lines.append("/* high and low halves of 5^q, from _LIT_POW_MIN */")
+    lines.append("static const uint64_t _lit_pow5[%d][2] =" % (LARGEST - SMALLEST + 1))
+    lines.append("{")
+
+    for q in range(SMALLEST, LARGEST + 1):
+        power = GetPower(q)
+        lines.append("    {UINT64_C(0x%016X), UINT64_C(0x%016X)}, /* %d */" % (power >> 64, power & ((1 << 64) - 1), q))
+
+    lines.append("};")
+    lines.append("")
+    lines.append("#undef LITERAL_TABLE")
+    lines.append("#endif // LITERAL_TABLE")
+    lines.append("")
+    lines.append(END)
+
+    with open(OUTPUT) as file:
+        text = file.read()
+
+    if BEGIN in text and END in text:
+        text = text[:text.index(BEGIN)] + "\n".join(lines) + text[text.index(END) + len(END):]
+    else:
+        close = text.rindex("/* =----")
+        text = text[:close] + "\n".join(lines) + "\n\n" + text[close:]
+
+    with open(OUTPUT, "w", newline="\n") as file:
+        file.write(text)
+
+    print("%d powers, %d bytes" % (LARGEST - SMALLEST + 1, (LARGEST - SMALLEST + 1) * 16))
+
+
+GenPowerTable()
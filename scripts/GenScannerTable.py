@@ -0,0 +1,492 @@
+# Scanner Table Generator Script
+#
+# Builds the deterministic automaton of the scanner from the
+# punctuators listed in include/calc/lex/tokens.inc and from the
+# lexical rules of the grammar (blanks, comments, literals and
+# identifiers), merges the bytes with the same transitions into
+# classes and writes the class map and the transition table into
+# tokens.inc, between the scanner region markers (the rest of the
+# file is kept).
+#
+# The rules are tried longest match first, then in the order they
+# are listed. The transitions are premultiplied by the width of a
+# row, so the scanner steps with one load and one add, and the last
+# column of each row is the token accepted in the state. There is
+# no dead state: a second table flags the transitions that end the
+# token (a boundary before the byte) and the ones into a state that
+# loops on many bytes, skipped in runs by the scanner.
+
+import os
+import re
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+OUTPUT = os.path.join(ROOT, "include", "calc", "lex", "tokens.inc")
+
+BEGIN = "// +---- Scanner (Generated) -----------------------------------+"
+END = "// +---- Scanner (Generated) -------------------------- END ----+"
+
+ALL = frozenset(range(256))
+
+# flags of a transition
+RUN = 0x01
+BOUNDARY = 0x02
+
+# a state looping on at least as many bytes is skipped in runs
+LOOPS = 6
+# the bytes of a run are checked as this many ranges at most
+RANGES = 6
+
+
+def Chars(text):
+    return frozenset(ord(ch) for ch in text)
+
+
+def Range(first, last):
+    return frozenset(range(ord(first), ord(last) + 1))
+
+
+def Not(chars):
+    return ALL - chars
+
+
+# Regular Expressions
+
+
+def Set(chars):
+    return ("set", frozenset(chars))
+
+
+def Lit(text):
+    return ("cat", [Set(Chars(ch)) for ch in text])
+
+
+def Cat(*nodes):
+    return ("cat", list(nodes))
+
+
+def Alt(*nodes):
+    return ("alt", list(nodes))
+
+
+def Star(node):
+    return ("star", node)
+
+
+def Plus(node):
+    return Cat(node, Star(node))
+
+
+def Opt(node):
+    return Alt(node, Cat())
+
+
+def Until(term):
+    """Any text up to and including the first occurrence of term."""
+    return ("until", term, False)
+
+
+def Body(term):
+    """Any text without term, the open body of a delimited rule."""
+    return ("until", term, True)
+
+
+# Automata
+
+
+class Nfa:
+    def __init__(self):
+        self.edges = []
+        self.eps = []
+        self.accept = {}
+
+    def State(self):
+        self.edges.append([])
+        self.eps.append([])
+
+        return len(self.edges) - 1
+
+    def Build(self, node):
+        kind = node[0]
+
+        if kind == "set":
+            start, end = self.State(), self.State()
+            self.edges[start].append((node[1], end))
+        elif kind == "cat":
+            start = end = self.State()
+
+            for child in node[1]:
+                first, last = self.Build(child)
+                self.eps[end].append(first)
+                end = last
+        elif kind == "alt":
+            start, end = self.State(), self.State()
+
+            for child in node[1]:
+                first, last = self.Build(child)
+                self.eps[start].append(first)
+                self.eps[last].append(end)
+        elif kind == "star":
+            start, end = self.State(), self.State()
+            first, last = self.Build(node[1])
+            self.eps[start] += [first, end]
+            self.eps[last] += [first, end]
+        else:
+            start, end = self.BuildUntil(node[1], node[2])
+
+        return start, end
+
+    def BuildUntil(self, term, body):
+        # the matching automaton of term (Knuth-Morris-Pratt), its
+        # states are the length of the matched prefix
+        size = len(term)
+        states = [self.State() for _ in range(size + 1)]
+        fail = [0] * (size + 1)
+
+        for j in range(1, size):
+            k = fail[j]
+
+            while k and term[k] != term[j]:
+                k = fail[k]
+
+            fail[j + 1] = k + 1 if term[k] == term[j] else 0
+
+        for j in range(size):
+            targets = {}
+
+            for byte in range(256):
+                k = j
+
+                while k and term[k] != chr(byte):
+                    k = fail[k]
+
+                k = k + 1 if term[k] == chr(byte) else 0
+
+                if not body or k < size:
+                    targets.setdefault(k, set()).add(byte)
+
+            for k, chars in targets.items():
+                self.edges[states[j]].append((frozenset(chars), states[k]))
+
+        if not body:
+            return states[0], states[size]
+
+        end = self.State()
+
+        for j in range(size):
+            self.eps[states[j]].append(end)
+
+        return states[0], end
+
+    def Closure(self, states):
+        stack, seen = list(states), set(states)
+
+        while stack:
+            for state in self.eps[stack.pop()]:
+                if state not in seen:
+                    seen.add(state)
+                    stack.append(state)
+
+        return frozenset(seen)
+
+
+def GenDfa(rules):
+    nfa = Nfa()
+    start = nfa.State()
+
+    for priority, (kind, node) in enumerate(rules):
+        first, last = nfa.Build(node)
+        nfa.eps[start].append(first)
+        nfa.accept[last] = (priority, kind)
+
+    # subset construction, the empty set is the dead state
+    dead = frozenset()
+    first = nfa.Closure([start])
+    index = {dead: 0, first: 1}
+    order = [dead, first]
+    trans = []
+
+    for current in order:
+        row = []
+
+        for byte in range(256):
+            moves = set()
+
+            for state in current:
+                for chars, target in nfa.edges[state]:
+                    if byte in chars:
+                        moves.add(target)
+
+            target = nfa.Closure(moves) if moves else dead
+
+            if target not in index:
+                index[target] = len(order)
+                order.append(target)
+
+            row.append(index[target])
+
+        trans.append(row)
+
+    accept = []
+
+    for current in order:
+        kinds = [nfa.accept[state] for state in current if state in nfa.accept]
+        accept.append(min(kinds)[1] if kinds else None)
+
+    return Minimize(trans, accept)
+
+
+def Minimize(trans, accept):
+    # Moore: split the states by their token, then by the blocks of
+    # their transitions until nothing changes
+    blocks = [accept.index(kind) for kind in accept]
+
+    while True:
+        keys = [(blocks[state], tuple(blocks[target] for target in trans[state])) for state in range(len(trans))]
+        numbers = {}
+        split = [numbers.setdefault(key, len(numbers)) for key in keys]
+
+        if len(numbers) == len(set(blocks)):
+            break
+
+        blocks = split
+
+    # renumber from the start state, keeping the dead one first
+    number = {blocks[0]: 0, blocks[1]: 1}
+    queue = [1]
+
+    for state in queue:
+        for target in trans[state]:
+            if blocks[target] not in number:
+                number[blocks[target]] = len(number)
+                queue.append(target)
+
+    states = [None] * len(number)
+
+    for state in range(len(trans)):
+        if blocks[state] in number and states[number[blocks[state]]] is None:
+            states[number[blocks[state]]] = state
+
+    return ([[number[blocks[target]] for target in trans[state]] for state in states],
+            [accept[state] for state in states])
+
+
+def GetRules():
+    with open(OUTPUT) as file:
+        text = file.read()
+
+    punct = re.findall(r"^PUNCT\((\w+), \"(.+)\"\)$", text, re.MULTILINE)
+
+    if not punct:
+        raise SystemExit("no punctuators in tokens.inc")
+
+    digit = Range("0", "9")
+    idstart = Chars("$_") | Range("A", "Z") | Range("a", "z")
+    idcont = idstart | digit
+    utf8 = frozenset(range(0x80, 0x100))
+    zeros = Plus(Lit("0"))
+
+    def Quoted(quote, chars):
+        return Star(Alt(Set(chars - Chars(quote + "\\")), Cat(Lit("\\"), Set(chars))))
+
+    rules = [
+        ("_SCAN_SKIP", Plus(Set(Chars(" \t\v\f\r\n")))),
+        ("_SCAN_SKIP", Cat(Lit("//"), Opt(Cat(Set(Not(Chars("*\n"))), Star(Set(Not(Chars("\n")))))))),
+        ("_SCAN_SKIP", Cat(Lit("//*"), Until("*//"))),
+        ("_SCAN_SKIP", Cat(Lit("/*"), Until("*/"))),
+        ("TOK_LIT_CHAR", Cat(Lit("'"), Quoted("'", Not(Chars("\n"))), Lit("'"))),
+        ("TOK_LIT_STRING", Cat(Lit("\""), Quoted("\"", ALL), Lit("\""))),
+        ("TOK_LIT_DEC", Alt(Plus(Set(digit)), Cat(zeros, Set(Chars("Dd")), Plus(Set(digit))))),
+        ("TOK_LIT_BIN", Cat(zeros, Set(Chars("Bb")), Plus(Set(Chars("01"))))),
+        ("TOK_LIT_OCT", Cat(zeros, Set(Chars("Cc")), Plus(Set(Range("0", "7"))))),
+        ("TOK_LIT_HEX", Cat(zeros, Set(Chars("Xx")), Plus(Set(digit | Range("A", "F") | Range("a", "f"))))),
+        ("TOK_LIT_REAL", Cat(Plus(Set(digit)), Lit("."), Plus(Set(digit)),
+                             Opt(Cat(Set(Chars("Ee")), Opt(Set(Chars("+-"))), Plus(Set(digit)))))),
+        ("TOK_IDENT", Cat(Set(idstart), Star(Set(idcont)))),
+        ("_SCAN_UIDENT", Cat(Set(idstart | utf8), Star(Set(idcont | utf8))))
+    ]
+
+    rules += [("TOK_" + name, Lit(spelling)) for name, spelling in punct]
+
+    rules += [
+        ("TOK_ERR_NUMBER", Cat(Set(digit), Star(Alt(Set(idcont), Cat(Lit("."), Set(digit)))))),
+        ("TOK_ERR_COMMENT", Cat(Lit("//*"), Body("*//"))),
+        ("TOK_ERR_COMMENT", Cat(Lit("/*"), Body("*/"))),
+        ("TOK_ERR_CHARLIT", Cat(Lit("'"), Quoted("'", Not(Chars("\n"))), Opt(Lit("\\")))),
+        ("TOK_ERR_STRING", Cat(Lit("\""), Quoted("\"", ALL), Opt(Lit("\\")))),
+        ("TOK_ERR_CHAR", Set(ALL))
+    ]
+
+    return rules
+
+
+def GenScannerTable():
+    trans, accept = GenDfa(GetRules())
+
+    # the dead state is dropped: a transition to it ends the token
+    # and goes on from the start state (the first one) with the same
+    # byte, so the scanner never stops in the middle of the text
+    columns = {}
+    classes = [0] * 256
+
+    for byte in range(256):
+        column = tuple(row[byte] for row in trans)
+        classes[byte] = columns.setdefault(column, len(columns))
+
+    count = len(columns)
+    width = count + 1
+    states = len(trans) - 1
+
+    # the states looping on many bytes (blanks, identifiers, numbers
+    # and the bodies of comments and strings) are skipped in runs
+    run = [sum(target == state for target in row) >= LOOPS for state, row in enumerate(trans)]
+    table, flags = [], []
+
+    for state, row in enumerate(trans[1:], 1):
+        cells, bits = [0] * count, [0] * count
+
+        for byte in range(256):
+            target, flag = row[byte], 0
+
+            if not target:
+                target, flag = trans[1][byte], BOUNDARY
+
+            if run[target]:
+                # the runs are skipped while the state does not change
+                if target == state and flag:
+                    raise SystemExit("a run state starts again on its own boundary")
+
+                flag |= RUN
+
+            cells[classes[byte]] = (target - 1) * width
+            bits[classes[byte]] = flag
+
+        table.append(cells + [accept[state] or "_SCAN_NONE"])
+        flags.append(bits + [0])
+
+    # the bytes on which each run state loops, as ranges (first byte
+    # and length minus one) for the vector skip loops, the unused ones
+    # repeat the first
+    runs, index = [], [0] * states
+
+    for state, row in enumerate(trans[1:], 1):
+        if not run[state]:
+            continue
+
+        ranges = []
+
+        for byte in range(256):
+            if row[byte] != state:
+                continue
+
+            if ranges and ranges[-1][1] == byte - 1:
+                ranges[-1][1] = byte
+            else:
+                ranges.append([byte, byte])
+
+        if len(ranges) > RANGES:
+            raise SystemExit("too many ranges in the run of state %d" % (state - 1))
+
+        ranges += [ranges[0]] * (RANGES - len(ranges))
+        ranges = [first for first, _ in ranges] + [last - first for first, last in ranges]
+
+        if ranges not in runs:
+            runs.append(ranges)
+
+        index[state - 1] = runs.index(ranges)
+
+    lines = [BEGIN, ""]
+    lines.append("/* generated by scripts/GenScannerTable.py, do not edit */")
+    lines.append("")
+    lines.append("#ifdef SCANNER_TABLE")
+    lines.append("")
+    lines.append("#define _SCAN_CLASSES %d" % count)
+    lines.append("#define _SCAN_WIDTH %d" % width)
+    lines.append("#define _SCAN_STATES %d" % states)
+    lines.append("#define _SCAN_START 0")
+    lines.append("")
+    lines.append("#define _SCAN_RUNS %d" % len(runs))
+    lines.append("#define _SCAN_RANGES %d" % RANGES)
+    lines.append("")
+    lines.append("#define _SCAN_RUN 0x%02X" % RUN)
+    lines.append("#define _SCAN_BOUNDARY 0x%02X" % BOUNDARY)
+    lines.append("")
+    lines.append("/* class of each byte */")
+    lines.append("static const byte_t _scan_class[256] =")
+    lines.append("{")
+
+    for i in range(0, 256, 16):
+        lines.append("    " + " ".join("%2d," % cls for cls in classes[i:i + 16]))
+
+    lines.append("};")
+    lines.append("")
+    lines.append("/* next state of each state and class, premultiplied by the")
+    lines.append("   width, and the token accepted in the state (last column) */")
+    lines.append("static const uint16_t _scan_dfa[_SCAN_STATES * _SCAN_WIDTH] =")
+    lines.append("{")
+
+    for state, cells in enumerate(table):
+        cells = ["%4d" % cell for cell in cells[:-1]] + [cells[-1]]
+        lines.append("    /* %d */" % state)
+
+        for i in range(0, len(cells), 16):
+            lines.append("    " + " ".join(cell + "," for cell in cells[i:i + 16]))
+
+    lines.append("};")
+    lines.append("")
+    lines.append("/* flags of each transition, at the same index */")
+    lines.append("static const byte_t _scan_flags[_SCAN_STATES * _SCAN_WIDTH] =")
+    lines.append("{")
+
+    for state, bits in enumerate(flags):
+        lines.append("    /* %d */" % state)
+
+        for i in range(0, len(bits), 16):
+            lines.append("    " + " ".join("%d," % bit for bit in bits[i:i + 16]))
+
+    lines.append("};")
+    lines.append("")
+    lines.append("/* bytes of each run, as the first bytes and the lengths minus")
+    lines.append("   one of its ranges, repeated to fill a vector */")
+    lines.append("static const byte_t _scan_runs[_SCAN_RUNS][_SCAN_RANGES * 2][16] =")
+    lines.append("{")
+
+    for ranges in runs:
+        lines.append("    {")
+
+        for byte in ranges:
+            lines.append("        {" + ", ".join(["%d" % byte] * 16) + "},")
+
+        lines.append("    },")
+
+    lines.append("};")
+    lines.append("")
+    lines.append("/* run of each state (where the state loops) */")
+    lines.append("static const byte_t _scan_run[_SCAN_STATES] =")
+    lines.append("{")
+
+    for i in range(0, len(index), 16):
+        lines.append("    " + " ".join("%2d," % run for run in index[i:i + 16]))
+
+    lines.append("};")
+    lines.append("")
+    lines.append("#undef SCANNER_TABLE")
+    lines.append("#endif // SCANNER_TABLE")
+    lines.append("")
+    lines.append(END)
+
+    with open(OUTPUT) as file:
+        text = file.read()
+
+    if BEGIN in text and END in text:
+        text = text[:text.index(BEGIN)] + "\n".join(lines) + text[text.index(END) + len(END):]
+    else:
+        close = text.rindex("/* =----")
+        text = text[:close] + "\n".join(lines) + "\n\n" + text[close:]
+
+    with open(OUTPUT, "w", newline="\n") as file:
+        file.write(text)
+
+    print("%d states, %d classes, %d bytes" % (states, count, states * width * 3 + 256 + len(runs) * RANGES * 32 + states))
+
+
+GenScannerTable()
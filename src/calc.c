@@ -4,240 +4,72 @@
 
 #include "calc.h"
 
-/* =---- Memory Management -------------------------------------= */
-
-#pragma region Memory Management
-
-// +---- Internal (Memory Checks) ------------------------------+
-
-#pragma region Internal (Memory Checks)
-
-static inline void *_safety_abort(
-#ifdef _DEBUG
-    const char *const funcname
-#endif // _DEBUG
-)
-{
-#ifdef _DEBUG
-    fail("error: function %s cannot allocate memory", funcname);
-#else
-    fail("error: cannot allocate enough memory");
-#endif // _DEBUG
-
-    return NULL;
-}
-
-static inline void *_safety_check(
-#ifdef _DEBUG
-    const char *const funcname,
-#endif // _DEBUG
-    void *block
-)
-{
-    if (!block)
-        return _safety_abort(
-#ifdef _DEBUG
-            funcname
-#endif // _DEBUG
-        );
-    else
-        return block;
-}
-
-static inline void *_zerofy_block(void *block, size_t size)
+/* evaluates the statements of a stream as they complete, the
+   results are flushed before waiting for more input */
+static int calc_stream(int fd)
 {
-    assert(block != NULL);
+    int result = EXIT_SUCCESS;
+    unsigned long count = 0;
+    eval_status_t status;
+    eval_value_t value;
+    srcstream_t stream;
+    strv_t stmt;
 
-    char *p = (char *)block;
+    srcstream_init(&stream, fd, 0, wstdout);
 
-    for (; size > 0; size--)
-        p[size - 1] = 0x00;
-
-    return (void *)p;
-}
-
-#pragma endregion
-
-// +---- Internal (Memory Checks) --------------------- END ----+
-
-CALC_API void *CALC_CDECL calc_malloc(size_t size)
-{
-    return _safety_check(
-#ifdef _DEBUG
-        __func__,
-#endif // _DEBUG
-        malloc(size)
-    );
-}
-
-CALC_API void *CALC_CDECL calc_calloc(size_t count, size_t size)
-{
-    return _safety_check(
-#ifdef _DEBUG
-        __func__,
-#endif // _DEBUG
-        calloc(count, size)
-    );
-}
-
-CALC_API void *CALC_CDECL calc_malloc_z(size_t size)
-{
-    return _zerofy_block(_safety_check(
-#ifdef _DEBUG
-        __func__,
-#endif // _DEBUG
-        malloc(size)
-    ), size);
-}
-
-CALC_API void *CALC_CDECL calc_calloc_z(size_t count, size_t size)
-{
-    return _zerofy_block(_safety_check(
-#ifdef _DEBUG
-        __func__,
-#endif // _DEBUG
-        calloc(count, size)
-    ), count * size);
-}
-
-#pragma endregion
-
-/* =---- Data Management ---------------------------------------= */
-
-#pragma region Data Management
-
-// +---- String Operations -------------------------------------+
-
-#pragma region String Operations
-
-CALC_API char *CALC_CDECL strnget(char *const dst, const char *const src, size_t count)
-{
-    if (!count)
-        return dimz(char, 1);
-
-    char *r;
-
-    if (!dst)
-        r = dimz(char, count + 1);
-    else
-        r = dst;
-
-    r[count] = NUL;
-
-    return (!src) ? r : strncpy(r, src, count);
-}
-
-CALC_API char *CALC_CDECL strnlow(char *const dst, const char *const src, size_t count)
-{
-    if (!count)
-        return (char *)src;
-
-    char *r = strnget(dst, (const char *)NULL, count);
-
-    do
-        r[count - 1] = tolower(src[count - 1]);
-    while (--count > 0);
-
-    return r;
-}
-
-CALC_API char *CALC_CDECL strnupp(char *const dst, const char *const src, size_t count)
-{
-    if (!count)
-        return (char *)src;
-
-    char *r = strnget(dst, (const char *)NULL, count);
-
-    do
-        r[count - 1] = toupper(src[count - 1]);
-    while (--count > 0);
-
-    return r;
-}
-
-CALC_API char *CALC_CDECL strget(char *const dst, const char *const src)
-{
-    if (src)
-        return strnget(dst, src, strlen(src));
-    else
-        return dimz(char, 1);
-}
-
-CALC_API char *CALC_CDECL strlow(char *const dst, const char *const src)
-{
-    if (src)
-        return strnlow(dst, src, strlen(src));
-    else
-        return dst;
-}
-
-CALC_API char *CALC_CDECL strupp(char *const dst, const char *const src)
-{
-    if (src)
-        return strnupp(dst, src, strlen(src));
-    else
-        return dst;
-}
+    while (srcstream_next(&stream, &stmt))
+    {
+        count++;
 
-CALC_API bool_t CALC_CDECL streq(const char *const str1, const char *const str2)
-{
-    if (str1 == str2)
-        return TRUE;
+        if ((status = eval_expr(stmt, &value)) != EVAL_OK)
+        {
+            writer_flush(wstdout);
+            errorfn("calc: statement %lu: %s", count, eval_strerror(status));
+            result = EXIT_FAILURE;
 
-    if (!str1 || !str2)
-        return FALSE;
+            continue;
+        }
 
-    size_t len = strlen(str1);
+        if (value.kind == EVAL_INT)
+            writer_puti(wstdout, value.as.i);
+        else
+            writer_printf(wstdout, "%.15g", value.as.r);
 
-    if (len != strlen(str2))
-        return FALSE;
+        writer_putc(wstdout, '\n');
+    }
 
-    for (; len > 0; len--)
+    if (stream.reader.error)
     {
-        if (str1[len] != str2[len])
-            return FALSE;
-        else
-            continue;
+        errorfn("calc: cannot read the input");
+        result = EXIT_FAILURE;
     }
 
-    return TRUE;
+    srcstream_release(&stream);
+
+    return result;
 }
 
-CALC_API bool_t CALC_CDECL striq(const char *const str1, const char *const str2)
+int main(int argc, char *argv[])
 {
-    if (str1 == str2)
-        return TRUE;
-
-    if (!str1 || !str2)
-        return FALSE;
-
-    size_t len = strlen(str1);
+    bool_t memstats = FALSE;
+    int i, result;
 
-    if (len != strlen(str2))
-        return FALSE;
-
-    for (; len > 0; len--)
+    for (i = 1; i < argc; i++)
     {
-        if ((str1[len] != str2[len]) && (str1[len] != (tolower(str2[len]))))
-            return FALSE;
+        if (!strcmp(argv[i], "--mem-stats"))
+            memstats = TRUE;
         else
-            continue;
-    }
-
-    return TRUE;
-}
+        {
+            errorfn("calc: unknown option '%s'", argv[i]);
 
-#pragma endregion
-
-// +---- String Operations ---------------------------- END ----+
-
-#pragma endregion
+            return EXIT_FAILURE;
+        }
+    }
 
-/* =------------------------------------------------------------= */
+    result = calc_stream(STDIN_FILENO);
 
-int main(int argc, char *argv[])
-{
-    char *c = strlow(NULL, "HEllO, worLD!");
+    if (memstats)
+        memstats_print(stderr);
 
-    return EXIT_SUCCESS;
+    return result;
 }
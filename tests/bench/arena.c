@@ -0,0 +1,128 @@
+#include "bench.h"
+
+#include <ctype.h>
+
+/* =---- Arena Allocator Benchmark -----------------------------= */
+
+/// @brief Token-like node, allocated once per lexeme.
+typedef struct _node
+{
+    struct _node *next;
+    size_t offset;
+    size_t length;
+    char *text;
+} node_t;
+
+/// @brief Gets the length of the lexeme starting at src.
+static size_t lexeme(const char *const src)
+{
+    size_t n = 1;
+
+    if (isalnum((unsigned char)*src) || *src == '_')
+        while (isalnum((unsigned char)src[n]) || src[n] == '_')
+            n++;
+
+    return n;
+}
+
+static size_t run_heap(const char *const src, size_t len)
+{
+    node_t *head = NULL, *node;
+    size_t i = 0, count = 0;
+
+    while (i < len)
+    {
+        if (isspace((unsigned char)src[i]))
+        {
+            i++;
+            continue;
+        }
+
+        node = alloc(node_t);
+        node->next = head;
+        node->offset = i;
+        node->length = lexeme(src + i);
+        node->text = dimz(char, node->length + 1);
+        memcpy(node->text, src + i, node->length);
+
+        head = node;
+        i += node->length;
+        count++;
+    }
+
+    while (head)
+    {
+        node = head->next;
+        checked_free(head->text);
+        checked_free(head);
+        head = node;
+    }
+
+    return count;
+}
+
+static size_t run_arena(arena_t *const arena, const char *const src, size_t len)
+{
+    node_t *head = NULL, *node;
+    size_t i = 0, count = 0;
+
+    while (i < len)
+    {
+        if (isspace((unsigned char)src[i]))
+        {
+            i++;
+            continue;
+        }
+
+        node = arena_alloc(arena, node_t);
+        node->next = head;
+        node->offset = i;
+        node->length = lexeme(src + i);
+        node->text = arena_dimz(arena, char, node->length + 1);
+        memcpy(node->text, src + i, node->length);
+
+        head = node;
+        i += node->length;
+        count++;
+    }
+
+    arena_release(arena);
+
+    return count;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t len, count = 0;
+    char *src = bench_gensrc(bench_size(argc, argv, 64), &len);
+    arena_t arena;
+    double start, heap = 1e9, bump = 1e9, t;
+    int round;
+
+    arena_init(&arena, 0);
+
+    printf("source: %lu bytes\n", (unsigned long)len);
+
+    for (round = 0; round < 3; round++)
+    {
+        start = bench_now();
+        count = run_heap(src, len);
+        t = bench_now() - start;
+        heap = (t < heap) ? t : heap;
+
+        start = bench_now();
+        count = run_arena(&arena, src, len);
+        t = bench_now() - start;
+        bump = (t < bump) ? t : bump;
+    }
+
+    bench_report("alloc/dimz + free", heap, (double)count, "node");
+    bench_report("arena_alloc/arena_dimz + release", bump, (double)count, "node");
+    printf("speedup: %.2fx\n", heap / bump);
+
+    checked_free(src);
+
+    return EXIT_SUCCESS;
+}
+
+/* =------------------------------------------------------------= */
@@ -0,0 +1,98 @@
+#pragma once
+
+/* bench.h - Copyright (c) 2024 Frithurik Grint */
+
+#ifndef CALC_TESTS_BENCH_H_
+#define CALC_TESTS_BENCH_H_
+
+#include "calc/base/stdmem.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#   include <windows.h>
+#else
+#   include <time.h>
+#endif // _WIN32
+
+/* =---- Benchmark Helpers -------------------------------------= */
+
+/// @brief Gets a monotonic timestamp.
+/// @return Seconds elapsed from an unspecified point.
+static inline double bench_now(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+
+    return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif // _WIN32
+}
+
+/// @brief Gets the benchmark size from the command line.
+/// @param argc Arguments count.
+/// @param argv Arguments vector.
+/// @param defsiz Default size in MiB.
+/// @return The size in bytes.
+static inline size_t bench_size(int argc, char *argv[], size_t defsiz)
+{
+    if (argc > 1 && atol(argv[1]) > 0)
+        defsiz = (size_t)atol(argv[1]);
+
+    return defsiz << 20;
+}
+
+/// @brief Generates a synthetic calc source, built repeating
+///        a function template with different names and numbers.
+/// @param size Minimum size of the source in bytes.
+/// @param length Optional output of the source length.
+/// @return The generated source, NUL terminated.
+static inline char *bench_gensrc(size_t size, size_t *const length)
+{
+    static const char *const template =
+        "//* Computes the value number %lu. *//\n"
+        "let value_%lu(a, b) : int -> int {\n"
+        "    let x = a * %lu + b; // scaled\n"
+        "    /* recursion until it reaches the bound */\n"
+        "    return (x >= 0x%lX) ? value_%lu(a - 1, b) : x + %lu.%lue3;\n"
+        "}\n\n";
+
+    char *src = dim(char, size + 512);
+    size_t len = 0;
+    unsigned long n = 0;
+
+    while (len < size)
+    {
+        len += (size_t)sprintf(src + len, template, n, n, n * 7 + 1, n, n ? n - 1 : 0, n % 100, n % 10);
+        n++;
+    }
+
+    if (length)
+        *length = len;
+
+    return src;
+}
+
+/// @brief Prints a benchmark result line.
+/// @param name Name of the measured case.
+/// @param seconds Elapsed time.
+/// @param count Number of processed items.
+/// @param unit Name of the processed items.
+static inline void bench_report(const char *const name, double seconds, double count, const char *const unit)
+{
+    printf("%-32s %10.3f ms %14.1f %s/s %10.2f ns/%s\n", name, seconds * 1e3,
+           count / seconds, unit, seconds * 1e9 / count, unit);
+}
+
+/* =------------------------------------------------------------= */
+
+#endif // CALC_TESTS_BENCH_H_
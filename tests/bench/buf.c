@@ -0,0 +1,150 @@
+#include "bench.h"
+
+#include "calc/base/stdbuf.h"
+
+/* =---- Growable Buffer Benchmark -----------------------------= */
+
+/// @brief Number of short buffers built.
+#define SHORT_COUNT 1000000
+
+/// @brief Naive growable buffer: doubling with realloc.
+typedef struct _naive
+{
+    char *data;
+    size_t len;
+    size_t cap;
+} naive_t;
+
+static void naive_append(naive_t *const naive, const void *const data, size_t size)
+{
+    if (naive->len + size > naive->cap)
+    {
+        do
+            naive->cap = naive->cap ? naive->cap * 2 : 16;
+        while (naive->len + size > naive->cap);
+
+        naive->data = (char *)checked_realloc(naive->data, naive->cap);
+    }
+
+    memcpy(naive->data + naive->len, data, size);
+    naive->len += size;
+}
+
+/* keeps the compiler from dropping the measured work */
+static volatile size_t sink;
+
+/* short contents (e.g. diagnostics), 4 to 36 bytes each */
+static void bench_short(void)
+{
+    static const char text[] = "error: unexpected token ')' in expression";
+    size_t i, total = 0;
+    naive_t naive;
+    arena_t arena;
+    buf_t buf;
+    double start;
+
+    start = bench_now();
+
+    for (i = 0; i < SHORT_COUNT; i++)
+    {
+        naive.data = NULL;
+        naive.len = naive.cap = 0;
+
+        naive_append(&naive, text, 4 + i % 16);
+        naive_append(&naive, text, i % 16);
+        total += naive.len;
+
+        checked_free(naive.data);
+    }
+
+    bench_report("short naive", bench_now() - start, SHORT_COUNT, "buf");
+    start = bench_now();
+
+    for (i = 0; i < SHORT_COUNT; i++)
+    {
+        buf_init(&buf);
+
+        buf_append(&buf, text, 4 + i % 16);
+        buf_append(&buf, text, i % 16);
+        total += buf.len;
+
+        buf_release(&buf);
+    }
+
+    bench_report("short buf (heap)", bench_now() - start, SHORT_COUNT, "buf");
+
+    arena_init(&arena, 0);
+    start = bench_now();
+
+    for (i = 0; i < SHORT_COUNT; i++)
+    {
+        buf_init_arena(&buf, &arena);
+
+        buf_append(&buf, text, 4 + i % 16);
+        buf_append(&buf, text, i % 16);
+        buf_append(&buf, text, 40);
+        total += buf.len;
+    }
+
+    bench_report("short buf (arena, spills)", bench_now() - start, SHORT_COUNT, "buf");
+    arena_release(&arena);
+
+    sink += total;
+}
+
+/* one long content built from small pieces (e.g. code emission) */
+static void bench_long(size_t size)
+{
+    static const char piece[] = "    mov rax, [rbp - 8]\n";
+    size_t n = size / (sizeof(piece) - 1), i;
+    naive_t naive = {NULL, 0, 0};
+    arena_t arena;
+    buf_t buf;
+    double start;
+
+    start = bench_now();
+
+    for (i = 0; i < n; i++)
+        naive_append(&naive, piece, sizeof(piece) - 1);
+
+    bench_report("long naive", bench_now() - start, (double)naive.len, "B");
+    checked_free(naive.data);
+
+    buf_init(&buf);
+    start = bench_now();
+
+    for (i = 0; i < n; i++)
+        buf_append(&buf, piece, sizeof(piece) - 1);
+
+    bench_report("long buf (heap)", bench_now() - start, (double)buf.len, "B");
+    buf_release(&buf);
+
+    arena_init(&arena, 0);
+    buf_init_arena(&buf, &arena);
+    start = bench_now();
+
+    for (i = 0; i < n; i++)
+        buf_append(&buf, piece, sizeof(piece) - 1);
+
+    bench_report("long buf (arena)", bench_now() - start, (double)buf.len, "B");
+    arena_release(&arena);
+
+    buf_init(&buf);
+    start = bench_now();
+
+    for (i = 0; i < n / 4; i++)
+        buf_printf(&buf, "    mov r%lu, %lu\n", (unsigned long)(i % 16), (unsigned long)i);
+
+    bench_report("long buf_printf", bench_now() - start, (double)(n / 4), "line");
+    buf_release(&buf);
+}
+
+int main(int argc, char *argv[])
+{
+    bench_short();
+    bench_long(bench_size(argc, argv, 64));
+
+    return EXIT_SUCCESS;
+}
+
+/* =------------------------------------------------------------= */
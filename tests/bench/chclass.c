@@ -0,0 +1,179 @@
+#include "bench.h"
+
+#include "calc/base/stdch.h"
+
+#include <ctype.h>
+
+/* =---- Character Classes Benchmark ---------------------------= */
+
+/// @brief Default size of the sources in MiB.
+#define SIZE 64
+
+/// @brief Number of passes over each source.
+#define PASSES 4
+
+/* a source with non-ASCII identifiers and comments, about one
+   byte in four is part of a UTF-8 sequence */
+static char *gensrc_utf8(size_t size, size_t *const length)
+{
+    static const char *const template =
+        "//* Calcola il valore numero %lu. *//\n"
+        "let valor\xc3\xa9_%lu(\xce\xb1, \xce\xb2) : int -> int {\n"
+        "    let \xc3\xa7\xc3\xa0 = \xce\xb1 * %lu + \xce\xb2; // \xe7\xbc\xa9\xe6\x94\xbe \xc3\x97 \xcf\x80\n"
+        "    /* \xe9\x80\x92\xe5\xbd\x92\xe7\x9b\xb4\xe5\x88\xb0\xe8\xbe\xbe\xe5\x88\xb0\xe8\xbe\xb9\xe7\x95\x8c */\n"
+        "    return (\xc3\xa7\xc3\xa0 >= 0x%lX) ? valor\xc3\xa9_%lu(\xce\xb1 - 1, \xce\xb2) : \xc3\xa7\xc3\xa0 + %lu;\n"
+        "}\n\n";
+
+    char *src = dim(char, size + 512);
+    size_t len = 0;
+    unsigned long n = 0;
+
+    while (len < size)
+    {
+        len += (size_t)sprintf(src + len, template, n, n, n * 7 + 1, n, n ? n - 1 : 0, n % 100);
+        n++;
+    }
+
+    *length = len;
+
+    return src;
+}
+
+/* splits the text in words, numbers, blanks and single chars with
+   the locale dependent <ctype.h> (ASCII only) */
+static size_t words_ctype(const char *const text, size_t len)
+{
+    size_t i = 0, words = 0;
+
+    while (i < len)
+    {
+        int ch = (unsigned char)text[i];
+
+        if (isalpha(ch) || ch == '_' || ch == '$')
+            for (i++; i < len && (isalnum((unsigned char)text[i]) || text[i] == '_' || text[i] == '$'); i++)
+                continue;
+        else if (isdigit(ch))
+            for (i++; i < len && isxdigit((unsigned char)text[i]); i++)
+                continue;
+        else if (isspace(ch))
+            for (i++; i < len && isspace((unsigned char)text[i]); i++)
+                continue;
+        else
+            i++;
+
+        words++;
+    }
+
+    return words;
+}
+
+/* the same split with the class table, the non-ASCII identifiers
+   take the slow path */
+static size_t words_table(const char *const text, size_t len)
+{
+    size_t i = 0, words = 0, n;
+
+    while (i < len)
+    {
+        uint16_t cls = chclass(text[i]);
+
+        if (cls & (CH_IDSTART | CH_UTF8))
+            i += (n = ch_identlen(text + i, len - i)) ? n : 1;
+        else if (cls & CH_DIGIT)
+            for (i++; i < len && chis(text[i], CH_XDIGIT); i++)
+                continue;
+        else if (cls & CH_SPACE)
+            for (i++; i < len && chis(text[i], CH_SPACE); i++)
+                continue;
+        else
+            i++;
+
+        words++;
+    }
+
+    return words;
+}
+
+/* byte at a time validation, as a decoder loop would do it */
+static size_t check_bytewise(const char *const text, size_t len)
+{
+    size_t i = 0, n;
+    uint32_t cp;
+
+    while (i < len)
+    {
+        if (!(n = utf8_decode(text + i, len - i, &cp)))
+            return i;
+
+        i += n;
+    }
+
+    return len;
+}
+
+static void bench(const char *const name, const char *const text, size_t len, bool_t ascii)
+{
+    char label[64];
+    size_t words[2] = {0, 0}, valid[2] = {0, 0};
+    double start;
+    int pass;
+
+    if (ascii)
+    {
+        start = bench_now();
+
+        for (pass = 0; pass < PASSES; pass++)
+            words[0] += words_ctype(text, len);
+
+        sprintf(label, "%s: ctype split", name);
+        bench_report(label, bench_now() - start, (double)len * PASSES, "byte");
+    }
+
+    start = bench_now();
+
+    for (pass = 0; pass < PASSES; pass++)
+        words[1] += words_table(text, len);
+
+    sprintf(label, "%s: table split", name);
+    bench_report(label, bench_now() - start, (double)len * PASSES, "byte");
+
+    start = bench_now();
+
+    for (pass = 0; pass < PASSES; pass++)
+        valid[0] += check_bytewise(text, len);
+
+    sprintf(label, "%s: bytewise UTF-8", name);
+    bench_report(label, bench_now() - start, (double)len * PASSES, "byte");
+
+    start = bench_now();
+
+    for (pass = 0; pass < PASSES; pass++)
+        valid[1] += utf8_check(text, len);
+
+    sprintf(label, "%s: utf8_check", name);
+    bench_report(label, bench_now() - start, (double)len * PASSES, "byte");
+
+    printf("%s: %lu words, %s, %s\n", name, (unsigned long)(words[1] / PASSES),
+           (!ascii || words[0] == words[1]) ? "same split" : "DIFFERENT SPLIT",
+           (valid[0] == valid[1] && valid[1] == len * PASSES) ? "valid" : "INVALID");
+}
+
+int main(int argc, char *argv[])
+{
+    size_t size = bench_size(argc, argv, SIZE), len;
+    char *text;
+
+    printf("UTF-8 validation: %s\n", utf8_isa());
+
+    text = bench_gensrc(size, &len);
+    bench("ascii", text, len, TRUE);
+    checked_free(text);
+
+    text = gensrc_utf8(size, &len);
+    bench("mixed", text, len, FALSE);
+    checked_free(text);
+
+    return EXIT_SUCCESS;
+}
+
+/* =------------------------------------------------------------= */
@@ -0,0 +1,94 @@
+#include "bench.h"
+
+#include "calc/base/stdthrd.h"
+
+/* =---- Thread Heaps Scaling Benchmark ------------------------= */
+
+/// @brief Objects allocated by each thread.
+#define OPS 0x200000
+/// @brief Objects alive at the same time in each thread.
+#define BATCH 1024
+
+/// @brief Sizes of the AST nodes.
+static const size_t sizes[] = { 24, 32, 40, 48, 64, 96 };
+
+#define SIZE(i) sizes[(i) % (sizeof(sizes) / sizeof(sizes[0]))]
+
+static void *run_malloc(void *arg)
+{
+    void *objs[BATCH];
+    size_t i, j;
+
+    for (i = 0; i < OPS; i += BATCH)
+    {
+        for (j = 0; j < BATCH; j++)
+            objs[j] = checked_malloc(SIZE(j)), *(size_t *)objs[j] = j;
+
+        for (j = 0; j < BATCH; j++)
+            checked_free(objs[j]);
+    }
+
+    return arg;
+}
+
+static void *run_heap(void *arg)
+{
+    heap_t *heap = heap_current();
+    void *objs[BATCH];
+    size_t i, j;
+
+    for (i = 0; i < OPS; i += BATCH)
+    {
+        for (j = 0; j < BATCH; j++)
+            objs[j] = heap_malloc(heap, SIZE(j)), *(size_t *)objs[j] = j;
+
+        for (j = 0; j < BATCH; j++)
+            heap_free(heap, objs[j], SIZE(j));
+    }
+
+    heap_release();
+
+    return arg;
+}
+
+static double run(thread_func_t func, unsigned int count)
+{
+    thread_t *threads = dim(thread_t, count);
+    double start = bench_now();
+    unsigned int i;
+
+    for (i = 0; i < count; i++)
+        if (!thread_start(&threads[i], func, NULL))
+            fail("cannot start thread %u", i);
+
+    for (i = 0; i < count; i++)
+        thread_join(&threads[i]);
+
+    start = bench_now() - start;
+    checked_free(threads);
+
+    return start;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int max = (argc > 1 && atoi(argv[1]) > 0) ? (unsigned int)atoi(argv[1]) : 2 * thread_cpus();
+    unsigned int count;
+    double t1, t2, ops;
+
+    printf("cpus: %u, %u objects per thread\n", thread_cpus(), OPS);
+    printf("%8s %18s %18s %8s\n", "threads", "checked_malloc", "heap_malloc", "speedup");
+
+    for (count = 1; count <= max; count++)
+    {
+        ops = (double)OPS * 2 * count;
+        t1 = run(&run_malloc, count);
+        t2 = run(&run_heap, count);
+
+        printf("%8u %13.1f Mop/s %13.1f Mop/s %7.2fx\n", count, ops / t1 * 1e-6, ops / t2 * 1e-6, t1 / t2);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/* =------------------------------------------------------------= */
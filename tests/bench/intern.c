@@ -0,0 +1,66 @@
+#include "bench.h"
+
+#include "calc/base/stdstr.h"
+
+/* =---- String Interning Benchmark ----------------------------= */
+
+/// @brief Number of distinct identifiers.
+#define UNIQUE 100000
+
+static const char *const stems[] =
+{
+    "value", "count", "index", "node", "left", "right", "pivot", "area",
+    "circle", "partition", "quicksort", "std::lib.math", "std::lib.io", "tmp"
+};
+
+int main(int argc, char *argv[])
+{
+    size_t total = (argc > 1 && atol(argv[1]) > 0) ? (size_t)atol(argv[1]) * 1000000 : 4000000;
+    size_t i, found = 0;
+    char *corpus, *p, **words;
+    unsigned long seed = 12345;
+    strtab_t tab;
+    double start;
+
+    corpus = dim(char, UNIQUE * 32);
+    words = dim(char *, UNIQUE);
+
+    for (i = 0, p = corpus; i < UNIQUE; i++)
+    {
+        words[i] = p;
+        p += sprintf(p, "%s_%lu", stems[i % (sizeof(stems) / sizeof(stems[0]))], (unsigned long)i) + 1;
+    }
+
+    printf("corpus: %lu identifiers, %d distinct\n", (unsigned long)total, UNIQUE);
+
+    strtab_init(&tab, 0);
+    start = bench_now();
+
+    /* half of the occurrences hit a small set of hot identifiers,
+       as it happens in real sources */
+    for (i = 0; i < total; i++)
+    {
+        seed = seed * 1103515245UL + 12345UL;
+        p = words[(seed >> 8) % ((seed & 0x10) ? UNIQUE : 1024)];
+
+        strtab_intern(&tab, p, strlen(p));
+    }
+
+    bench_report("strtab_intern", bench_now() - start, (double)total, "str");
+
+    start = bench_now();
+
+    for (i = 0; i < total; i++)
+        found += (strtab_find(&tab, words[i % UNIQUE], strlen(words[i % UNIQUE])) != NULL);
+
+    bench_report("strtab_find", bench_now() - start, (double)total, "str");
+    printf("interned: %lu, found: %lu\n", (unsigned long)tab.count, (unsigned long)found);
+
+    strtab_release(&tab);
+    checked_free(words);
+    checked_free(corpus);
+
+    return EXIT_SUCCESS;
+}
+
+/* =------------------------------------------------------------= */
@@ -0,0 +1,92 @@
+#include "bench.h"
+
+#include "calc/lex/tokens.h"
+
+/* =---- Keyword Recognition Benchmark -------------------------= */
+
+/// @brief Default number of identifiers classified.
+#define WORDS 10000000
+
+/// @brief Keywords in declaration order, for the linear scan.
+static const strv_t keywords[] =
+{
+#define KEYWORD(name, text) { text, sizeof(text) - 1 },
+#include "calc/lex/tokens.inc"
+};
+
+/// @brief Identifiers of the input which are not keywords, some
+///        sharing a prefix or the length of a keyword.
+static const char *const idents[] =
+{
+    "x", "i", "n", "len", "list", "pivot", "left", "right", "sum", "count",
+    "value", "result", "index", "radius", "area", "circle", "quicksort",
+    "partition", "iffy", "elsewhere", "format", "do_it", "integer", "types",
+    "lets", "user", "matches", "constant", "realm", "charset", "struct_t"
+};
+
+#define countof(array) (sizeof(array) / sizeof(*(array)))
+
+/* the usual alternative: compares the keywords one by one */
+static tok_kind_t scan_keyword(const char *const str, size_t len)
+{
+    size_t i;
+
+    for (i = 0; i < countof(keywords); i++)
+        if (keywords[i].len == len && strneq(keywords[i].ptr, str, len))
+            return (tok_kind_t)(TOK_IDENT + 1 + i);
+
+    return TOK_IDENT;
+}
+
+/* keeps the compiler from dropping the measured calls */
+static volatile size_t sink;
+
+int main(int argc, char *argv[])
+{
+    size_t n = (argc > 1 && atol(argv[1]) > 0) ? (size_t)atol(argv[1]) : WORDS, i, k, kws = 0, sum;
+    const char **words = dim(const char *, n);
+    size_t *lens = dim(size_t, n);
+    unsigned int seed = 1;
+    double start;
+
+    /* about a third of the identifiers of a source are keywords */
+    for (i = 0; i < n; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        k = seed >> 8;
+
+        words[i] = (k % 3) ? idents[k % countof(idents)] : keywords[k % countof(keywords)].ptr;
+        lens[i] = strlen(words[i]);
+    }
+
+    for (i = 0; i < n; i++)
+        if (scan_keyword(words[i], lens[i]) != tok_keyword(words[i], lens[i]))
+            return EXIT_FAILURE;
+
+    start = bench_now();
+
+    for (i = 0, sum = 0; i < n; i++)
+        sum += scan_keyword(words[i], lens[i]);
+
+    bench_report("linear strneq", bench_now() - start, (double)n, "word");
+    sink = sum;
+    start = bench_now();
+
+    for (i = 0, sum = 0; i < n; i++)
+        sum += tok_keyword(words[i], lens[i]);
+
+    bench_report("perfect hash", bench_now() - start, (double)n, "word");
+    sink = sum;
+
+    for (i = 0; i < n; i++)
+        kws += tok_keyword(words[i], lens[i]) != TOK_IDENT;
+
+    printf("keywords: %lu of %lu words\n", (unsigned long)kws, (unsigned long)n);
+
+    checked_free(lens);
+    checked_free(words);
+
+    return EXIT_SUCCESS;
+}
+
+/* =------------------------------------------------------------= */
@@ -0,0 +1,112 @@
+#include "bench.h"
+
+#include "calc/base/stdstr.h"
+
+/* =---- Lexeme Extraction Benchmark ---------------------------= */
+
+/// @brief Lexeme pulled out of the source.
+typedef struct _lexeme
+{
+    /// @brief Copy of the text (copying strategy).
+    char *copy;
+    /// @brief View of the text (view strategy).
+    strv_t view;
+    /// @brief Value of the literal.
+    int64_t value;
+} lexeme_t;
+
+#define isident(c) (((c) >= 'a' && (c) <= 'z') || ((c) >= 'A' && (c) <= 'Z') || (c) == '_' || ((c) >= '0' && (c) <= '9'))
+
+/// @brief Splits the identifiers and the integer literals of a
+///        source, copying or viewing them.
+/// @return The number of lexemes.
+static size_t extract(const char *src, lexeme_t *const lexemes, bool_t copy)
+{
+    const char *start;
+    size_t n = 0;
+
+    while (*src)
+    {
+        if (!isident(*src))
+        {
+            src++;
+            continue;
+        }
+
+        for (start = src; isident(*src); src++)
+            continue;
+
+        if (copy)
+        {
+            lexemes[n].copy = strnget(NULL, start, (size_t)(src - start));
+            lexemes[n].value = (*start >= '0' && *start <= '9') ? strtoll(lexemes[n].copy, NULL, 0) : 0;
+        }
+        else
+        {
+            lexemes[n].view = strv(start, (size_t)(src - start));
+
+            if (*start >= '0' && *start <= '9' && !strv_toi(lexemes[n].view, &lexemes[n].value))
+                lexemes[n].value = 0;
+        }
+
+        n++;
+    }
+
+    return n;
+}
+
+/// @brief Gets the number of allocations done so far, or zero
+///        when the statistics are not available.
+static size_t allocs(void)
+{
+    const memstats_t *stats = memstats_get(MEMTAG_BASE);
+
+    return stats ? stats->allocs : 0;
+}
+
+/// @brief Prints the allocations per MiB of a strategy, measured
+///        when the statistics are built in (CALC_MEM_STATS),
+///        otherwise counted by the benchmark.
+static void report_allocs(const char *const name, size_t count, size_t before, double mib)
+{
+    if (memstats_get(MEMTAG_BASE))
+        printf("%-32s %10.1f allocs/MiB (measured)\n", name, (double)(allocs() - before) / mib);
+    else
+        printf("%-32s %10.1f allocs/MiB\n", name, (double)count / mib);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t size = bench_size(argc, argv, 16), len, n, i, before;
+    char *src = bench_gensrc(size, &len);
+    lexeme_t *lexemes = dim(lexeme_t, len / 2 + 1);
+    double start, mib = (double)len / (1 << 20);
+
+    printf("source: %.1f MiB\n", mib);
+
+    before = allocs();
+    start = bench_now();
+    n = extract(src, lexemes, TRUE);
+    bench_report("copy (strnget)", bench_now() - start, (double)len, "B");
+
+    /* every copy is an allocation */
+    report_allocs("copy (strnget)", n, before, mib);
+
+    for (i = 0; i < n; i++)
+        checked_free(lexemes[i].copy);
+
+    before = allocs();
+    start = bench_now();
+    n = extract(src, lexemes, FALSE);
+    bench_report("view (strv)", bench_now() - start, (double)len, "B");
+    report_allocs("view (strv)", 0, before, mib);
+
+    printf("lexemes: %lu\n", (unsigned long)n);
+
+    checked_free(lexemes);
+    checked_free(src);
+
+    return EXIT_SUCCESS;
+}
+
+/* =------------------------------------------------------------= */
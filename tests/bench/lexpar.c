@@ -0,0 +1,87 @@
+#include "bench.h"
+
+#include "calc/lex/lexer.h"
+#include "calc/base/stdthrd.h"
+
+/* =---- Parallel Lexer Benchmark ------------------------------= */
+
+/// @brief Default size of the source in MiB.
+#define SIZE 1024
+
+/// @brief Most threads of the benchmark.
+#define THREADS 16
+
+/// @brief Width of the bar of the highest speedup.
+#define WIDTH 40
+
+/* a hash of the tokens of a stream, to compare the streams without
+   keeping them */
+static size_t hash(const tokstream_t *const tokens)
+{
+    size_t h = tokens->count, i;
+
+    for (i = 0; i < tokens->count; i++)
+        h = h * 31 + (tokens->kinds[i] ^ tokens->offsets[i] ^ ((size_t)tokens->lens[i] << 16));
+
+    return h;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t size = bench_size(argc, argv, SIZE), len, count, expected, i;
+    char *text = bench_gensrc(size, &len);
+    double secs[THREADS + 1], start;
+    unsigned int threads;
+    tokstream_t tokens;
+    char label[64];
+    bool_t same = TRUE;
+
+    /* a first scan, the memory of the streams is then mapped */
+    tokstream_init(&tokens);
+    lex_text(text, len, &tokens);
+    tokstream_release(&tokens);
+
+    tokstream_init(&tokens);
+    start = bench_now();
+    count = lex_text(text, len, &tokens);
+    secs[0] = bench_now() - start;
+
+    bench_report("lex_text", secs[0], (double)len, "byte");
+
+    expected = hash(&tokens);
+    tokstream_release(&tokens);
+
+    for (threads = 1; threads <= THREADS; threads *= 2)
+    {
+        tokstream_init(&tokens);
+        start = bench_now();
+        same &= lex_text_parallel(text, len, &tokens, threads) == count;
+        secs[threads] = bench_now() - start;
+
+        sprintf(label, "lex_text_parallel: %u threads", threads);
+        bench_report(label, secs[threads], (double)len, "byte");
+
+        same &= hash(&tokens) == expected;
+        tokstream_release(&tokens);
+    }
+
+    printf("size: %lu MiB, tokens: %lu, processors: %u, %s\n", (unsigned long)(len >> 20), (unsigned long)count,
+           thread_cpus(), same ? "same tokens" : "DIFFERENT TOKENS");
+
+    /* the speedup over lex_text, a bar of WIDTH chars is 16x */
+    for (threads = 1; threads <= THREADS; threads *= 2)
+    {
+        printf("%2u threads %6.2fx |", threads, secs[0] / secs[threads]);
+
+        for (i = 0; i < (size_t)(secs[0] / secs[threads] * WIDTH / THREADS + 0.5) && i < 2 * WIDTH; i++)
+            putchar('#');
+
+        putchar('\n');
+    }
+
+    checked_free(text);
+
+    return EXIT_SUCCESS;
+}
+
+/* =------------------------------------------------------------= */
@@ -0,0 +1,222 @@
+#include "bench.h"
+
+#include "calc/lex/lexer.h"
+#include "calc/lex/literal.h"
+
+#include <string.h>
+
+/* =---- Literal Decoding Benchmark ----------------------------= */
+
+/// @brief Default size of the source in MiB.
+#define SIZE 16
+
+/// @brief Number of decodings of each literal.
+#define PASSES 5
+
+/// @brief Literals on each line of the source.
+#define ROW 8
+
+/// @brief Kinds of numeric literals.
+#define KINDS 5
+
+static const tok_kind_t kinds[KINDS] = {TOK_LIT_BIN, TOK_LIT_OCT, TOK_LIT_DEC, TOK_LIT_HEX, TOK_LIT_REAL};
+
+static const char *const names[KINDS] = {"binary", "octal", "decimal", "hexadecimal", "real"};
+
+static uint64_t state = UINT64_C(0x9E3779B97F4A7C15);
+
+static uint64_t next(void)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return state;
+}
+
+/* a literal of a kind, below 2^63 as strtoll takes it */
+static int literal(char *const buf, size_t kind)
+{
+    uint64_t bits = next() >> (1 + next() % 63);
+    int n = 0, i;
+    double real;
+
+    switch (kinds[kind])
+    {
+    case TOK_LIT_BIN:
+        n = sprintf(buf, "0b");
+
+        for (i = 63; i > 0 && !(bits >> i); i--)
+            continue;
+
+        for (; i >= 0; i--)
+            buf[n++] = (char)('0' + ((bits >> i) & 1));
+
+        return n;
+    case TOK_LIT_OCT:
+        return sprintf(buf, "0c%llo", (unsigned long long)bits);
+    case TOK_LIT_DEC:
+        return sprintf(buf, next() & 1 ? "%llu" : "0d%llu", (unsigned long long)bits);
+    case TOK_LIT_HEX:
+        return sprintf(buf, next() & 1 ? "0x%llX" : "0x%llx", (unsigned long long)bits);
+    default:
+        bits = next() & UINT64_C(0x7FFFFFFFFFFFFFFF);
+        memcpy(&real, &bits, sizeof(real));
+
+        /* short ones as written by hand, long ones as printed */
+        if (next() & 1 || real != real || real > 1e300)
+            return sprintf(buf, "%lu.%lu", (unsigned long)(next() % 10000), (unsigned long)(next() % 1000));
+
+        return sprintf(buf, "%.*e", 1 + (int)(next() % 17), real);
+    }
+}
+
+/* lines of literals of all the kinds */
+static char *gensrc(size_t size, size_t *const length)
+{
+    char *text = (char *)checked_malloc(size + 1024);
+    size_t len = 0, row = 0;
+    int i;
+
+    while (len < size)
+    {
+        len += (size_t)sprintf(text + len, "let t%lu = [", (unsigned long)row++);
+
+        for (i = 0; i < ROW; i++)
+        {
+            len += (size_t)literal(text + len, next() % KINDS);
+            len += (size_t)sprintf(text + len, i + 1 < ROW ? ", " : "];\n");
+        }
+    }
+
+    text[len] = '\0';
+    *length = len;
+
+    return text;
+}
+
+/* decodes with the C library, in place: a literal is followed by a
+   char that ends it */
+static void libc(const char *const str, tok_kind_t kind, litval_t *const value)
+{
+    const char *p = str;
+
+    value->kind = kind;
+
+    if (kind == TOK_LIT_REAL)
+    {
+        value->as.r = strtod(str, NULL);
+
+        return;
+    }
+
+    if (kind != TOK_LIT_DEC || *p == '0')
+    {
+        while (*p == '0')
+            p++;
+
+        if (*p > '9')
+            p++;
+    }
+
+    switch (kind)
+    {
+    case TOK_LIT_BIN:
+        value->as.u = (uint64_t)strtoll(p, NULL, 2);
+        break;
+    case TOK_LIT_OCT:
+        value->as.u = (uint64_t)strtoll(p, NULL, 8);
+        break;
+    case TOK_LIT_HEX:
+        value->as.u = (uint64_t)strtoll(p, NULL, 16);
+        break;
+    default:
+        value->as.u = (uint64_t)strtoll(p, NULL, 10);
+        break;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t size = bench_size(argc, argv, SIZE), len, count[KINDS] = {0}, n = 0, i, k;
+    char *text = gensrc(size, &len), label[64];
+    double secs[2][KINDS + 1] = {{0}}, start;
+    uint64_t sums[2] = {0, 0};
+    bool_t same = TRUE;
+    tokstream_t tokens;
+    litval_t a, b;
+    size_t *lits;
+    int pass;
+
+    tokstream_init(&tokens);
+    lex_text(text, len, &tokens);
+
+    /* the literals by kind, each kind is timed apart */
+    lits = (size_t *)checked_malloc(tokens.count * sizeof(size_t));
+
+    for (k = 0; k < KINDS; k++)
+        for (i = 0; i < tokens.count; i++)
+            if (tokstream_kind(&tokens, i) == kinds[k])
+                lits[n++] = i, count[k]++;
+
+    for (pass = 0; pass < PASSES; pass++)
+    {
+        for (i = 0, k = 0; k < KINDS; k++)
+        {
+            size_t end = i + count[k], j;
+
+            start = bench_now();
+
+            for (j = i; j < end; j++)
+            {
+                lit_decode(&tokens, text, lits[j], &a);
+                sums[0] += a.as.u;
+            }
+
+            secs[0][k] += bench_now() - start;
+            start = bench_now();
+
+            for (j = i; j < end; j++)
+            {
+                libc(text + tokstream_offset(&tokens, lits[j]), kinds[k], &b);
+                sums[1] += b.as.u;
+            }
+
+            secs[1][k] += bench_now() - start;
+            i = end;
+        }
+    }
+
+    for (k = 0; k < KINDS; k++)
+    {
+        secs[0][KINDS] += secs[0][k];
+        secs[1][KINDS] += secs[1][k];
+
+        sprintf(label, "lit_decode: %s", names[k]);
+        bench_report(label, secs[0][k], (double)count[k] * PASSES, "literal");
+        sprintf(label, "%s: %s", kinds[k] != TOK_LIT_REAL ? "strtoll" : "strtod", names[k]);
+        bench_report(label, secs[1][k], (double)count[k] * PASSES, "literal");
+    }
+
+    bench_report("lit_decode: all", secs[0][KINDS], (double)n * PASSES, "literal");
+    bench_report("strtoll/strtod: all", secs[1][KINDS], (double)n * PASSES, "literal");
+
+    /* the bits of the values are compared */
+    for (i = 0; i < n; i++)
+    {
+        lit_decode(&tokens, text, lits[i], &a);
+        libc(text + tokstream_offset(&tokens, lits[i]), a.kind, &b);
+        same &= a.as.u == b.as.u;
+    }
+
+    printf("size: %lu MiB, literals: %lu, speedup: %.2fx, %s\n", (unsigned long)(len >> 20), (unsigned long)n,
+           secs[1][KINDS] / secs[0][KINDS], same && sums[0] == sums[1] ? "same values" : "DIFFERENT VALUES");
+
+    checked_free(lits);
+    tokstream_release(&tokens);
+    checked_free(text);
+
+    return EXIT_SUCCESS;
+}
+
+/* =------------------------------------------------------------= */
@@ -0,0 +1,136 @@
+#include "bench.h"
+
+#include "calc/base/stdbuf.h"
+#include "calc/base/stdstr.h"
+#include "calc/base/stdthrd.h"
+
+/* =---- Pipelining Benchmark ----------------------------------= */
+
+/* the lexer and the parser are stood in by a splitter of words
+   and numbers and by a stage interning and evaluating them */
+
+/// @brief Tokens moved by each push or pop.
+#define BATCH 256
+
+/// @brief Token produced by the first stage.
+typedef struct _token
+{
+    /// @brief Offset in the source.
+    uint32_t off;
+    /// @brief Length of the text.
+    uint32_t len;
+} token_t;
+
+/// @brief State shared by the stages.
+typedef struct _stage
+{
+    const char *src;
+    size_t len;
+    ring_t ring;
+    strtab_t tab;
+    int64_t sum;
+} stage_t;
+
+#define isword(c) (((c) >= 'a' && (c) <= 'z') || ((c) >= 'A' && (c) <= 'Z') || (c) == '_' || ((c) >= '0' && (c) <= '9'))
+
+/* splits the next batch of tokens, returns their number */
+static size_t scan(const char *const src, size_t *const pos, size_t len, token_t *const tokens)
+{
+    size_t i = *pos, n = 0, start;
+
+    while (n < BATCH && i < len)
+    {
+        if (!isword(src[i]))
+        {
+            i++;
+            continue;
+        }
+
+        for (start = i; i < len && isword(src[i]); i++)
+            continue;
+
+        tokens[n].off = (uint32_t)start;
+        tokens[n++].len = (uint32_t)(i - start);
+    }
+
+    *pos = i;
+
+    return n;
+}
+
+static void consume(stage_t *const stage, const token_t *const tokens, size_t count)
+{
+    int64_t value;
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        strv_t text = strv(stage->src + tokens[i].off, tokens[i].len);
+
+        if (text.ptr[0] >= '0' && text.ptr[0] <= '9')
+            stage->sum += strv_toi(text, &value) ? value : 0;
+        else
+            strtab_vintern(&stage->tab, text);
+    }
+}
+
+static void *producer(void *arg)
+{
+    stage_t *stage = (stage_t *)arg;
+    token_t tokens[BATCH];
+    size_t pos = 0, n;
+
+    while ((n = scan(stage->src, &pos, stage->len, tokens)) != 0)
+        ring_push_all(&stage->ring, tokens, n);
+
+    ring_close(&stage->ring);
+
+    return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t size = bench_size(argc, argv, 100), pos = 0, n;
+    token_t tokens[BATCH];
+    thread_t thread;
+    stage_t stage;
+    double start;
+
+    stage.src = bench_gensrc(size, &stage.len);
+    printf("source: %.1f MiB, %u cpus\n", (double)stage.len / (1 << 20), thread_cpus());
+
+    strtab_init(&stage.tab, 0);
+    stage.sum = 0;
+    start = bench_now();
+
+    while ((n = scan(stage.src, &pos, stage.len, tokens)) != 0)
+        consume(&stage, tokens, n);
+
+    bench_report("single thread", bench_now() - start, (double)stage.len, "B");
+    printf("interned: %lu, sum: %ld\n", (unsigned long)stage.tab.count, (long)stage.sum);
+    strtab_release(&stage.tab);
+
+    strtab_init(&stage.tab, 0);
+    stage.sum = 0;
+    ring_init(&stage.ring, sizeof(token_t), BATCH * 64);
+    start = bench_now();
+
+    if (!thread_start(&thread, producer, &stage))
+        fail("cannot start the producer thread");
+
+    while ((n = ring_pop_wait(&stage.ring, tokens, BATCH)) != 0)
+        consume(&stage, tokens, n);
+
+    thread_join(&thread);
+
+    bench_report("pipelined (spsc ring)", bench_now() - start, (double)stage.len, "B");
+    printf("interned: %lu, sum: %ld\n", (unsigned long)stage.tab.count, (long)stage.sum);
+
+    ring_release(&stage.ring);
+    strtab_release(&stage.tab);
+    checked_free((void *)stage.src);
+
+    return EXIT_SUCCESS;
+}
+
+/* =------------------------------------------------------------= */
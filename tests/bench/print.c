@@ -0,0 +1,104 @@
+#include "bench.h"
+
+#include <fcntl.h>
+
+/* =---- Output Benchmark --------------------------------------= */
+
+/// @brief Default number of lines printed by each case.
+#define LINES 4000000
+
+/* each case writes the standard output redirected to the null
+   device, the old cases expand the printing macros as they were
+   before the writers */
+
+static void old_println(const char *const message)
+{
+    puts(message);
+}
+
+static int old_printfn(const char *const format, ...)
+{
+    va_list arglist;
+    int r;
+
+    va_start(arglist, format);
+    r = vprintf(format, arglist) + puts("");
+    va_end(arglist);
+
+    return r;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t lines = (argc > 1 && atol(argv[1]) > 0) ? (size_t)atol(argv[1]) : LINES, i;
+    double elapsed[5], start;
+    int saved, null;
+
+    fflush(stdout);
+    saved = dup(STDOUT_FILENO);
+
+#ifdef _WIN32
+    null = open("NUL", O_WRONLY);
+#else
+    null = open("/dev/null", O_WRONLY);
+#endif // _WIN32
+
+    if (saved < 0 || null < 0 || dup2(null, STDOUT_FILENO) < 0)
+        fail("cannot redirect the standard output");
+
+    start = bench_now();
+
+    for (i = 0; i < lines; i++)
+        old_println("result: 42");
+
+    fflush(stdout);
+    elapsed[0] = bench_now() - start;
+    start = bench_now();
+
+    for (i = 0; i < lines; i++)
+        println("result: 42");
+
+    writer_flush(wstdout);
+    elapsed[1] = bench_now() - start;
+    start = bench_now();
+
+    for (i = 0; i < lines; i++)
+        old_printfn("result %lu: %ld", (unsigned long)i, (long)(i * 7) - 1000);
+
+    fflush(stdout);
+    elapsed[2] = bench_now() - start;
+    start = bench_now();
+
+    for (i = 0; i < lines; i++)
+        printfn("result %lu: %ld", (unsigned long)i, (long)(i * 7) - 1000);
+
+    writer_flush(wstdout);
+    elapsed[3] = bench_now() - start;
+    start = bench_now();
+
+    for (i = 0; i < lines; i++)
+    {
+        writer_write(wstdout, "result ", 7);
+        writer_putu(wstdout, i);
+        writer_write(wstdout, ": ", 2);
+        writer_puti(wstdout, (int64_t)(i * 7) - 1000);
+        writer_putc(wstdout, '\n');
+    }
+
+    writer_flush(wstdout);
+    elapsed[4] = bench_now() - start;
+
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+    close(null);
+
+    bench_report("println (stdio)", elapsed[0], (double)lines, "line");
+    bench_report("println (writer)", elapsed[1], (double)lines, "line");
+    bench_report("printfn (stdio)", elapsed[2], (double)lines, "line");
+    bench_report("printfn (writer)", elapsed[3], (double)lines, "line");
+    bench_report("writer_putu/puti", elapsed[4], (double)lines, "line");
+
+    return EXIT_SUCCESS;
+}
+
+/* =------------------------------------------------------------= */
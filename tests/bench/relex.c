@@ -0,0 +1,145 @@
+#include "bench.h"
+
+#include "calc/lex/lexer.h"
+
+#include <string.h>
+
+/* =---- Incremental Lexer Benchmark ---------------------------= */
+
+/// @brief Number of lines of the source.
+#define LINES 50000
+
+/// @brief Number of edits of each kind.
+#define EDITS 20000
+
+/// @brief Number of full scans, to compare.
+#define SCANS 20
+
+static char *text;
+static size_t len;
+static tokstream_t tokens;
+static size_t relexed;
+
+/* replaces some chars of the text and updates the tokens, returns the
+   time taken by the tokens */
+static double edit(size_t offset, size_t removed, const char *const insert)
+{
+    size_t inserted = strlen(insert);
+    lexedit_t changed;
+    double start;
+
+    memmove(text + offset + inserted, text + offset + removed, len - offset - removed);
+    memcpy(text + offset, insert, inserted);
+    len = len - removed + inserted;
+
+    start = bench_now();
+    lex_edit(&tokens, text, len, offset, removed, inserted, &changed);
+    relexed += changed.inserted;
+
+    return bench_now() - start;
+}
+
+/* an offset in the middle of an identifier */
+static size_t ident(size_t offset)
+{
+    return (size_t)(strstr(text + offset, "value_") - text) + 3;
+}
+
+static bool_t check()
+{
+    tokstream_t expected;
+    token_t a, b;
+    bool_t same;
+    size_t i;
+
+    tokstream_init(&expected);
+    lex_text(text, len, &expected);
+
+    for (same = expected.count == tokens.count, i = 0; same && i < tokens.count; i++)
+    {
+        tokstream_get(&expected, i, &a);
+        tokstream_get(&tokens, i, &b);
+        same = a.kind == b.kind && a.offset == b.offset && a.len == b.len;
+    }
+
+    tokstream_release(&expected);
+
+    return same;
+}
+
+/* some text inserted and removed at random places, the shift of the
+   offsets is applied between the places. A quote or the start of a
+   comment is closed only by the next one */
+static void scatter(const char *const name, const char *const inserts[], size_t n)
+{
+    size_t offset, i;
+    double secs;
+
+    for (secs = 0, relexed = 0, i = 0; i < EDITS / 2; i++)
+    {
+        offset = (size_t)rand() % len;
+
+        secs += edit(offset, 0, inserts[i % n]);
+        secs += edit(offset, strlen(inserts[i % n]), "");
+    }
+
+    bench_report(name, secs, EDITS, "edit");
+    printf("%s: %.2f tokens scanned again for each edit, %s\n", name, (double)relexed / EDITS,
+           check() ? "same tokens" : "DIFFERENT TOKENS");
+}
+
+int main(int argc, char *argv[])
+{
+    static const char *const chars[] = {" ", "x", ";", "1", "("};
+    static const char *const opens[] = {"\"", "/*"};
+    size_t size = 0, lines = 0, offset, i;
+    double secs, start;
+
+    (void)argc, (void)argv;
+
+    /* about 33 bytes for each line */
+    text = bench_gensrc((size_t)LINES * 40, &len);
+
+    for (size = 0; size < len && lines < LINES; size++)
+        lines += text[size] == '\n';
+
+    len = size;
+    text = (char *)checked_realloc(text, len + EDITS * 2 + 1);
+
+    tokstream_init(&tokens);
+    start = bench_now();
+
+    for (i = 0; i < SCANS; i++)
+    {
+        tokens.count = 0;
+        lex_text(text, len, &tokens);
+    }
+
+    bench_report("whole file", bench_now() - start, SCANS, "scan");
+    printf("lines: %lu, size: %lu KiB, tokens: %lu\n", (unsigned long)lines, (unsigned long)(len >> 10),
+           (unsigned long)tokens.count);
+
+    /* typing in one place of the file and deleting it */
+    srand(1);
+    offset = ident((size_t)rand() % (len / 2));
+
+    for (secs = 0, relexed = 0, i = 0; i < EDITS / 2; i++)
+        secs += edit(offset + i, 0, "x");
+
+    for (i = EDITS / 2; i > 0; i--)
+        secs += edit(offset + i - 1, 1, "");
+
+    bench_report("typing", secs, EDITS, "edit");
+    printf("typing: %.2f tokens scanned again for each edit, %s\n", (double)relexed / EDITS,
+           check() ? "same tokens" : "DIFFERENT TOKENS");
+
+    scatter("random places", chars, sizeof(chars) / sizeof(chars[0]));
+    scatter("random quotes and comments", opens, sizeof(opens) / sizeof(opens[0]));
+
+    tokstream_release(&tokens);
+    checked_free(text);
+
+    return EXIT_SUCCESS;
+}
+
+/* =------------------------------------------------------------= */
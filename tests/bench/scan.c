@@ -0,0 +1,71 @@
+#include "bench.h"
+
+#include "calc/lex/lexer.h"
+
+/* =---- Scanner Benchmark -------------------------------------= */
+
+/// @brief Default size of the source in MiB.
+#define SIZE 256
+
+/// @brief Number of tokens of a batch.
+#define BATCH 4096
+
+/// @brief Throughput the scanner is expected to reach on one core.
+#define TARGET 500e6
+
+int main(int argc, char *argv[])
+{
+    size_t size = bench_size(argc, argv, SIZE), len, count = 0, errors = 0, kinds = 0, batched = 0, lexed, n, i;
+    char *text = bench_gensrc(size, &len);
+    static token_t batch[BATCH];
+    scanner_t scanner;
+    token_t token;
+    tokstream_t tokens;
+    double start, secs;
+
+    start = bench_now();
+    scanner_init(&scanner, text, len);
+
+    while (scanner_next(&scanner, &token) != TOK_EOF)
+    {
+        count++;
+        errors += tok_iserror(token.kind);
+        kinds += token.kind;
+    }
+
+    bench_report("scan one at a time", bench_now() - start, (double)len, "byte");
+
+    start = bench_now();
+    scanner_init(&scanner, text, len);
+
+    while ((n = scanner_scan(&scanner, batch, BATCH)))
+    {
+        for (i = 0; i < n; i++)
+            kinds -= batch[i].kind;
+
+        batched += n;
+    }
+
+    secs = bench_now() - start;
+
+    bench_report("scan in batches", secs, (double)len, "byte");
+    bench_report("scan in batches", secs, (double)batched, "token");
+
+    tokstream_init(&tokens);
+    start = bench_now();
+    lexed = lex_text(text, len, &tokens);
+
+    bench_report("lex into a stream", bench_now() - start, (double)len, "byte");
+
+    printf("size: %lu MiB, tokens: %lu (%.2f bytes each), errors: %lu, %s, %s\n",
+           (unsigned long)(len >> 20), (unsigned long)count, (double)len / (double)count, (unsigned long)errors,
+           (lexed == count + 1 && batched == count && !kinds) ? "same tokens" : "DIFFERENT TOKENS",
+           (double)len / secs >= TARGET ? "over 500 MB/s" : "UNDER 500 MB/s");
+
+    tokstream_release(&tokens);
+    checked_free(text);
+
+    return EXIT_SUCCESS;
+}
+
+/* =------------------------------------------------------------= */
@@ -0,0 +1,185 @@
+#include "bench.h"
+
+#include "calc/base/stdtab.h"
+
+/* =---- Scope Resolution Benchmark ----------------------------= */
+
+/// @brief Default number of functions.
+#define FUNCS 10000
+/// @brief Default nesting depth of the blocks of a function.
+#define DEPTH 32
+/// @brief Parameters of each function.
+#define PARAMS 4
+/// @brief Locals bound by each block, shadowing the outer ones.
+#define LOCALS 4
+/// @brief Names resolved by each block.
+#define REFS 8
+
+/// @brief Synthetic program: FUNCS global functions, each one
+///        with PARAMS parameters and DEPTH nested blocks binding
+///        LOCALS locals and resolving REFS names among the locals,
+///        the parameters and the functions.
+typedef struct _program
+{
+    istr_t *funcs;
+    istr_t params[PARAMS];
+    istr_t locals[LOCALS];
+    size_t nfuncs;
+    size_t depth;
+} program_t;
+
+/* a symbol is its position in this array, only its address counts */
+static char symbols[FUNCS + PARAMS + LOCALS];
+
+#define sym_of(i) ((void *)&symbols[(i) % sizeof(symbols)])
+#define sym_id(sym) ((size_t)((char *)(sym) - symbols))
+
+/* the name resolved by a reference of a block of a function */
+static istr_t ref_name(const program_t *const prog, size_t func, size_t level, size_t ref)
+{
+    size_t r = (func * 31 + level * 7 + ref) % 8;
+
+    if (r < 4)
+        return prog->locals[r % LOCALS];
+
+    if (r < 6)
+        return prog->params[r % PARAMS];
+
+    return prog->funcs[(func * 131 + level * 17 + ref) % prog->nfuncs];
+}
+
+// Undo Log
+
+static size_t resolve_symtab(const program_t *const prog)
+{
+    size_t f, level, i, sum = 0;
+    symtab_t symtab;
+
+    symtab_init(&symtab);
+
+    for (f = 0; f < prog->nfuncs; f++)
+        symtab_bind(&symtab, prog->funcs[f], sym_of(f));
+
+    for (f = 0; f < prog->nfuncs; f++)
+    {
+        symtab_enter(&symtab);
+
+        for (i = 0; i < PARAMS; i++)
+            symtab_bind(&symtab, prog->params[i], sym_of(FUNCS + i));
+
+        for (level = 0; level < prog->depth; level++)
+        {
+            symtab_enter(&symtab);
+
+            for (i = 0; i < LOCALS; i++)
+                symtab_bind(&symtab, prog->locals[i], sym_of(FUNCS + PARAMS + i + level));
+
+            for (i = 0; i < REFS; i++)
+                sum += sym_id(symtab_find(&symtab, ref_name(prog, f, level, i)));
+        }
+
+        for (level = 0; level <= prog->depth; level++)
+            symtab_exit(&symtab);
+    }
+
+    symtab_release(&symtab);
+
+    return sum;
+}
+
+// Scope Chain
+
+/* the usual alternative: a table for each scope, searched from the
+   innermost one outwards */
+static size_t resolve_chain(const program_t *const prog)
+{
+    size_t f, level, i, sum = 0, top, nscopes = prog->depth + 2;
+    tab_t *scopes = dim(tab_t, nscopes);
+    void **sym;
+
+    for (i = 0; i < nscopes; i++)
+        tab_init(&scopes[i], sizeof(istr_t), sizeof(void *), &tab_hash_ptr, NULL, i ? LOCALS : prog->nfuncs);
+
+    for (f = 0; f < prog->nfuncs; f++)
+        *tab_set(&scopes[0], void *, &prog->funcs[f]) = sym_of(f);
+
+    for (f = 0; f < prog->nfuncs; f++)
+    {
+        for (i = 0; i < PARAMS; i++)
+            *tab_set(&scopes[1], void *, &prog->params[i]) = sym_of(FUNCS + i);
+
+        for (level = 0; level < prog->depth; level++)
+        {
+            top = level + 2;
+
+            for (i = 0; i < LOCALS; i++)
+                *tab_set(&scopes[top], void *, &prog->locals[i]) = sym_of(FUNCS + PARAMS + i + level);
+
+            for (i = 0; i < REFS; i++)
+            {
+                istr_t name = ref_name(prog, f, level, i);
+                size_t s = top;
+
+                while (!(sym = tab_get(&scopes[s], void *, &name)) && s)
+                    s--;
+
+                sum += sym_id(*sym);
+            }
+        }
+
+        for (i = 1; i < nscopes; i++)
+            tab_clear(&scopes[i]);
+    }
+
+    for (i = 0; i < nscopes; i++)
+        tab_release(&scopes[i]);
+
+    checked_free(scopes);
+
+    return sum;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t nfuncs = (argc > 1 && atol(argv[1]) > 0) ? (size_t)atol(argv[1]) : FUNCS;
+    size_t depth = (argc > 2 && atol(argv[2]) > 0) ? (size_t)atol(argv[2]) : DEPTH, i, sum[2];
+    double start, refs;
+    char name[32];
+    program_t prog;
+    strtab_t names;
+
+    strtab_init(&names, 0);
+
+    prog.funcs = dim(istr_t, nfuncs);
+    prog.nfuncs = nfuncs;
+    prog.depth = depth;
+
+    for (i = 0; i < nfuncs; i++)
+        prog.funcs[i] = strtab_intern(&names, name, (size_t)sprintf(name, "func%lu", (unsigned long)i));
+
+    for (i = 0; i < PARAMS; i++)
+        prog.params[i] = strtab_intern(&names, name, (size_t)sprintf(name, "arg%lu", (unsigned long)i));
+
+    for (i = 0; i < LOCALS; i++)
+        prog.locals[i] = strtab_intern(&names, name, (size_t)sprintf(name, "local%lu", (unsigned long)i));
+
+    refs = (double)nfuncs * (double)depth * REFS;
+
+    start = bench_now();
+    sum[0] = resolve_chain(&prog);
+    bench_report("scope chain", bench_now() - start, refs, "ref");
+
+    start = bench_now();
+    sum[1] = resolve_symtab(&prog);
+    bench_report("undo log", bench_now() - start, refs, "ref");
+
+    printf("functions: %lu, depth: %lu, %s\n", (unsigned long)nfuncs, (unsigned long)depth,
+           sum[0] == sum[1] ? "same resolution" : "DIFFERENT RESOLUTION");
+
+    checked_free(prog.funcs);
+    strtab_release(&names);
+
+    return sum[0] == sum[1] ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* =------------------------------------------------------------= */
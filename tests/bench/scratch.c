@@ -0,0 +1,114 @@
+#include "bench.h"
+
+#ifdef _WIN32
+#   include <malloc.h>
+#   define alloca _alloca
+#else
+#   include <alloca.h>
+#endif // _WIN32
+
+/* =---- Scratch Stack Pressure Test ---------------------------= */
+
+/// @brief Temporary buffer size of each recursion level.
+#define FRAME 4096
+
+/// @brief Generates "((((1+1)+1)+1)...+1)" nested depth times.
+static char *gennested(size_t depth)
+{
+    char *src = dim(char, depth * 4 + 2), *p = src;
+    size_t i;
+
+    for (i = 0; i < depth; i++)
+        *p++ = '(';
+
+    *p++ = '1';
+
+    for (i = 0; i < depth; i++)
+        *p++ = '+', *p++ = '1', *p++ = ')';
+
+    *p = '\0';
+
+    return src;
+}
+
+static long eval_scratch(const char **const p)
+{
+    scratch_mark_t mark = scratch_push();
+    char *tmp = stackdim(char, FRAME);
+    long value;
+
+    tmp[0] = **p;
+    tmp[FRAME - 1] = '\0';
+
+    if (**p == '(')
+    {
+        (*p)++;
+        value = eval_scratch(p);
+        (*p)++;
+    }
+    else
+        value = *(*p)++ - '0';
+
+    while (**p == '+')
+    {
+        (*p)++;
+        value += eval_scratch(p);
+    }
+
+    scratch_pop(mark);
+
+    return value;
+}
+
+static long eval_alloca(const char **const p)
+{
+    char *tmp = (char *)alloca(FRAME);
+    long value;
+
+    tmp[0] = **p;
+    tmp[FRAME - 1] = '\0';
+
+    if (**p == '(')
+    {
+        (*p)++;
+        value = eval_alloca(p);
+        (*p)++;
+    }
+    else
+        value = *(*p)++ - '0';
+
+    while (**p == '+')
+    {
+        (*p)++;
+        value += eval_alloca(p);
+    }
+
+    return value;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t depth = (argc > 1 && atol(argv[1]) > 0) ? (size_t)atol(argv[1]) : 20000;
+    bool_t use_alloca = (argc > 2 && !strcmp(argv[2], "alloca"));
+    char *src = gennested(depth);
+    const char *p = src;
+    double start;
+    long value;
+
+    printf("depth: %lu, %lu KiB of temporaries (%s)\n", (unsigned long)depth,
+           (unsigned long)(depth * 2 * FRAME >> 10), use_alloca ? "alloca" : "scratch");
+    fflush(stdout);
+
+    start = bench_now();
+    value = (use_alloca) ? eval_alloca(&p) : eval_scratch(&p);
+    bench_report("nested expression", bench_now() - start, (double)depth * 2, "level");
+
+    printf("value: %ld\n", value);
+
+    scratch_release();
+    checked_free(src);
+
+    return (value == (long)depth + 1) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* =------------------------------------------------------------= */
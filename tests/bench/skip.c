@@ -0,0 +1,105 @@
+#include "bench.h"
+
+#include "calc/lex/scanner.h"
+
+/* =---- Scanner Skip Loops Benchmark --------------------------= */
+
+/// @brief Default size of the sources in MiB.
+#define SIZE 64
+
+/// @brief Number of tokens of a batch.
+#define BATCH 4096
+
+/* a source made from a template with a number in it */
+static char *gensrc(const char *const template, size_t size, size_t *const length)
+{
+    char *src = dim(char, size + 512);
+    size_t len = 0;
+    unsigned long n = 0;
+
+    while (len < size)
+    {
+        len += (size_t)sprintf(src + len, template, n, n, n);
+        n++;
+    }
+
+    *length = len;
+
+    return src;
+}
+
+/* scans the whole text, returns the number of tokens and sums
+   their kinds */
+static size_t scan(const char *const text, size_t len, size_t *const kinds)
+{
+    static token_t batch[BATCH];
+    scanner_t scanner;
+    size_t count = 0, n, i;
+
+    scanner_init(&scanner, text, len);
+
+    while ((n = scanner_scan(&scanner, batch, BATCH)))
+    {
+        for (i = 0; i < n; i++)
+            *kinds += batch[i].kind;
+
+        count += n;
+    }
+
+    return count;
+}
+
+static void bench(const char *const name, char *const text, size_t len)
+{
+    static const char *const isas[] = {"scalar", "sse2", "avx2"};
+    size_t tokens[3] = {0, 0, 0}, kinds[3] = {0, 0, 0}, i;
+    char label[64];
+    double start;
+
+    for (i = 0; i < sizeof(isas) / sizeof(isas[0]); i++)
+    {
+        if (!scanner_setisa(isas[i]))
+            continue;
+
+        start = bench_now();
+        tokens[i] = scan(text, len, kinds + i);
+
+        sprintf(label, "%s: %s", name, isas[i]);
+        bench_report(label, bench_now() - start, (double)len, "byte");
+    }
+
+    printf("%s: %lu tokens (%.2f bytes each), %s\n", name, (unsigned long)tokens[0],
+           (double)len / (double)tokens[0],
+           ((!tokens[1] || (tokens[1] == tokens[0] && kinds[1] == kinds[0])) &&
+            (!tokens[2] || (tokens[2] == tokens[0] && kinds[2] == kinds[0]))) ? "same tokens" : "DIFFERENT TOKENS");
+
+    checked_free(text);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t size = bench_size(argc, argv, SIZE), len;
+    char *text;
+
+    printf("skip loops: %s\n", scanner_isa());
+
+    text = gensrc("//* Documentation of the value number %lu: it computes the scaled sum of its two\n"
+                  "    arguments, the result is checked against the bound before it is returned. *//\n"
+                  "/* The bound is checked before the recursion, so that the depth of the stack\n"
+                  "   stays small even for the largest inputs of the benchmark (%lu). */\n"
+                  "let v = %lu; // the starting value of the sequence, kept small on purpose\n\n",
+                  size, &len);
+    bench("comments", text, len);
+
+    text = gensrc("let accumulated_intermediate_value_%lu = previous_accumulated_value_%lu\n"
+                  "    * scaling_factor_of_the_iteration_%lu + offset_of_the_current_element;\n",
+                  size, &len);
+    bench("identifiers", text, len);
+
+    text = bench_gensrc(size, &len);
+    bench("mixed", text, len);
+
+    return EXIT_SUCCESS;
+}
+
+/* =------------------------------------------------------------= */
@@ -0,0 +1,133 @@
+#include "bench.h"
+
+#include "calc/lex/source.h"
+
+/* =---- Source Loading Benchmark ------------------------------= */
+
+/// @brief Default size of the source file in MiB.
+#define SIZE 256
+
+/// @brief Name of the generated file.
+#define PATH "calc-bench-source.calc"
+
+/* the anonymous memory resident in the process in KiB (Linux),
+   file pages of a mapping are shared with the page cache */
+static long rss_anon(void)
+{
+    char line[128];
+    long kib = -1;
+    FILE *file = fopen("/proc/self/status", "r");
+
+    if (!file)
+        return -1;
+
+    while (fgets(line, sizeof(line), file))
+        if (sscanf(line, "RssAnon: %ld", &kib) == 1)
+            break;
+
+    fclose(file);
+
+    return kib;
+}
+
+/* reads every byte, as the scanner would */
+static size_t scan(const char *const text, size_t len)
+{
+    size_t i, lines = 0;
+
+    for (i = 0; i < len; i++)
+        lines += text[i] == '\n';
+
+    return lines;
+}
+
+/* the usual alternative: the whole file read into the heap */
+static char *fread_file(const char *const path, size_t *const len)
+{
+    FILE *file = fopen(path, "rb");
+    char *text;
+    long size;
+
+    if (!file)
+        return NULL;
+
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    text = dim(char, (size_t)size + 1);
+    *len = fread(text, 1, (size_t)size, file);
+    text[*len] = '\0';
+
+    fclose(file);
+
+    return text;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t size = bench_size(argc, argv, SIZE), len, lines[2];
+    long base, rss[2];
+    double start, load[2], total[2];
+    source_t src;
+    char *text;
+    FILE *file;
+
+    text = bench_gensrc(size, &len);
+
+    if (!(file = fopen(PATH, "wb")) || fwrite(text, 1, len, file) != len)
+    {
+        perror(PATH);
+        return EXIT_FAILURE;
+    }
+
+    fclose(file);
+    checked_free(text);
+
+    /* the file is in the page cache for both, so the load times
+       compare the copies and not the disk */
+    base = rss_anon();
+    start = bench_now();
+
+    if (!(text = fread_file(PATH, &len)))
+    {
+        perror(PATH);
+        return EXIT_FAILURE;
+    }
+
+    load[0] = bench_now() - start;
+    lines[0] = scan(text, len);
+    total[0] = bench_now() - start;
+    rss[0] = rss_anon() - base;
+
+    checked_free(text);
+
+    base = rss_anon();
+    start = bench_now();
+
+    if (!source_open(&src, PATH))
+    {
+        perror(PATH);
+        return EXIT_FAILURE;
+    }
+
+    load[1] = bench_now() - start;
+    lines[1] = scan(src.text, src.len);
+    total[1] = bench_now() - start;
+    rss[1] = rss_anon() - base;
+
+    bench_report("fread load", load[0], (double)len, "byte");
+    bench_report("fread load and scan", total[0], (double)len, "byte");
+    bench_report(source_ismapped(&src) ? "mmap load" : "source load (read)", load[1], (double)len, "byte");
+    bench_report(source_ismapped(&src) ? "mmap load and scan" : "source load and scan (read)", total[1], (double)len, "byte");
+
+    printf("size: %lu MiB, anonymous RSS: fread %ld KiB, source %ld KiB, %s\n", (unsigned long)(len >> 20),
+           rss[0], rss[1], lines[0] == lines[1] ? "same text" : "DIFFERENT TEXT");
+
+    source_close(&src);
+    remove(PATH);
+
+    return lines[0] == lines[1] ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* =------------------------------------------------------------= */
@@ -0,0 +1,156 @@
+#include "bench.h"
+
+#include "calc/lex/source.h"
+
+/* =---- Source Locations Benchmark ----------------------------= */
+
+/// @brief Default size of the source in MiB.
+#define SIZE 64
+
+/// @brief Number of diagnostics decoded.
+#define DIAGS 100000
+
+/// @brief Token carrying its decoded location, the usual layout.
+typedef struct _fat_token
+{
+    const char *file;
+    uint32_t line;
+    uint32_t col;
+    uint32_t len;
+    uint8_t kind;
+} fat_token_t;
+
+/// @brief Token carrying a 32 bits location.
+typedef struct _slim_token
+{
+    srcloc_t loc;
+    uint32_t len;
+    uint8_t kind;
+} slim_token_t;
+
+#define isword(c) (((c) >= 'a' && (c) <= 'z') || ((c) >= 'A' && (c) <= 'Z') || (c) == '_' || ((c) >= '0' && (c) <= '9'))
+
+/* splits words and single chars, tracking lines and columns */
+static size_t lex_fat(const srcfile_t *const file, fat_token_t *const tokens)
+{
+    const char *text = file->src.text;
+    size_t i = 0, n = 0, start, len = file->src.len;
+    uint32_t line = 1, col = 1;
+
+    while (i < len)
+    {
+        if (text[i] == '\n')
+        {
+            line++;
+            col = 1;
+            i++;
+            continue;
+        }
+
+        if (text[i] == ' ')
+        {
+            col++;
+            i++;
+            continue;
+        }
+
+        for (start = i++; i < len && isword(text[start]) && isword(text[i]); i++)
+            continue;
+
+        tokens[n].file = file->src.name;
+        tokens[n].line = line;
+        tokens[n].col = col;
+        tokens[n].len = (uint32_t)(i - start);
+        tokens[n++].kind = (uint8_t)text[start];
+        col += (uint32_t)(i - start);
+    }
+
+    return n;
+}
+
+/* splits the same tokens, keeping only their locations */
+static size_t lex_slim(const srcfile_t *const file, slim_token_t *const tokens)
+{
+    const char *text = file->src.text;
+    size_t i = 0, n = 0, start, len = file->src.len;
+
+    while (i < len)
+    {
+        if (text[i] == '\n' || text[i] == ' ')
+        {
+            i++;
+            continue;
+        }
+
+        for (start = i++; i < len && isword(text[start]) && isword(text[i]); i++)
+            continue;
+
+        tokens[n].loc = srcfile_loc(file, start);
+        tokens[n].len = (uint32_t)(i - start);
+        tokens[n++].kind = (uint8_t)text[start];
+    }
+
+    return n;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t size = bench_size(argc, argv, SIZE), len, n, i, k, fat_n;
+    fat_token_t *fat;
+    slim_token_t *slim;
+    uint64_t check = 0;
+    unsigned int seed = 1;
+    srcfile_t *file;
+    srcmgr_t mgr;
+    srcpos_t pos;
+    source_t src;
+    double start;
+    char *text;
+
+    text = bench_gensrc(size, &len);
+    srcmgr_init(&mgr);
+    file = srcmgr_add(&mgr, source_string(&src, "bench.calc", text, len));
+    checked_free(text);
+
+    fat = dim(fat_token_t, len);
+    start = bench_now();
+    fat_n = lex_fat(file, fat);
+    bench_report("tokens with line and column", bench_now() - start, (double)fat_n, "token");
+
+    slim = dim(slim_token_t, len);
+    start = bench_now();
+    n = lex_slim(file, slim);
+    bench_report("tokens with 32 bits location", bench_now() - start, (double)n, "token");
+
+    printf("bytes/token: %lu with line and column, %lu with a location (%lu MiB saved)\n",
+           (unsigned long)sizeof(fat_token_t), (unsigned long)sizeof(slim_token_t),
+           (unsigned long)((n * (sizeof(fat_token_t) - sizeof(slim_token_t))) >> 20));
+
+    /* the first diagnostic builds the line table */
+    start = bench_now();
+    srcmgr_decode(&mgr, slim[n / 2].loc, &pos);
+    bench_report("line table", bench_now() - start, (double)len, "byte");
+
+    start = bench_now();
+
+    for (i = 0; i < DIAGS; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        k = (seed >> 4) % n;
+
+        srcmgr_decode(&mgr, slim[k].loc, &pos);
+        check += (pos.line != fat[k].line) + (pos.col != fat[k].col);
+    }
+
+    bench_report("decode", bench_now() - start, (double)DIAGS, "diag");
+    printf("tokens: %lu, lines: %lu, %s\n", (unsigned long)n, (unsigned long)file->nlines,
+           (!check && n == fat_n) ? "same locations" : "DIFFERENT LOCATIONS");
+
+    checked_free(slim);
+    checked_free(fat);
+    srcmgr_release(&mgr);
+
+    return (!check && n == fat_n) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* =------------------------------------------------------------= */
@@ -0,0 +1,131 @@
+#include "bench.h"
+
+#include "calc/base/stdthrd.h"
+#include "calc/lex/source.h"
+#include "calc/parse/eval.h"
+
+#ifdef _WIN32
+#   include <fcntl.h>
+#else
+#   include <sys/resource.h>
+#endif // _WIN32
+
+/* =---- Streaming Input Benchmark -----------------------------= */
+
+/// @brief Default size of the stream in MiB, 10240 for the 10 GiB
+///        stream of the pipelines feeding calc.
+#define SIZE 1024
+
+/// @brief Size of the block of statements written repeatedly.
+#define BLOCK 0x10000
+
+/// @brief Producer of the stream.
+typedef struct _producer
+{
+    int fd;
+    const char *block;
+    size_t len;
+    uint64_t size;
+} producer_t;
+
+static void *produce(void *arg)
+{
+    producer_t *const producer = (producer_t *)arg;
+    uint64_t sent;
+    ssize_t n;
+    size_t off;
+
+    for (sent = 0; sent < producer->size; sent += producer->len)
+        for (off = 0; off < producer->len; off += (size_t)n)
+            if ((n = write(producer->fd, producer->block + off, (unsigned int)(producer->len - off))) <= 0)
+                return NULL;
+
+    close(producer->fd);
+
+    return NULL;
+}
+
+/* the peak resident memory of the process in KiB */
+static long peak_rss(void)
+{
+#ifdef _WIN32
+    return -1;
+#else
+    struct rusage usage;
+
+    getrusage(RUSAGE_SELF, &usage);
+
+    return usage.ru_maxrss;
+#endif // _WIN32
+}
+
+int main(int argc, char *argv[])
+{
+    static const char *const templates[] =
+    {
+        "%lu + %lu * (%lu - 7);\n",
+        "(0x%lX + 0b101) / %lu; // hex and binary\n",
+        "/* a block comment; */ %lu.25e1 * 2 - %lu;\n",
+        "((%lu %% 97) + (%lu * 3)) - 0c17;\n"
+    };
+
+    uint64_t size = (uint64_t)bench_size(argc, argv, SIZE), bytes;
+    unsigned long stmts = 0, evals = 0, per_block = 0, n;
+    char *block = dim(char, BLOCK + 256);
+    size_t len = 0;
+    eval_value_t value;
+    producer_t producer;
+    srcstream_t stream;
+    thread_t thread;
+    strv_t stmt;
+    double start;
+    int fds[2];
+
+    for (n = 1; len < BLOCK; n++, per_block++)
+        len += (size_t)sprintf(block + len, templates[n % 4], n, n * 3 + 1, n % 1000 + 1);
+
+#ifdef _WIN32
+    if (_pipe(fds, 0x10000, _O_BINARY) < 0)
+#else
+    if (pipe(fds) < 0)
+#endif // _WIN32
+    {
+        perror("pipe");
+        return EXIT_FAILURE;
+    }
+
+    producer.fd = fds[1];
+    producer.block = block;
+    producer.len = len;
+    producer.size = size;
+
+    start = bench_now();
+    thread_start(&thread, &produce, &producer);
+
+    srcstream_init(&stream, fds[0], 0, NULL);
+
+    while (srcstream_next(&stream, &stmt))
+    {
+        stmts++;
+        evals += eval_expr(stmt, &value) == EVAL_OK;
+    }
+
+    thread_join(&thread);
+
+    bytes = ((size + len - 1) / len) * len;
+
+    bench_report("stream and evaluate", bench_now() - start, (double)bytes, "byte");
+    bench_report("stream and evaluate", bench_now() - start, (double)stmts, "stmt");
+
+    printf("stream: %lu MiB, statements: %lu (%lu evaluated), buffer: %lu KiB, peak RSS: %ld KiB, %s\n",
+           (unsigned long)(bytes >> 20), stmts, evals, (unsigned long)(stream.reader.cap >> 10), peak_rss(),
+           stmts == per_block * (unsigned long)(bytes / len) ? "all statements" : "MISSING STATEMENTS");
+
+    srcstream_release(&stream);
+    close(fds[0]);
+    checked_free(block);
+
+    return EXIT_SUCCESS;
+}
+
+/* =------------------------------------------------------------= */
@@ -0,0 +1,115 @@
+#include "bench.h"
+
+#include "calc/base/stdstr.h"
+
+#include <ctype.h>
+
+/* =---- String Operations Benchmark ---------------------------= */
+
+/// @brief Bytes processed by each case.
+#define VOLUME 0x10000000
+
+/* the byte at a time versions replaced by stdstr, kept as the
+   reference (striq compares from the last char, as it did) */
+
+static void old_strnlow(char *const dst, const char *const src, size_t count)
+{
+    do
+        dst[count - 1] = tolower(src[count - 1]);
+    while (--count > 0);
+}
+
+static bool_t old_streq(const char *const str1, const char *const str2, size_t len)
+{
+    for (; len > 0; len--)
+        if (str1[len - 1] != str2[len - 1])
+            return FALSE;
+
+    return TRUE;
+}
+
+static bool_t old_striq(const char *const str1, const char *const str2, size_t len)
+{
+    for (; len > 0; len--)
+        if (tolower(str1[len - 1]) != tolower(str2[len - 1]))
+            return FALSE;
+
+    return TRUE;
+}
+
+static const char *old_strchr(const char *const str, int ch, size_t len)
+{
+    size_t i;
+
+    for (i = 0; i < len; i++)
+        if (str[i] == ch)
+            return str + i;
+
+    return NULL;
+}
+
+/* keeps the compiler from dropping the measured calls */
+static volatile size_t sink;
+
+static void bench(size_t len, const char *const a, const char *const b, const char *const c, char *const dst)
+{
+    size_t i, n = VOLUME / len, hits = 0;
+    char name[32];
+    double start;
+
+#define CASE(label, expr)                                           \
+    sprintf(name, "%s/%lu", (label), (unsigned long)len);           \
+    start = bench_now();                                            \
+    for (i = 0; i < n; i++)                                         \
+        hits += (size_t)(expr);                                     \
+    bench_report(name, bench_now() - start, (double)n * (double)len, "B")
+
+    CASE("old lower", (old_strnlow(dst, a, len), dst[i % len]));
+    CASE("strnlow", strnlow(dst, a, len)[i % len]);
+    CASE("old eq", old_streq(a, c, len));
+    CASE("strneq", strneq(a, c, len));
+    CASE("old iq", old_striq(a, b, len));
+    CASE("strniq", strniq(a, b, len));
+    CASE("old chr", old_strchr(a, '$', len) != NULL);
+    CASE("strnchr", strnchr(a, '$', len) != NULL);
+
+#undef CASE
+
+    sink += hits;
+}
+
+int main(void)
+{
+    static const size_t sizes[] = {8, 64, 4096};
+    char *a, *b, *c, *dst;
+    size_t i, len = 4096;
+
+    a = dim(char, len + 1);
+    b = dim(char, len + 1);
+    c = dim(char, len + 1);
+    dst = dim(char, len + 1);
+
+    /* a and c are equal, a and b are equal ignoring the case,
+       the searched char is missing */
+    for (i = 0; i < len; i++)
+    {
+        a[i] = (char)('A' + i % 26);
+        b[i] = (char)('a' + i % 26);
+    }
+
+    memcpy(c, a, len);
+
+    printf("string operations: %s\n", strisa());
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+        bench(sizes[i], a, b, c, dst);
+
+    checked_free(dst);
+    checked_free(c);
+    checked_free(b);
+    checked_free(a);
+
+    return EXIT_SUCCESS;
+}
+
+/* =------------------------------------------------------------= */
@@ -0,0 +1,167 @@
+#include "bench.h"
+
+#include "calc/base/stdtab.h"
+
+/* =---- Hash Table Benchmark ----------------------------------= */
+
+/// @brief Default number of keys.
+#define KEYS 1000000
+
+/// @brief Node of the chained table.
+typedef struct _chain_node
+{
+    struct _chain_node *next;
+    uint64_t key;
+    uint64_t value;
+} chain_node_t;
+
+/// @brief Chained hash table, the usual alternative: an array of
+///        lists of nodes, taken from a pool.
+typedef struct _chain
+{
+    chain_node_t **buckets;
+    size_t mask;
+    size_t count;
+    pool_t nodes;
+} chain_t;
+
+static void chain_init(chain_t *const chain)
+{
+    chain->buckets = dimz(chain_node_t *, 16);
+    chain->mask = 15;
+    chain->count = 0;
+
+    pool_init(&chain->nodes, sizeof(chain_node_t));
+}
+
+static void chain_grow(chain_t *const chain)
+{
+    chain_node_t **old = chain->buckets, *node, *next;
+    size_t i, size = chain->mask + 1;
+
+    chain->buckets = dimz(chain_node_t *, size * 2);
+    chain->mask = size * 2 - 1;
+
+    for (i = 0; i < size; i++)
+    {
+        for (node = old[i]; node; node = next)
+        {
+            next = node->next;
+            node->next = chain->buckets[strhash((const char *)&node->key, 8) & chain->mask];
+            chain->buckets[strhash((const char *)&node->key, 8) & chain->mask] = node;
+        }
+    }
+
+    checked_free(old);
+}
+
+static uint64_t *chain_put(chain_t *const chain, uint64_t key)
+{
+    chain_node_t **bucket = &chain->buckets[strhash((const char *)&key, 8) & chain->mask], *node;
+
+    for (node = *bucket; node; node = node->next)
+        if (node->key == key)
+            return &node->value;
+
+    node = (chain_node_t *)pool_malloc(&chain->nodes);
+    node->key = key;
+    node->value = 0;
+    node->next = *bucket;
+    *bucket = node;
+
+    if (++chain->count > chain->mask + 1)
+        chain_grow(chain);
+
+    return &node->value;
+}
+
+static uint64_t *chain_find(const chain_t *const chain, uint64_t key)
+{
+    chain_node_t *node = chain->buckets[strhash((const char *)&key, 8) & chain->mask];
+
+    for (; node; node = node->next)
+        if (node->key == key)
+            return &node->value;
+
+    return NULL;
+}
+
+static void chain_release(chain_t *const chain)
+{
+    checked_free(chain->buckets);
+    pool_release(&chain->nodes);
+}
+
+/* odd multipliers give distinct keys, hits and misses */
+#define key_hit(i) ((uint64_t)(i) * UINT64_C(0x9E3779B97F4A7C15))
+#define key_miss(i) ((uint64_t)(i) * UINT64_C(0x9E3779B97F4A7C15) + 1)
+
+int main(int argc, char *argv[])
+{
+    size_t n = (argc > 1 && atol(argv[1]) > 0) ? (size_t)atol(argv[1]) : KEYS, i, hits = 0;
+    uint64_t key;
+    tab_stats_t stats;
+    chain_t chain;
+    tab_t tab;
+    double start;
+
+    chain_init(&chain);
+    start = bench_now();
+
+    for (i = 0; i < n; i++)
+        *chain_put(&chain, key_hit(i)) = i;
+
+    bench_report("chained insert", bench_now() - start, (double)n, "key");
+    start = bench_now();
+
+    for (i = 0; i < n; i++)
+        hits += chain_find(&chain, key_hit(i)) != NULL;
+
+    bench_report("chained lookup hit", bench_now() - start, (double)n, "key");
+    start = bench_now();
+
+    for (i = 0; i < n; i++)
+        hits += chain_find(&chain, key_miss(i)) != NULL;
+
+    bench_report("chained lookup miss", bench_now() - start, (double)n, "key");
+    chain_release(&chain);
+
+    tab_init(&tab, sizeof(uint64_t), sizeof(uint64_t), NULL, NULL, 0);
+    start = bench_now();
+
+    for (i = 0; i < n; i++)
+    {
+        key = key_hit(i);
+        *tab_set(&tab, uint64_t, &key) = i;
+    }
+
+    bench_report("stdtab insert", bench_now() - start, (double)n, "key");
+    start = bench_now();
+
+    for (i = 0; i < n; i++)
+    {
+        key = key_hit(i);
+        hits += tab_find(&tab, &key) != NULL;
+    }
+
+    bench_report("stdtab lookup hit", bench_now() - start, (double)n, "key");
+    start = bench_now();
+
+    for (i = 0; i < n; i++)
+    {
+        key = key_miss(i);
+        hits += tab_find(&tab, &key) != NULL;
+    }
+
+    bench_report("stdtab lookup miss", bench_now() - start, (double)n, "key");
+
+    tab_stats(&tab, &stats);
+    printf("hits: %lu, load: %.2f, probe: %.2f avg, %lu max\n", (unsigned long)hits,
+           stats.load, stats.probe_avg, (unsigned long)stats.probe_max);
+
+    tab_release(&tab);
+
+    return EXIT_SUCCESS;
+}
+
+/* =------------------------------------------------------------= */
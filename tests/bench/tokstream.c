@@ -0,0 +1,316 @@
+#ifndef WALK
+
+#include "bench.h"
+
+#include "calc/lex/lexer.h"
+
+/* =---- Token Stream Benchmark --------------------------------= */
+
+/// @brief Default size of the source in MiB.
+#define SIZE 100
+
+/// @brief Number of walks over each layout.
+#define PASSES 3
+
+/// @brief Number of tokens of a batch.
+#define BATCH 256
+
+static bool_t isbinary(tok_kind_t kind)
+{
+    switch (kind)
+    {
+    case TOK_PLUS: case TOK_MINUS: case TOK_STAR: case TOK_SLASH: case TOK_PERCENT:
+    case TOK_LT: case TOK_LE: case TOK_GT: case TOK_GE: case TOK_EQ: case TOK_NE:
+    case TOK_AMP: case TOK_PIPE: case TOK_CARET: case TOK_SHL: case TOK_SHR:
+    case TOK_AMPAMP: case TOK_PIPEPIPE:
+        return TRUE;
+    default:
+        return FALSE;
+    }
+}
+
+/// @brief Walk over an array of token_t.
+typedef struct _aos
+{
+    const token_t *tokens;
+    size_t pos;
+    size_t nodes;
+    size_t spans;
+} aos_t;
+
+/// @brief Walk over a token stream.
+typedef struct _soa
+{
+    const byte_t *kinds;
+    const uint32_t *offsets;
+    const uint32_t *lens;
+    size_t pos;
+    size_t nodes;
+    size_t spans;
+} soa_t;
+
+/* the walk is written once below, this file is included again for
+   each layout */
+
+#define WALK(name) aos_##name
+#define CURSOR aos_t
+#define KIND(c, i) ((c)->tokens[i].kind)
+#define SPAN(c, i) ((c)->tokens[i].offset ^ (c)->tokens[i].len)
+#include "tokstream.c"
+
+#define WALK(name) soa_##name
+#define CURSOR soa_t
+#define KIND(c, i) ((tok_kind_t)(c)->kinds[i])
+#define SPAN(c, i) ((size_t)((c)->offsets[i] ^ (c)->lens[i]))
+#include "tokstream.c"
+
+/* the fat layout, one token_t for each token */
+static size_t lex_aos(const char *const text, size_t len, buf_t *const tokens)
+{
+    scanner_t scanner;
+    token_t *token;
+    size_t n;
+
+    scanner_init(&scanner, text, len);
+    buf_reserve(tokens, (len / 6 + BATCH) * sizeof(token_t));
+
+    do
+    {
+        buf_reserve(tokens, tokens->len + BATCH * sizeof(token_t));
+
+        n = scanner_scan(&scanner, (token_t *)(tokens->data + tokens->len), BATCH);
+        tokens->len += n * sizeof(token_t);
+    }
+    while (n);
+
+    token = buf_push(tokens, token_t);
+    token->kind = TOK_EOF;
+    token->offset = len;
+    token->len = 0;
+
+    return buf_count(tokens, token_t);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t size = bench_size(argc, argv, SIZE), len, count, nodes[2] = {0, 0};
+    char *text = bench_gensrc(size, &len);
+    tokstream_t stream;
+    buf_t tokens;
+    aos_t aos;
+    soa_t soa;
+    double start;
+    int pass;
+
+    buf_init(&tokens);
+    start = bench_now();
+    count = lex_aos(text, len, &tokens);
+
+    bench_report("lex into token_t", bench_now() - start, (double)len, "byte");
+
+    tokstream_init(&stream);
+    start = bench_now();
+    lex_text(text, len, &stream);
+
+    bench_report("lex into a stream", bench_now() - start, (double)len, "byte");
+
+    start = bench_now();
+
+    for (pass = 0; pass < PASSES; pass++)
+    {
+        aos.tokens = (const token_t *)tokens.data;
+        aos.pos = aos.nodes = aos.spans = 0;
+        nodes[0] += aos_program(&aos) + (aos.spans & 1);
+    }
+
+    bench_report("parse token_t", bench_now() - start, (double)count * PASSES, "token");
+
+    start = bench_now();
+
+    for (pass = 0; pass < PASSES; pass++)
+    {
+        soa.kinds = stream.kinds;
+        soa.offsets = stream.offsets;
+        soa.lens = stream.lens;
+        soa.pos = soa.nodes = soa.spans = 0;
+        nodes[1] += soa_program(&soa) + (soa.spans & 1);
+    }
+
+    bench_report("parse a stream", bench_now() - start, (double)count * PASSES, "token");
+
+    printf("size: %lu MiB, tokens: %lu, token_t: %lu bytes each (%.1f MiB), stream: %lu bytes each (%.1f MiB), %s\n",
+           (unsigned long)(len >> 20), (unsigned long)count,
+           (unsigned long)sizeof(token_t), (double)(count * sizeof(token_t)) / (1 << 20),
+           (unsigned long)(sizeof(byte_t) + 2 * sizeof(uint32_t)),
+           (double)(count * (sizeof(byte_t) + 2 * sizeof(uint32_t))) / (1 << 20),
+           (stream.count == count && nodes[0] == nodes[1]) ? "same nodes" : "DIFFERENT NODES");
+
+    tokstream_release(&stream);
+    buf_release(&tokens);
+    checked_free(text);
+
+    return EXIT_SUCCESS;
+}
+
+/* =------------------------------------------------------------= */
+
+#else // WALK
+
+/* a recursive descent over the statements and the expressions of
+   the generated sources, as the parser does it: it looks at the
+   kinds and takes the span of the names and of the literals */
+
+static void WALK(stmt)(CURSOR *const c);
+static void WALK(expr)(CURSOR *const c);
+
+static bool_t WALK(accept)(CURSOR *const c, tok_kind_t kind)
+{
+    if (KIND(c, c->pos) != kind)
+        return FALSE;
+
+    c->pos++;
+
+    return TRUE;
+}
+
+/* a name or a literal */
+static void WALK(leaf)(CURSOR *const c)
+{
+    if (KIND(c, c->pos) == TOK_EOF)
+        return;
+
+    c->spans += SPAN(c, c->pos);
+    c->nodes++;
+    c->pos++;
+}
+
+static void WALK(primary)(CURSOR *const c)
+{
+    tok_kind_t kind = KIND(c, c->pos);
+
+    if (kind == TOK_MINUS || kind == TOK_NOT || kind == TOK_TILDE)
+    {
+        c->pos++;
+        WALK(primary)(c);
+        c->nodes++;
+    }
+    else if (WALK(accept)(c, TOK_LPAREN))
+    {
+        WALK(expr)(c);
+        WALK(accept)(c, TOK_RPAREN);
+    }
+    else
+    {
+        WALK(leaf)(c);
+
+        /* a call */
+        if (kind == TOK_IDENT && WALK(accept)(c, TOK_LPAREN))
+        {
+            if (!WALK(accept)(c, TOK_RPAREN))
+            {
+                do
+                    WALK(expr)(c);
+                while (WALK(accept)(c, TOK_COMMA));
+
+                WALK(accept)(c, TOK_RPAREN);
+            }
+
+            c->nodes++;
+        }
+    }
+}
+
+static void WALK(expr)(CURSOR *const c)
+{
+    WALK(primary)(c);
+
+    while (isbinary(KIND(c, c->pos)))
+    {
+        c->pos++;
+        WALK(primary)(c);
+        c->nodes++;
+    }
+
+    if (WALK(accept)(c, TOK_QUESTION))
+    {
+        WALK(expr)(c);
+        WALK(accept)(c, TOK_COLON);
+        WALK(expr)(c);
+        c->nodes++;
+    }
+}
+
+static void WALK(block)(CURSOR *const c)
+{
+    while (KIND(c, c->pos) != TOK_RBRACE && KIND(c, c->pos) != TOK_EOF)
+        WALK(stmt)(c);
+
+    WALK(accept)(c, TOK_RBRACE);
+}
+
+static void WALK(stmt)(CURSOR *const c)
+{
+    size_t pos = c->pos;
+
+    if (WALK(accept)(c, TOK_KW_LET))
+    {
+        WALK(leaf)(c);
+
+        /* a function, its parameters and its type */
+        if (WALK(accept)(c, TOK_LPAREN))
+        {
+            while (!WALK(accept)(c, TOK_RPAREN) && KIND(c, c->pos) != TOK_EOF)
+            {
+                WALK(leaf)(c);
+                WALK(accept)(c, TOK_COMMA);
+            }
+
+            if (WALK(accept)(c, TOK_COLON))
+                do
+                    WALK(leaf)(c);
+                while (WALK(accept)(c, TOK_ARROW));
+        }
+
+        if (WALK(accept)(c, TOK_LBRACE))
+            WALK(block)(c);
+        else
+        {
+            WALK(accept)(c, TOK_ASSIGN);
+            WALK(expr)(c);
+            WALK(accept)(c, TOK_SEMI);
+        }
+    }
+    else if (WALK(accept)(c, TOK_KW_RETURN))
+    {
+        WALK(expr)(c);
+        WALK(accept)(c, TOK_SEMI);
+    }
+    else if (WALK(accept)(c, TOK_LBRACE))
+        WALK(block)(c);
+    else
+    {
+        WALK(expr)(c);
+        WALK(accept)(c, TOK_SEMI);
+    }
+
+    /* an unexpected token is skipped */
+    if (c->pos == pos)
+        c->pos++;
+
+    c->nodes++;
+}
+
+static size_t WALK(program)(CURSOR *const c)
+{
+    while (KIND(c, c->pos) != TOK_EOF)
+        WALK(stmt)(c);
+
+    return c->nodes;
+}
+
+#undef WALK
+#undef CURSOR
+#undef KIND
+#undef SPAN
+
+#endif // WALK
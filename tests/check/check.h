@@ -0,0 +1,190 @@
+#pragma once
+
+/* check.h - Copyright (c) 2024 Frithurik Grint */
+
+#ifndef CALC_TESTS_CHECK_H_
+#define CALC_TESTS_CHECK_H_
+
+#include "calc/base/stdmem.h"
+#include "calc/lex/lexer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* =---- Check Helpers -----------------------------------------= */
+
+/// @brief State of the random numbers, the same at each run so that a
+///        failure can be reproduced.
+static uint64_t check_state = UINT64_C(0x9E3779B97F4A7C15);
+
+/// @brief Gets a pseudo random number (xorshift).
+/// @return The number.
+static inline uint64_t check_rand(void)
+{
+    check_state ^= check_state << 13;
+    check_state ^= check_state >> 7;
+    check_state ^= check_state << 17;
+
+    return check_state;
+}
+
+/// @brief Gets a pseudo random number below a bound.
+/// @param bound Bound of the number, not zero.
+/// @return The number.
+static inline size_t check_below(size_t bound)
+{
+    return (size_t)(check_rand() % bound);
+}
+
+/// @brief Writes a random char of the body of a comment or a string:
+///        the stars, slashes, quotes and backslashes can close or
+///        escape it, the non-ASCII bytes and the blanks break the
+///        vector loops.
+/// @param dst Output of the char.
+static inline void check_char(char *const dst)
+{
+    static const char palette[] = "abcxyz019 _*/\"'\\\n\t\x7F\xC3\xA9\xE2\x82\xAC\xFF";
+
+    *dst = palette[check_below(sizeof(palette) - 1)];
+}
+
+/// @brief Writes a random piece of a source: a token, a run of blanks,
+///        a comment, a literal or some random bytes. The runs are
+///        long enough for the vector loops of the scanner.
+/// @param dst Output of the piece, at least 256 chars.
+/// @return Length of the piece.
+static inline size_t check_piece(char *const dst)
+{
+    static const char *const fixed[] =
+    {
+        "let", "return", "if", "while", "sizeof", "0x1F", "0b101", "0c17", "0d99", "00x10", "0x", "0b2",
+        "12ab", "1.5", "1.5e3", "2.e", "1e10", "+", "++", "-", "->", "::", "<<=", ">>", "=>", "/", "*",
+        "/=", "(", ")", "{", "}", ";", ",", ".", "'a'", "'\\n'", "'", "\xC3\xA9t\xC3\xA9", "\xE2\x82\xAC"
+    };
+    static const char ident[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_$0123456789";
+    size_t len = 0, n, i;
+
+    switch (check_below(8))
+    {
+        case 0:
+            len = strlen(fixed[i = check_below(sizeof(fixed) / sizeof(fixed[0]))]);
+            memcpy(dst, fixed[i], len);
+            break;
+
+        case 1:
+            for (n = 1 + check_below(80), dst[len++] = ident[check_below(53)]; len < n; len++)
+                dst[len] = ident[check_below(sizeof(ident) - 1)];
+            break;
+
+        case 2:
+            for (n = 1 + check_below(70); len < n; len++)
+                dst[len] = " \t\r\n"[check_below(4)];
+            break;
+
+        case 3:
+            len = (size_t)sprintf(dst, "// ");
+
+            for (n = len + check_below(100); len < n; len++)
+                if ((check_char(dst + len), dst[len] == '\n'))
+                    break;
+
+            dst[len++] = '\n';
+            break;
+
+        case 4:
+            n = check_below(3);
+            len = (size_t)sprintf(dst, n ? "/*" : "//*");
+
+            for (i = len + check_below(200); len < i; len++)
+            {
+                check_char(dst + len);
+
+                if (dst[len] == '/' && dst[len - 1] == '*')
+                    dst[len] = '*';
+            }
+
+            len += (size_t)sprintf(dst + len, n ? "*/" : "*//");
+            break;
+
+        case 5:
+            dst[len++] = '"';
+
+            for (n = 1 + check_below(120); len < n; len++)
+                if ((check_char(dst + len), dst[len] == '"' && dst[len - 1] != '\\'))
+                    dst[len] = '\'';
+
+            if (dst[len - 1] == '\\')
+                dst[len++] = '\\';
+
+            dst[len++] = '"';
+            break;
+
+        case 6:
+            for (n = 1 + check_below(8); len < n; len++)
+                dst[len] = (char)(1 + check_below(255));
+            break;
+
+        default:
+            dst[len++] = ' ';
+            break;
+    }
+
+    return len;
+}
+
+/// @brief Generates a random source (see check_piece).
+/// @param size Minimum size of the source in bytes.
+/// @param length Output of the source length.
+/// @return The generated source, NUL terminated.
+static inline char *check_gensrc(size_t size, size_t *const length)
+{
+    char *src = dim(char, size + 512);
+    size_t len = 0;
+
+    while (len < size)
+        len += check_piece(src + len);
+
+    *length = len;
+
+    return src;
+}
+
+/// @brief Compares two streams of tokens, printing the first
+///        different token.
+/// @param name Name of the case.
+/// @param expected Expected tokens.
+/// @param tokens Tokens to check.
+/// @return TRUE if the streams have the same tokens.
+static inline bool_t check_same(const char *const name, const tokstream_t *const expected, const tokstream_t *const tokens)
+{
+    size_t count = expected->count < tokens->count ? expected->count : tokens->count, i;
+    token_t a, b;
+
+    for (i = 0; i < count; i++)
+    {
+        tokstream_get(expected, i, &a);
+        tokstream_get(tokens, i, &b);
+
+        if (a.kind != b.kind || a.offset != b.offset || a.len != b.len)
+        {
+            printf("%s: token %lu is %s at %lu (%lu chars), expected %s at %lu (%lu chars)\n", name, (unsigned long)i,
+                   tok_text(b.kind), (unsigned long)b.offset, (unsigned long)b.len, tok_text(a.kind),
+                   (unsigned long)a.offset, (unsigned long)a.len);
+
+            return FALSE;
+        }
+    }
+
+    if (expected->count != tokens->count)
+    {
+        printf("%s: %lu tokens, expected %lu\n", name, (unsigned long)tokens->count, (unsigned long)expected->count);
+
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/* =------------------------------------------------------------= */
+
+#endif // CALC_TESTS_CHECK_H_
@@ -0,0 +1,93 @@
+#include "check.h"
+
+#include "calc/lex/scanner.h"
+
+/* =---- Scanner Skip Loops Check ------------------------------= */
+
+/// @brief Number of small sources.
+#define SOURCES 3000
+
+/// @brief Most size of a small source.
+#define SIZE 0x1000
+
+/// @brief Size of the large source.
+#define LARGE (4 << 20)
+
+static const char *const isas[] = {"scalar", "sse2", "avx2"};
+
+static bool_t checked[3] = {TRUE, FALSE, FALSE};
+
+/* lexes the text with each instruction set and compares the tokens
+   with the ones of the scalar loops */
+static bool_t check(const char *const text, size_t len)
+{
+    tokstream_t expected, tokens;
+    bool_t same = TRUE;
+    char name[64];
+    size_t i;
+
+    scanner_setisa(isas[0]);
+    tokstream_init(&expected);
+    lex_text(text, len, &expected);
+
+    for (i = 1; same && i < sizeof(isas) / sizeof(isas[0]); i++)
+    {
+        if (!scanner_setisa(isas[i]))
+            continue;
+
+        checked[i] = TRUE;
+
+        tokstream_init(&tokens);
+        lex_text(text, len, &tokens);
+
+        sprintf(name, "%s, %lu chars", isas[i], (unsigned long)len);
+        same = check_same(name, &expected, &tokens);
+
+        tokstream_release(&tokens);
+    }
+
+    tokstream_release(&expected);
+
+    return same;
+}
+
+int main()
+{
+    char *text, *copy = dim(char, SIZE + 1024);
+    bool_t same = TRUE;
+    size_t len, n, i;
+
+    /* small sources at each alignment, cut at random places so that
+       the text ends in the middle of the runs */
+    for (n = 0; same && n < SOURCES; n++)
+    {
+        text = check_gensrc(check_below(SIZE), &len);
+        len = check_below(len + 1);
+
+        memcpy(copy + n % 64, text, len);
+        same = check(copy + n % 64, len);
+
+        checked_free(text);
+    }
+
+    if (same)
+    {
+        text = check_gensrc(LARGE, &len);
+        same = check(text, len);
+        n++;
+
+        checked_free(text);
+    }
+
+    for (i = 1; i < sizeof(isas) / sizeof(isas[0]); i++)
+        if (!checked[i])
+            printf("%s: not supported, not checked\n", isas[i]);
+
+    printf("%lu sources: %s\n", (unsigned long)n, same ? "same tokens" : "DIFFERENT TOKENS");
+
+    checked_free(copy);
+
+    return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* =------------------------------------------------------------= */
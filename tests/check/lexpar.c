@@ -0,0 +1,116 @@
+#include "check.h"
+
+/* =---- Parallel Lexer Check ----------------------------------= */
+
+/// @brief Size of the sources in MiB, a chunk is at least 1 MiB.
+#define SIZE 6
+
+/// @brief Most distance of a span from a cut.
+#define REACH 4096
+
+static const unsigned int threads[] = {2, 3, 4, 8};
+
+/* covers the cut of a chunk (the first new line from an offset) with
+   a comment, a string or a line comment: from the start of a line
+   before it to the end of a line at least extent chars after it, or
+   to the end of the text without a closing. The new lines of the text
+   are kept, so the cuts stay in the same places. Returns the end */
+static size_t span(char *const text, size_t len, size_t offset, size_t extent)
+{
+    static const char *const opens[] = {"/*", "//*", "\"", "//"};
+    static const char *const closes[] = {"*/", "*//", "\"", ""};
+    size_t kind = check_below(4), start, end, open, close, i;
+    const char *nl;
+
+    for (start = offset - 8 - check_below(REACH); start && text[start - 1] != '\n'; start--)
+        continue;
+
+    /* a line comment ends at the new line of the cut */
+    if (kind == 3)
+        extent = 0;
+
+    if (offset + extent >= len || !(nl = (const char *)memchr(text + offset + extent, '\n', len - offset - extent)))
+        end = len, kind = 0;
+    else
+        end = (size_t)(nl - text);
+
+    open = strlen(opens[kind]);
+    close = end < len ? strlen(closes[kind]) : 0;
+
+    memcpy(text + start, opens[kind], open);
+
+    for (i = start + open; i < end - close; i++)
+    {
+        if (text[i] == '\n')
+            continue;
+
+        check_char(text + i);
+
+        if (text[i] == '\n')
+            text[i] = ' ';
+        else if (kind == 2 && (text[i] == '"' || text[i] == '\\'))
+            text[i] = '\'';
+        else if (text[i] == '/' && text[i - 1] == '*')
+            text[i] = '*';
+    }
+
+    memcpy(text + end - close, closes[kind], close);
+
+    return end;
+}
+
+int main()
+{
+    size_t len, chunk, covered, extent, count, expected, n, k, t;
+    tokstream_t reference, tokens;
+    bool_t same = TRUE;
+    char name[64];
+    char *text;
+
+    for (t = 0; same && t < sizeof(threads) / sizeof(threads[0]); t++)
+    {
+        text = check_gensrc((size_t)SIZE << 20, &len);
+
+        n = len >> 20 < threads[t] ? len >> 20 : threads[t];
+        chunk = len / n;
+
+        /* the spans reach past the next cuts at times, the last one
+           of the last source is not closed */
+        for (covered = 0, k = 1; k < n; k++)
+        {
+            if (k * chunk < covered)
+                continue;
+
+            extent = check_below(4) ? check_below(REACH) : check_below(chunk * 2);
+
+            if (t + 1 == sizeof(threads) / sizeof(threads[0]) && k + 1 == n)
+                extent = len;
+
+            covered = span(text, len, k * chunk, extent);
+        }
+
+        tokstream_init(&reference);
+        tokstream_init(&tokens);
+
+        expected = lex_text(text, len, &reference);
+        count = lex_text_parallel(text, len, &tokens, threads[t]);
+
+        sprintf(name, "%u threads, %lu MiB", threads[t], (unsigned long)(len >> 20));
+
+        if ((same = check_same(name, &reference, &tokens)) && count != expected)
+        {
+            printf("%s: %lu tokens appended, expected %lu\n", name, (unsigned long)count, (unsigned long)expected);
+            same = FALSE;
+        }
+
+        tokstream_release(&tokens);
+        tokstream_release(&reference);
+        checked_free(text);
+    }
+
+    printf("%lu sources: %s\n", (unsigned long)t, same ? "same tokens" : "DIFFERENT TOKENS");
+
+    return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* =------------------------------------------------------------= */
@@ -0,0 +1,96 @@
+#include "check.h"
+
+/* =---- Incremental Lexer Check -------------------------------= */
+
+/// @brief Size of the source.
+#define SIZE 0x10000
+
+/// @brief Number of edits.
+#define EDITS 4000
+
+/// @brief Most chars removed by an edit.
+#define REMOVED 64
+
+static char *text;
+static size_t len;
+static tokstream_t tokens;
+
+/* edits the text and its tokens, then compares them with the tokens
+   of the whole new text */
+static bool_t edit(size_t offset, size_t removed, const char *const insert, size_t inserted)
+{
+    tokstream_t expected;
+    lexedit_t changed;
+    char name[64];
+    bool_t same;
+
+    memmove(text + offset + inserted, text + offset + removed, len - offset - removed);
+    memcpy(text + offset, insert, inserted);
+    len = len - removed + inserted;
+
+    lex_edit(&tokens, text, len, offset, removed, inserted, &changed);
+
+    tokstream_init(&expected);
+    lex_text(text, len, &expected);
+
+    sprintf(name, "edit at %lu (-%lu +%lu)", (unsigned long)offset, (unsigned long)removed, (unsigned long)inserted);
+    same = check_same(name, &expected, &tokens);
+
+    tokstream_release(&expected);
+
+    return same;
+}
+
+int main()
+{
+    char piece[512];
+    size_t offset, removed, i;
+    bool_t same = TRUE;
+
+    text = check_gensrc(SIZE, &len);
+    text = (char *)checked_realloc(text, len + EDITS * 256 + 1);
+
+    tokstream_init(&tokens);
+    lex_text(text, len, &tokens);
+
+    /* pieces inserted, chars removed or replaced, at random places
+       and at the ends of the text */
+    for (i = 0; same && i < EDITS; i++)
+    {
+        switch (check_below(4))
+        {
+            case 0:
+                offset = check_below(8) ? check_below(len + 1) : (check_rand() & 1) * len;
+                same = edit(offset, 0, piece, check_piece(piece));
+                break;
+
+            case 1:
+                offset = check_below(len + 1);
+                removed = check_below(REMOVED);
+                same = edit(offset, removed < len - offset ? removed : len - offset, piece, 0);
+                break;
+
+            case 2:
+                offset = check_below(len + 1);
+                removed = check_below(REMOVED);
+                same = edit(offset, removed < len - offset ? removed : len - offset, piece, check_piece(piece));
+                break;
+
+            default:
+                /* typing, a char at a time */
+                check_char(piece);
+                same = edit(check_below(len + 1), 0, piece, 1);
+                break;
+        }
+    }
+
+    printf("%lu edits, %lu tokens: %s\n", (unsigned long)i, (unsigned long)tokens.count,
+           same ? "same tokens" : "DIFFERENT TOKENS");
+
+    tokstream_release(&tokens);
+    checked_free(text);
+
+    return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* =------------------------------------------------------------= */
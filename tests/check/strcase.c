@@ -0,0 +1,105 @@
+#include "check.h"
+
+#include "calc/base/stdstr.h"
+
+/* =---- Case Conversion Check ---------------------------------= */
+
+/// @brief Largest length of a string.
+#define LARGE 4096
+
+/// @brief Alignments of the strings.
+#define ALIGNS 64
+
+static const char *const isas[] = {"scalar", "sse2", "avx2"};
+
+static const size_t lens[] = {0, 1, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, LARGE - 1, LARGE};
+
+/* converts a string one char at a time */
+static void convert(char *const dst, const char *const src, size_t len, bool_t upper)
+{
+    size_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        if (!upper && src[i] >= 'A' && src[i] <= 'Z')
+            dst[i] = (char)(src[i] + ('a' - 'A'));
+        else if (upper && src[i] >= 'a' && src[i] <= 'z')
+            dst[i] = (char)(src[i] - ('a' - 'A'));
+        else
+            dst[i] = src[i];
+    }
+
+    dst[len] = NUL;
+}
+
+/* checks the result of a conversion against the expected string */
+static bool_t same(const char *const name, const char *const result, const char *const expected, size_t len)
+{
+    if (!memcmp(result, expected, len + 1))
+        return TRUE;
+
+    printf("%s: %lu chars, different result\n", name, (unsigned long)len);
+
+    return FALSE;
+}
+
+/* converts a random string out of place, in place and to a new
+   buffer, in both cases */
+static bool_t check(const char *const isa, size_t len, size_t align)
+{
+    static char src[LARGE + ALIGNS + 1], dst[LARGE + ALIGNS + 1], expected[LARGE + 1];
+    char *const s = src + align, *const d = dst + (ALIGNS - 1 - align), *r;
+    char name[64];
+    bool_t ok = TRUE;
+    int upper;
+    size_t i;
+
+    for (upper = 0; ok && upper < 2; upper++)
+    {
+        for (i = 0; i < len; i++)
+            s[i] = (char)(1 + check_below(255));
+
+        s[len] = NUL;
+        convert(expected, s, len, (bool_t)upper);
+
+        sprintf(name, "%s, %s, out of place", isa, upper ? "strnupp" : "strnlow");
+        memset(d, 'x', len + 1);
+        ok = same(name, upper ? strnupp(d, s, len) : strnlow(d, s, len), expected, len);
+
+        sprintf(name, "%s, %s, allocated", isa, upper ? "strnupp" : "strnlow");
+        r = upper ? strnupp(NULL, s, len) : strnlow(NULL, s, len);
+        ok = ok && same(name, r, expected, len);
+        checked_free(r);
+
+        sprintf(name, "%s, %s, in place", isa, upper ? "strupp" : "strlow");
+        memcpy(d, s, len + 1);
+        ok = ok && same(name, upper ? strupp(d, d) : strlow(d, d), expected, len);
+
+        sprintf(name, "%s, %s, in place", isa, upper ? "strnupp" : "strnlow");
+        ok = ok && same(name, upper ? strnupp(s, s, len) : strnlow(s, s, len), expected, len);
+    }
+
+    return ok;
+}
+
+int main()
+{
+    bool_t ok = TRUE, checked;
+    size_t n = 0, i, k, align;
+
+    for (i = 0; i < sizeof(isas) / sizeof(isas[0]); i++)
+    {
+        if (!(checked = strsetisa(isas[i])))
+            printf("%s: not supported, not checked\n", isas[i]);
+
+        for (k = 0; checked && ok && k < sizeof(lens) / sizeof(lens[0]); k++)
+            for (align = 0; ok && align < ALIGNS; align++, n++)
+                ok = check(isas[i], lens[k], align);
+    }
+
+    printf("%lu conversions: %s\n", (unsigned long)n, ok ? "same strings" : "DIFFERENT STRINGS");
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* =------------------------------------------------------------= */